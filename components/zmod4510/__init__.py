@@ -1,7 +1,10 @@
+import os
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import i2c
-from esphome.const import CONF_ID, CONF_UPDATE_INTERVAL
+from esphome.components import i2c, uart, web_server_base
+from esphome.core import CORE, ID
+from esphome.const import CONF_ID, CONF_UPDATE_INTERVAL, ENTITY_CATEGORY_DIAGNOSTIC, STATE_CLASS_TOTAL_INCREASING, STATE_CLASS_MEASUREMENT, UNIT_CELSIUS, UNIT_OHM, DEVICE_CLASS_TEMPERATURE
 
 # Optionally, define your own unit constant.
 UNIT_PPB = "ppb"
@@ -11,37 +14,336 @@ AUTO_LOAD = ["sensor"]
 
 zmod4510_ns = cg.global_ns.namespace("zmod4510")
 ZMOD4510 = zmod4510_ns.class_("ZMOD4510", i2c.I2CDevice, cg.Component)
+BusScheduler = zmod4510_ns.class_("BusScheduler")
 
 CONF_NO2 = "no2"
 CONF_O3 = "o3"
 CONF_AQI = "aqi"
 CONF_ADDRESS = "address"
+CONF_EPA_AQI = "epa_aqi"
+CONF_RMOX = ["rmox_0", "rmox_1", "rmox_2", "rmox_3"]
+CONF_COMPENSATION_TEMPERATURE = "compensation_temperature"
+CONF_O3_1H = "o3_1h"
+CONF_O3_8H = "o3_8h"
+CONF_NO2_1H = "no2_1h"
+CONF_I2C_STATS = "i2c_stats"
+CONF_I2C_TRANSACTIONS = "i2c_transactions"
+CONF_I2C_ERRORS = "i2c_errors"
+CONF_I2C_BUS_TIME = "i2c_bus_time"
+CONF_PIPELINE_TRACE = "pipeline_trace"
+CONF_I2C_TRACE = "i2c_trace"
+CONF_BUFFER_SIZE = "buffer_size"
+CONF_AMBIENT_SENSOR = "ambient_sensor"
+CONF_CLEANING = "cleaning"
+CONF_VERBOSE_ERRORS = "verbose_errors"
+CONF_TEMPERATURE_SOURCE = "temperature_source"
+CONF_HUMIDITY_SOURCE = "humidity_source"
+CONF_SOURCE_TIMEOUT = "source_timeout"
+CONF_DEADBAND = "deadband"
+CONF_MAX_INTERVAL = "max_interval"
+CONF_RATE_THRESHOLD = "rate_threshold"
+CONF_HISTORY = "history"
+CONF_RAW_DURATION = "raw_duration"
+CONF_MINUTES = "minutes"
+CONF_HOURS = "hours"
+CONF_DAYS = "days"
+CONF_COMPRESSED_HISTORY = "compressed_history"
+CONF_BLOCKS = "blocks"
+CONF_PRECISION_BITS = "precision_bits"
+CONF_JOURNAL = "journal"
+CONF_PARTITION = "partition"
+CONF_PATH = "path"
+CONF_SIZE = "size"
+CONF_BATCH_SIZE = "batch_size"
+CONF_HISTORY_EXPORT = "history_export"
+CONF_WEB_SERVER_BASE_ID = "web_server_base_id"
+CONF_UART_ID = "uart_id"
+CONF_RECORDING = "recording"
+CONF_PORT = "port"
+CONF_BLOCK_ROWS = "block_rows"
+CONF_SHARED_BUS = "shared_bus"
+CONF_ASYNC_HAL = "async_hal"
+UNIT_MILLISECOND = "ms"
+
+PUBLISH_POLICY_KEYS = (CONF_DEADBAND, CONF_MAX_INTERVAL, CONF_RATE_THRESHOLD)
+
+# Diagnostic sensors backed by the I2C statistics wrapper.
+I2C_STATS_SENSORS = (CONF_I2C_TRANSACTIONS, CONF_I2C_ERRORS, CONF_I2C_BUS_TIME)
 
 # Use sensor's schema if you want to attach sensors.
 from esphome.components import sensor
 
-CONFIG_SCHEMA = cv.Schema({
+
+def output_schema(**kwargs):
+    """Sensor schema for algorithm outputs, with the optional publish policy."""
+    return sensor.sensor_schema(**kwargs).extend({
+        cv.Optional(CONF_DEADBAND): cv.positive_float,
+        cv.Optional(CONF_MAX_INTERVAL): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_RATE_THRESHOLD): cv.positive_float,
+    })
+
+
+async def new_output(var, conf):
+    sens = await sensor.new_sensor(conf)
+    if any(key in conf for key in PUBLISH_POLICY_KEYS):
+        cg.add_define("USE_ZMOD4510_PUBLISH_POLICY")
+        cg.add(var.add_publish_policy(
+            sens,
+            conf.get(CONF_DEADBAND, 0.0),
+            conf.get(CONF_MAX_INTERVAL, 0),
+            conf.get(CONF_RATE_THRESHOLD, 0.0),
+        ))
+    return sens
+
+
+def shared_bus_scheduler():
+    """The BusScheduler of all sensors with shared_bus set, created on first use."""
+    if CONF_SHARED_BUS not in CORE.data:
+        CORE.data[CONF_SHARED_BUS] = cg.new_Pvariable(
+            ID("zmod4510_bus_scheduler", is_declaration=True, type=BusScheduler),
+            cg.RawExpression("ZMOD4510_NO2_O3_SAMPLE_TIME"),
+            cg.RawExpression("esphome::millis"),
+        )
+    return CORE.data[CONF_SHARED_BUS]
+
+
+def validate_history_export(config):
+    if CONF_HISTORY_EXPORT in config and CONF_HISTORY not in config:
+        raise cv.Invalid("history_export requires history")
+    # The HTTP export streams a chunked response, which only ESPAsyncWebServer
+    # provides; on ESP-IDF the history is exported over a UART only.
+    export = config.get(CONF_HISTORY_EXPORT, {})
+    if CONF_WEB_SERVER_BASE_ID in export and not CORE.using_arduino:
+        del export[CONF_WEB_SERVER_BASE_ID]
+        if CONF_UART_ID not in export:
+            raise cv.Invalid("history_export over HTTP requires the Arduino framework; set uart_id")
+    return config
+
+
+CONFIG_SCHEMA = cv.All(cv.Schema({
     cv.GenerateID(): cv.declare_id(ZMOD4510),
     cv.Optional(CONF_UPDATE_INTERVAL, default="60s"): cv.time_period,
     cv.Optional(CONF_ADDRESS, default=0x33): cv.hex_int,
-    cv.Optional(CONF_NO2): sensor.sensor_schema(),
-    cv.Optional(CONF_O3): sensor.sensor_schema(),
-    cv.Optional(CONF_AQI): sensor.sensor_schema(),
+    cv.Optional(CONF_NO2): output_schema(),
+    cv.Optional(CONF_O3): output_schema(),
+    cv.Optional(CONF_AQI): output_schema(),
+    cv.Optional(CONF_EPA_AQI): output_schema(accuracy_decimals=0),
+    **{
+        cv.Optional(key): output_schema(
+            unit_of_measurement=UNIT_OHM,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+        )
+        for key in CONF_RMOX
+    },
+    cv.Optional(CONF_COMPENSATION_TEMPERATURE): output_schema(
+        unit_of_measurement=UNIT_CELSIUS,
+        accuracy_decimals=1,
+        device_class=DEVICE_CLASS_TEMPERATURE,
+        state_class=STATE_CLASS_MEASUREMENT,
+    ),
+    cv.Optional(CONF_O3_1H): output_schema(unit_of_measurement=UNIT_PPB, accuracy_decimals=1),
+    cv.Optional(CONF_O3_8H): output_schema(unit_of_measurement=UNIT_PPB, accuracy_decimals=1),
+    cv.Optional(CONF_NO2_1H): output_schema(unit_of_measurement=UNIT_PPB, accuracy_decimals=1),
+    cv.Optional(CONF_TEMPERATURE_SOURCE): cv.use_id(sensor.Sensor),
+    cv.Optional(CONF_HUMIDITY_SOURCE): cv.use_id(sensor.Sensor),
+    cv.Optional(CONF_SOURCE_TIMEOUT, default="60s"): cv.positive_time_period_milliseconds,
+    # Stagger the measurement cycles of all sensors with this set (e.g. behind
+    # an I2C multiplexer) so they never compete for the bus.
+    cv.Optional(CONF_SHARED_BUS, default=False): cv.boolean,
+    # Event-driven HAL and, in C++20 builds, the coroutine sequences, for
+    # lambdas and custom components; the sensor itself does not use them.
+    cv.Optional(CONF_ASYNC_HAL, default=False): cv.boolean,
+    cv.Optional(CONF_I2C_STATS, default=False): cv.boolean,
+    cv.Optional(CONF_PIPELINE_TRACE, default=False): cv.boolean,
+    # Record all driver I2C traffic from boot, for replay on a host.
+    cv.Optional(CONF_I2C_TRACE): cv.Schema({
+        cv.Optional(CONF_BUFFER_SIZE, default=4096): cv.int_range(min=256, max=262144),
+    }),
+    cv.Optional(CONF_AMBIENT_SENSOR, default=True): cv.boolean,
+    cv.Optional(CONF_CLEANING, default=False): cv.boolean,
+    cv.Optional(CONF_VERBOSE_ERRORS, default=True): cv.boolean,
+    cv.Optional(CONF_HISTORY): cv.Schema({
+        cv.Optional(CONF_RAW_DURATION, default="10min"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_MINUTES, default=60): cv.int_range(min=0, max=1440),
+        cv.Optional(CONF_HOURS, default=48): cv.int_range(min=0, max=744),
+        cv.Optional(CONF_DAYS, default=14): cv.int_range(min=0, max=366),
+    }),
+    # Gorilla-compressed full-rate records in 1 KiB blocks. precision_bits
+    # below 23 rounds every value to that many mantissa bits first, which is
+    # lossy: a relative error of up to 2^-(bits+1), about 0.05 % at 10 bits,
+    # in exchange for a higher compression ratio (zmod4510_sim -z compares
+    # the settings on a trace).
+    cv.Optional(CONF_COMPRESSED_HISTORY): cv.Schema({
+        cv.Optional(CONF_BLOCKS, default=16): cv.int_range(min=1, max=1024),
+        cv.Optional(CONF_PRECISION_BITS, default=23): cv.int_range(min=1, max=23),
+    }),
+    # Flash journal that restores the history after a reboot. ESP32 builds use
+    # the data partition `partition`; host builds use the file `path`.
+    cv.Optional(CONF_JOURNAL): cv.Schema({
+        cv.Optional(CONF_PARTITION, default="zmod4510"): cv.string,
+        cv.Optional(CONF_PATH, default="zmod4510_journal.bin"): cv.string,
+        cv.Optional(CONF_SIZE, default=65536): cv.int_range(min=8192),
+        cv.Optional(CONF_BATCH_SIZE, default=10): cv.int_range(min=1, max=36),
+    }),
+    # Streams the history over HTTP (when a web server is configured, Arduino
+    # only) and/or in response to "history ..." commands on a UART.
+    cv.Optional(CONF_HISTORY_EXPORT): cv.Schema({
+        cv.OnlyWith(CONF_WEB_SERVER_BASE_ID, "web_server_base"): cv.use_id(web_server_base.WebServerBase),
+        cv.Optional(CONF_UART_ID): cv.use_id(uart.UARTComponent),
+    }),
+    # Raw frames, inputs, results and flags of every measurement in the
+    # columnar recording format, streamed to a UART or to TCP clients. TCP uses
+    # the socket component, which the native API already pulls in.
+    cv.Optional(CONF_RECORDING): cv.All(cv.Schema({
+        cv.Optional(CONF_UART_ID): cv.use_id(uart.UARTComponent),
+        cv.Optional(CONF_PORT): cv.port,
+        cv.Optional(CONF_BLOCK_ROWS, default=16): cv.int_range(min=1, max=256),
+    }), cv.has_exactly_one_key(CONF_UART_ID, CONF_PORT)),
+    cv.Optional(CONF_I2C_TRANSACTIONS): sensor.sensor_schema(
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    cv.Optional(CONF_I2C_ERRORS): sensor.sensor_schema(
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    cv.Optional(CONF_I2C_BUS_TIME): sensor.sensor_schema(
+        unit_of_measurement=UNIT_MILLISECOND,
+        accuracy_decimals=1,
+        state_class=STATE_CLASS_MEASUREMENT,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
 }).extend(cv.COMPONENT_SCHEMA).extend(
     cv.polling_component_schema("60s").extend(i2c.i2c_device_schema(0x33))
-)
+), validate_history_export)
 
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
+    await i2c.register_i2c_device(var, config)
     cg.add(var.set_update_interval(config[CONF_UPDATE_INTERVAL]))
     cg.add(var.set_i2c_address(config[CONF_ADDRESS]))
+
+    # Optional subsystems; whatever is not selected stays out of the image.
+    # The precompiled libraries are linked from the component directory.
+    cg.add_build_flag("-L" + os.path.dirname(os.path.abspath(__file__)))
+    cg.add_build_flag("-l_no2_o3")
+    if config[CONF_AMBIENT_SENSOR]:
+        cg.add_define("USE_ZMOD4510_HSXXXX")
+    if config[CONF_CLEANING]:
+        cg.add_define("USE_ZMOD4510_CLEANING")
+        cg.add_build_flag("-l_zmod4xxx_cleaning")
+    if not config[CONF_VERBOSE_ERRORS]:
+        # Plain build flag, as the Renesas C sources do not see ESPHome's defines.
+        cg.add_build_flag("-DHAL_NO_ERROR_STRINGS")
+
     if CONF_NO2 in config:
-        no2_sensor = await sensor.new_sensor(config[CONF_NO2])
+        no2_sensor = await new_output(var, config[CONF_NO2])
         cg.add(var.set_no2_sensor(no2_sensor))
     if CONF_O3 in config:
-        o3_sensor = await sensor.new_sensor(config[CONF_O3])
+        o3_sensor = await new_output(var, config[CONF_O3])
         cg.add(var.set_o3_sensor(o3_sensor))
     if CONF_AQI in config:
-        aqi_sensor = await sensor.new_sensor(config[CONF_AQI])
+        aqi_sensor = await new_output(var, config[CONF_AQI])
         cg.add(var.set_aqi_sensor(aqi_sensor))
+    # Each output group only adds code to the firmware when it is configured.
+    if CONF_EPA_AQI in config:
+        cg.add_define("USE_ZMOD4510_EPA_AQI")
+        epa_aqi_sensor = await new_output(var, config[CONF_EPA_AQI])
+        cg.add(var.set_epa_aqi_sensor(epa_aqi_sensor))
+    if any(key in config for key in CONF_RMOX):
+        cg.add_define("USE_ZMOD4510_RMOX")
+    for index, key in enumerate(CONF_RMOX):
+        if key in config:
+            rmox_sensor = await new_output(var, config[key])
+            cg.add(var.set_rmox_sensor(index, rmox_sensor))
+    if CONF_COMPENSATION_TEMPERATURE in config:
+        cg.add_define("USE_ZMOD4510_COMPENSATION_TEMPERATURE")
+        temperature_sensor = await new_output(var, config[CONF_COMPENSATION_TEMPERATURE])
+        cg.add(var.set_compensation_temperature_sensor(temperature_sensor))
+    if any(key in config for key in (CONF_O3_1H, CONF_O3_8H, CONF_NO2_1H)):
+        cg.add_define("USE_ZMOD4510_AVERAGES")
+    if CONF_O3_1H in config:
+        o3_1h_sensor = await new_output(var, config[CONF_O3_1H])
+        cg.add(var.set_o3_1h_sensor(o3_1h_sensor))
+    if CONF_O3_8H in config:
+        o3_8h_sensor = await new_output(var, config[CONF_O3_8H])
+        cg.add(var.set_o3_8h_sensor(o3_8h_sensor))
+    if CONF_NO2_1H in config:
+        no2_1h_sensor = await new_output(var, config[CONF_NO2_1H])
+        cg.add(var.set_no2_1h_sensor(no2_1h_sensor))
+    if CONF_TEMPERATURE_SOURCE in config:
+        temperature_source = await cg.get_variable(config[CONF_TEMPERATURE_SOURCE])
+        cg.add(var.set_temperature_source(temperature_source))
+    if CONF_HUMIDITY_SOURCE in config:
+        humidity_source = await cg.get_variable(config[CONF_HUMIDITY_SOURCE])
+        cg.add(var.set_humidity_source(humidity_source))
+    cg.add(var.set_source_timeout(config[CONF_SOURCE_TIMEOUT]))
+    if config[CONF_SHARED_BUS]:
+        cg.add_define("USE_ZMOD4510_BUS_SCHEDULER")
+        cg.add(var.set_bus_scheduler(shared_bus_scheduler()))
+    if config[CONF_ASYNC_HAL]:
+        cg.add_define("USE_ZMOD4510_ASYNC_HAL")
+    if CONF_HISTORY in config:
+        history = config[CONF_HISTORY]
+        cg.add_define("USE_ZMOD4510_HISTORY")
+        cg.add(var.set_history_size(
+            history[CONF_RAW_DURATION],
+            history[CONF_MINUTES],
+            history[CONF_HOURS],
+            history[CONF_DAYS],
+        ))
+    if CONF_RECORDING in config:
+        recording = config[CONF_RECORDING]
+        cg.add_define("USE_ZMOD4510_RECORDING")
+        cg.add(var.set_recording_block_rows(recording[CONF_BLOCK_ROWS]))
+        if CONF_UART_ID in recording:
+            cg.add_define("USE_ZMOD4510_RECORDING_UART")
+            recording_uart = await cg.get_variable(recording[CONF_UART_ID])
+            cg.add(var.set_recording_uart(recording_uart))
+        if CONF_PORT in recording:
+            cg.add_define("USE_ZMOD4510_RECORDING_TCP")
+            cg.add(var.set_recording_port(recording[CONF_PORT]))
+    if CONF_HISTORY_EXPORT in config:
+        export = config[CONF_HISTORY_EXPORT]
+        cg.add_define("USE_ZMOD4510_HISTORY_EXPORT")
+        if CONF_WEB_SERVER_BASE_ID in export:
+            cg.add_define("USE_ZMOD4510_EXPORT_WEB")
+            base = await cg.get_variable(export[CONF_WEB_SERVER_BASE_ID])
+            cg.add(var.set_web_server_base(base))
+        if CONF_UART_ID in export:
+            cg.add_define("USE_ZMOD4510_EXPORT_UART")
+            export_uart = await cg.get_variable(export[CONF_UART_ID])
+            cg.add(var.set_export_uart(export_uart))
+    if any(key in config for key in (CONF_HISTORY, CONF_COMPRESSED_HISTORY, CONF_JOURNAL)):
+        cg.add_define("USE_ZMOD4510_SAMPLE_RECORDS")
+    if CONF_JOURNAL in config:
+        journal = config[CONF_JOURNAL]
+        cg.add_define("USE_ZMOD4510_JOURNAL")
+        cg.add(var.set_journal_partition(journal[CONF_PARTITION]))
+        cg.add(var.set_journal_file(journal[CONF_PATH], journal[CONF_SIZE]))
+        cg.add(var.set_journal_batch_size(journal[CONF_BATCH_SIZE]))
+    if CONF_COMPRESSED_HISTORY in config:
+        compressed = config[CONF_COMPRESSED_HISTORY]
+        cg.add_define("USE_ZMOD4510_COMPRESSED_HISTORY")
+        cg.add(var.set_compressed_history(compressed[CONF_BLOCKS], compressed[CONF_PRECISION_BITS]))
+    # Statistics are compiled in only when asked for.
+    if config[CONF_PIPELINE_TRACE]:
+        cg.add_define("USE_ZMOD4510_PIPELINE_TRACE")
+    if config[CONF_I2C_STATS] or any(key in config for key in I2C_STATS_SENSORS):
+        cg.add_define("USE_ZMOD4510_I2C_STATS")
+    if CONF_I2C_TRACE in config:
+        cg.add_define("USE_ZMOD4510_I2C_TRACE")
+        cg.add(var.set_i2c_trace_size(config[CONF_I2C_TRACE][CONF_BUFFER_SIZE]))
+    if CONF_I2C_TRANSACTIONS in config:
+        i2c_transactions_sensor = await sensor.new_sensor(config[CONF_I2C_TRANSACTIONS])
+        cg.add(var.set_i2c_transactions_sensor(i2c_transactions_sensor))
+    if CONF_I2C_ERRORS in config:
+        i2c_errors_sensor = await sensor.new_sensor(config[CONF_I2C_ERRORS])
+        cg.add(var.set_i2c_errors_sensor(i2c_errors_sensor))
+    if CONF_I2C_BUS_TIME in config:
+        i2c_bus_time_sensor = await sensor.new_sensor(config[CONF_I2C_BUS_TIME])
+        cg.add(var.set_i2c_bus_time_sensor(i2c_bus_time_sensor))
@@ -0,0 +1,177 @@
+#include "async_hal.h"
+#include "esphome/core/defines.h"
+#ifdef USE_ZMOD4510_ASYNC_HAL
+
+namespace zmod4510 {
+
+void AsyncAdapter::wrap(Interface_t *inner, AsyncInterface *wrapped, uint32_t (*clock_ms)()) {
+  this->inner_ = inner;
+  this->clock_ms_ = clock_ms;
+  wrapped->handle = this;
+  wrapped->submit_read = inner->i2cRead ? submit_read_ : nullptr;
+  wrapped->submit_write = inner->i2cWrite ? submit_write_ : nullptr;
+  wrapped->schedule = schedule_;
+  wrapped->poll = poll_;
+  wrapped->wait = inner->msSleep ? wait_ : nullptr;
+}
+
+uint8_t AsyncAdapter::get_pending() const {
+  uint8_t count = 0;
+  for (const Pending &pending : this->pending_) {
+    if (pending.sequence != 0) {
+      count++;
+    }
+  }
+  return count;
+}
+
+AsyncAdapter::Pending *AsyncAdapter::allocate_() {
+  for (Pending &pending : this->pending_) {
+    if (pending.sequence == 0) {
+      return &pending;
+    }
+  }
+  return nullptr;
+}
+
+int AsyncAdapter::queue_(int result, uint32_t due_ms, AsyncCallback done, void *context) {
+  Pending *pending = this->allocate_();
+  if (pending == nullptr) {
+    return HAL_SetError(heQueueFull, esHAL, HAL_GetErrorString);
+  }
+  if (++this->sequence_ == 0) {
+    this->sequence_ = 1;
+  }
+  *pending = Pending{done, context, result, due_ms, this->sequence_};
+  return ecSuccess;
+}
+
+int AsyncAdapter::submit_read_(void *handle, uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data,
+                               int rd_size, AsyncCallback done, void *context) {
+  auto *self = static_cast<AsyncAdapter *>(handle);
+  // Check for room first, so a rejected read does not touch the bus.
+  if (self->allocate_() == nullptr) {
+    return HAL_SetError(heQueueFull, esHAL, HAL_GetErrorString);
+  }
+  int ret = HAL_I2CRead(self->inner_, sl_addr, wr_data, wr_size, rd_data, rd_size);
+  return self->queue_(ret, self->clock_ms_(), done, context);
+}
+
+int AsyncAdapter::submit_write_(void *handle, uint8_t sl_addr, uint8_t *wr_data1, int wr_size1, uint8_t *wr_data2,
+                                int wr_size2, AsyncCallback done, void *context) {
+  auto *self = static_cast<AsyncAdapter *>(handle);
+  if (self->allocate_() == nullptr) {
+    return HAL_SetError(heQueueFull, esHAL, HAL_GetErrorString);
+  }
+  int ret = HAL_I2CWrite(self->inner_, sl_addr, wr_data1, wr_size1, wr_data2, wr_size2);
+  return self->queue_(ret, self->clock_ms_(), done, context);
+}
+
+int AsyncAdapter::schedule_(void *handle, uint32_t ms, AsyncCallback done, void *context) {
+  auto *self = static_cast<AsyncAdapter *>(handle);
+  return self->queue_(ecSuccess, self->clock_ms_() + ms, done, context);
+}
+
+void AsyncAdapter::poll_(void *handle) {
+  auto *self = static_cast<AsyncAdapter *>(handle);
+  // Operations queued by the callbacks wait for the next poll().
+  uint32_t last = self->sequence_;
+  for (;;) {
+    uint32_t now = self->clock_ms_();
+    Pending *next = nullptr;
+    for (Pending &pending : self->pending_) {
+      if (pending.sequence == 0 || static_cast<int32_t>(pending.sequence - last) > 0 ||
+          static_cast<int32_t>(now - pending.due_ms) < 0) {
+        continue;
+      }
+      if (next == nullptr || static_cast<int32_t>(pending.sequence - next->sequence) < 0) {
+        next = &pending;
+      }
+    }
+    if (next == nullptr) {
+      return;
+    }
+    Pending done = *next;
+    next->sequence = 0;
+    done.done(done.context, done.result);
+  }
+}
+
+void AsyncAdapter::wait_(void *handle) {
+  auto *self = static_cast<AsyncAdapter *>(handle);
+  uint32_t now = self->clock_ms_();
+  const Pending *next = nullptr;
+  for (const Pending &pending : self->pending_) {
+    if (pending.sequence != 0 &&
+        (next == nullptr || static_cast<int32_t>(pending.due_ms - next->due_ms) < 0)) {
+      next = &pending;
+    }
+  }
+  if (next != nullptr && static_cast<int32_t>(next->due_ms - now) > 0) {
+    self->inner_->msSleep(next->due_ms - now);
+  }
+}
+
+BlockingAdapter *BlockingAdapter::active_ = nullptr;
+
+void BlockingAdapter::wrap(AsyncInterface *inner, Interface_t *wrapped) {
+  this->inner_ = inner;
+  active_ = this;
+  wrapped->handle = this;
+  wrapped->i2cRead = inner->submit_read ? i2c_read_ : nullptr;
+  wrapped->i2cWrite = inner->submit_write ? i2c_write_ : nullptr;
+  wrapped->msSleep = sleep_;
+  wrapped->reset = nullptr;
+  wrapped->lastError = HALErrorInfo_t{};
+}
+
+void BlockingAdapter::complete_(void *context, int result) {
+  auto *completion = static_cast<Completion *>(context);
+  completion->finished = true;
+  completion->result = result;
+}
+
+int BlockingAdapter::wait_(int ret, Completion &completion) {
+  if (ret != ecSuccess) {
+    return ret;
+  }
+  while (!completion.finished) {
+    if (this->inner_->wait != nullptr) {
+      this->inner_->wait(this->inner_->handle);
+    }
+    this->inner_->poll(this->inner_->handle);
+  }
+  return completion.result;
+}
+
+int BlockingAdapter::i2c_read_(void *handle, uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data,
+                               int rd_size) {
+  auto *self = static_cast<BlockingAdapter *>(handle);
+  Completion completion{false, ecSuccess};
+  int ret = self->inner_->submit_read(self->inner_->handle, sl_addr, wr_data, wr_size, rd_data, rd_size, complete_,
+                                      &completion);
+  return self->wait_(ret, completion);
+}
+
+int BlockingAdapter::i2c_write_(void *handle, uint8_t sl_addr, uint8_t *wr_data1, int wr_size1, uint8_t *wr_data2,
+                                int wr_size2) {
+  auto *self = static_cast<BlockingAdapter *>(handle);
+  Completion completion{false, ecSuccess};
+  int ret = self->inner_->submit_write(self->inner_->handle, sl_addr, wr_data1, wr_size1, wr_data2, wr_size2,
+                                       complete_, &completion);
+  return self->wait_(ret, completion);
+}
+
+void BlockingAdapter::sleep_(uint32_t ms) {
+  BlockingAdapter *self = active_;
+  if (self == nullptr) {
+    return;
+  }
+  Completion completion{false, ecSuccess};
+  int ret = self->inner_->schedule(self->inner_->handle, ms, complete_, &completion);
+  self->wait_(ret, completion);
+}
+
+}  // namespace zmod4510
+
+#endif  // USE_ZMOD4510_ASYNC_HAL
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+
+extern "C" {
+  #include "hal.h"
+}
+
+namespace zmod4510 {
+
+// Completion of an asynchronous HAL operation. `result` is what the blocking
+// call would have returned: ecSuccess or the value of HAL_SetError().
+typedef void (*AsyncCallback)(void *context, int result);
+
+// Asynchronous extension of Interface_t. Operations return as soon as they
+// are queued and report their end through `done`; buffers must stay valid
+// until then. A timer wakeup takes the place of msSleep.
+//
+// Callbacks only ever run from poll(), so they run in the caller's context
+// (ESPHome's loop) even when a DMA or interrupt driven backend finishes the
+// transfer elsewhere. A callback may queue the next operation.
+struct AsyncInterface {
+  void *handle;
+  // Like Interface_t::i2cRead and i2cWrite. Return ecSuccess if the
+  // operation was queued, otherwise an error, and `done` is not called.
+  int (*submit_read)(void *handle, uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data, int rd_size,
+                     AsyncCallback done, void *context);
+  int (*submit_write)(void *handle, uint8_t sl_addr, uint8_t *wr_data1, int wr_size1, uint8_t *wr_data2,
+                      int wr_size2, AsyncCallback done, void *context);
+  // Call `done` once `ms` have passed.
+  int (*schedule)(void *handle, uint32_t ms, AsyncCallback done, void *context);
+  // Run the callbacks of the operations that have finished.
+  void (*poll)(void *handle);
+  // Block until the next pending operation can finish, e.g. sleep until its
+  // interrupt. Only blocking callers use it; may be nullptr, which makes them
+  // spin on poll().
+  void (*wait)(void *handle);
+};
+
+// Runs an AsyncInterface on a blocking Interface_t, so event-driven code can
+// use the ESPHome and Arduino HALs: transfers happen when submitted, their
+// callbacks follow on the next poll(). Wakeups are due on `clock_ms`.
+class AsyncAdapter {
+ public:
+  static const uint8_t MAX_PENDING = 32;  // one wakeup for each of zmod4xxx_hal's device slots
+
+  // Route `wrapped` to `inner`.
+  void wrap(Interface_t *inner, AsyncInterface *wrapped, uint32_t (*clock_ms)());
+
+  uint8_t get_pending() const;
+
+ protected:
+  struct Pending {
+    AsyncCallback done;
+    void *context;
+    int result;
+    uint32_t due_ms;
+    uint32_t sequence;  // callbacks run in submission order; 0 marks a free entry
+  };
+
+  static int submit_read_(void *handle, uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data,
+                          int rd_size, AsyncCallback done, void *context);
+  static int submit_write_(void *handle, uint8_t sl_addr, uint8_t *wr_data1, int wr_size1, uint8_t *wr_data2,
+                           int wr_size2, AsyncCallback done, void *context);
+  static int schedule_(void *handle, uint32_t ms, AsyncCallback done, void *context);
+  static void poll_(void *handle);
+  static void wait_(void *handle);
+
+  Pending *allocate_();
+  int queue_(int result, uint32_t due_ms, AsyncCallback done, void *context);
+
+  Interface_t *inner_{nullptr};
+  uint32_t (*clock_ms_)(){nullptr};
+  Pending pending_[MAX_PENDING]{};
+  uint32_t sequence_{0};
+};
+
+// Runs existing blocking code, such as the Renesas drivers, on an
+// AsyncInterface: each call submits the operation and waits for its
+// callback through wait() and poll(). Callbacks of other operations that
+// finish meanwhile run from within the blocking call.
+//
+// Interface_t::msSleep carries no handle, so sleeps go to the most recently
+// wrapped adapter.
+class BlockingAdapter {
+ public:
+  // Route `wrapped` to `inner`.
+  void wrap(AsyncInterface *inner, Interface_t *wrapped);
+
+ protected:
+  struct Completion {
+    bool finished;
+    int result;
+  };
+
+  static int i2c_read_(void *handle, uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data, int rd_size);
+  static int i2c_write_(void *handle, uint8_t sl_addr, uint8_t *wr_data1, int wr_size1, uint8_t *wr_data2,
+                        int wr_size2);
+  static void sleep_(uint32_t ms);
+  static void complete_(void *context, int result);
+
+  // Wait for `completion` of an operation whose submission returned `ret`.
+  int wait_(int ret, Completion &completion);
+
+  AsyncInterface *inner_{nullptr};
+
+  static BlockingAdapter *active_;
+};
+
+}  // namespace zmod4510
@@ -0,0 +1,87 @@
+#include "bus_scheduler.h"
+#include "esphome/core/defines.h"
+#ifdef USE_ZMOD4510_BUS_SCHEDULER
+
+namespace zmod4510 {
+
+bool BusScheduler::add_device(SampleScheduler *scheduler, std::function<void()> &&cycle) {
+  if (this->num_devices_ >= MAX_DEVICES) {
+    return false;
+  }
+  uint32_t phase = this->next_phase_();
+  Device &device = this->devices_[this->num_devices_++];
+  device.scheduler = scheduler;
+  device.cycle = std::move(cycle);
+  device.phase_ms = phase;
+  if (this->started_) {
+    this->start_(device, this->clock_ms_());
+  }
+  return true;
+}
+
+void BusScheduler::start_(Device &device, uint32_t now) {
+  uint32_t deadline = this->epoch_ms_ + device.phase_ms;
+  int32_t behind = static_cast<int32_t>(now - deadline);
+  if (behind > 0) {
+    deadline += (static_cast<uint32_t>(behind) + this->period_ms_ - 1) / this->period_ms_ * this->period_ms_;
+  }
+  device.scheduler->start(deadline);
+}
+
+uint32_t BusScheduler::next_phase_() const {
+  if (this->num_devices_ == 0) {
+    return 0;
+  }
+  // Phases are few, so each gap is found by looking for the nearest phase
+  // after every assigned one.
+  uint32_t best_start = 0;
+  uint32_t best_gap = 0;
+  for (uint8_t i = 0; i < this->num_devices_; i++) {
+    uint32_t start = this->devices_[i].phase_ms;
+    uint32_t gap = this->period_ms_;
+    for (uint8_t j = 0; j < this->num_devices_; j++) {
+      uint32_t distance = (this->devices_[j].phase_ms + this->period_ms_ - start) % this->period_ms_;
+      if (distance != 0 && distance < gap) {
+        gap = distance;
+      }
+    }
+    if (gap > best_gap) {
+      best_gap = gap;
+      best_start = start;
+    }
+  }
+  return (best_start + best_gap / 2) % this->period_ms_;
+}
+
+void BusScheduler::poll() {
+  if (!this->started_) {
+    this->started_ = true;
+    this->epoch_ms_ = this->clock_ms_();
+    for (uint8_t i = 0; i < this->num_devices_; i++) {
+      this->start_(this->devices_[i], this->epoch_ms_);
+    }
+  }
+  for (;;) {
+    // The clock is read again after each cycle, so a device served after
+    // another one sees the time it actually got the bus.
+    uint32_t now = this->clock_ms_();
+    Device *due = nullptr;
+    int32_t due_lateness = 0;
+    for (uint8_t i = 0; i < this->num_devices_; i++) {
+      int32_t lateness = static_cast<int32_t>(now - this->devices_[i].scheduler->get_next_deadline());
+      if (lateness >= 0 && (due == nullptr || lateness > due_lateness)) {
+        due = &this->devices_[i];
+        due_lateness = lateness;
+      }
+    }
+    if (due == nullptr) {
+      return;
+    }
+    due->scheduler->poll(now);
+    due->cycle();
+  }
+}
+
+}  // namespace zmod4510
+
+#endif  // USE_ZMOD4510_BUS_SCHEDULER
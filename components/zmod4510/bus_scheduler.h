@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include "sample_scheduler.h"
+
+namespace zmod4510 {
+
+// Shares one I2C bus between the measurement cycles of several devices with a
+// common period. Each device is given its own phase within the period, placed
+// in the middle of the largest free gap, so the start commands and result reads
+// of different devices do not queue up behind each other. Every device keeps
+// its own SampleScheduler, which fixes its deadlines on exact multiples of the
+// period and measures its cadence.
+//
+// The schedule starts with the first poll(), so devices added during setup
+// all get a full first period however long the remaining setup takes.
+class BusScheduler {
+ public:
+  static const uint8_t MAX_DEVICES = 32;
+
+  // `clock_ms` provides a monotonic millisecond clock.
+  BusScheduler(uint32_t period_ms, uint32_t (*clock_ms)()) : period_ms_(period_ms), clock_ms_(clock_ms) {}
+
+  // Add a device; `scheduler` is started on the first deadline of the device's
+  // phase once the schedule runs, and `cycle` does the bus work of one
+  // measurement cycle. Returns false when all slots are taken.
+  bool add_device(SampleScheduler *scheduler, std::function<void()> &&cycle);
+  // Run the cycle of every device whose deadline has passed, most overdue first.
+  void poll();
+
+  uint8_t get_device_count() const { return this->num_devices_; }
+  uint32_t get_period() const { return this->period_ms_; }
+  // Offset (ms) of the device's deadlines from those of the first device.
+  uint32_t get_phase(uint8_t index) const { return this->devices_[index].phase_ms; }
+
+ protected:
+  struct Device {
+    SampleScheduler *scheduler;
+    std::function<void()> cycle;
+    uint32_t phase_ms;
+  };
+
+  // Phase in the middle of the largest gap between the assigned phases.
+  uint32_t next_phase_() const;
+  // Start `device` on the first deadline of its phase that is not before `now`.
+  void start_(Device &device, uint32_t now);
+
+  uint32_t period_ms_;
+  uint32_t (*clock_ms_)();
+  uint32_t epoch_ms_{0};
+  bool started_{false};
+  Device devices_[MAX_DEVICES];
+  uint8_t num_devices_{0};
+};
+
+}  // namespace zmod4510
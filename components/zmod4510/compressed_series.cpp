@@ -0,0 +1,239 @@
+#include "compressed_series.h"
+#include "esphome/core/defines.h"
+#include <cstring>
+#ifdef USE_ZMOD4510_COMPRESSED_HISTORY
+
+namespace zmod4510 {
+
+// Delta-of-delta classes: control bits, then a signed value of the given width.
+static const uint8_t DOD_BITS[] = {7, 9, 12};
+
+static uint32_t float_bits(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+static float bits_float(uint32_t bits) {
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Round to nearest at `keep` mantissa bits; NaN and infinity pass unchanged.
+static uint32_t round_mantissa(uint32_t bits, uint8_t keep) {
+  uint8_t drop = 23 - keep;
+  if (drop == 0 || (bits & 0x7F800000) == 0x7F800000)
+    return bits;
+  uint32_t rounded = bits + (1u << (drop - 1));
+  if ((rounded & 0x7F800000) == 0x7F800000)
+    return bits;  // Would round up into infinity.
+  return rounded & ~((1u << drop) - 1);
+}
+
+static uint8_t count_leading(uint32_t x) { return x == 0 ? 32 : __builtin_clz(x); }
+static uint8_t count_trailing(uint32_t x) { return x == 0 ? 32 : __builtin_ctz(x); }
+
+void SeriesEncoder::init(uint8_t *buffer, size_t capacity) {
+  this->buffer_ = buffer;
+  this->capacity_bits_ = capacity * 8;
+  this->overflow_ = false;
+  this->state_ = State{};
+  memset(buffer, 0, capacity);
+}
+
+void SeriesEncoder::write_(uint32_t value, uint8_t bits) {
+  if (this->state_.bits + bits > this->capacity_bits_) {
+    this->overflow_ = true;
+    return;
+  }
+  for (int8_t i = bits - 1; i >= 0; i--) {
+    size_t pos = this->state_.bits++;
+    if ((value >> i) & 1)
+      this->buffer_[pos >> 3] |= 0x80 >> (pos & 7);
+  }
+}
+
+void SeriesEncoder::encode_value_(uint8_t channel, uint32_t value) {
+  uint32_t x = value ^ this->state_.value[channel];
+  this->state_.value[channel] = value;
+  if (x == 0) {
+    this->write_(0, 1);
+    return;
+  }
+  uint8_t leading = count_leading(x);
+  uint8_t trailing = count_trailing(x);
+  if (leading > 31)
+    leading = 31;
+  uint8_t prev_leading = this->state_.leading[channel];
+  uint8_t prev_trailing = this->state_.trailing[channel];
+  if (prev_leading + prev_trailing < 32 && leading >= prev_leading && trailing >= prev_trailing) {
+    // Meaningful bits fit the previous window.
+    this->write_(0b10, 2);
+    this->write_(x >> prev_trailing, 32 - prev_leading - prev_trailing);
+    return;
+  }
+  uint8_t length = 32 - leading - trailing;
+  this->write_(0b11, 2);
+  this->write_(leading, 5);
+  this->write_(length - 1, 5);
+  this->write_(x >> trailing, length);
+  this->state_.leading[channel] = leading;
+  this->state_.trailing[channel] = trailing;
+}
+
+bool SeriesEncoder::append(const SeriesRecord &record) {
+  if (this->buffer_ == nullptr || this->state_.count == UINT16_MAX)
+    return false;
+  State saved = this->state_;
+  this->overflow_ = false;
+  this->state_.count++;
+
+  if (saved.count == 0) {
+    // First record of the block is stored verbatim.
+    this->write_(record.timestamp, 32);
+    for (uint8_t c = 0; c < SeriesRecord::NUM_CHANNELS; c++) {
+      this->state_.value[c] = round_mantissa(float_bits(record.values[c]), this->mantissa_bits_);
+      this->write_(this->state_.value[c], 32);
+      this->state_.leading[c] = 32;  // No XOR window yet.
+    }
+  } else {
+    int32_t delta = int32_t(record.timestamp - saved.timestamp);
+    int32_t dod = delta - saved.delta;
+    this->state_.delta = delta;
+    if (dod == 0) {
+      this->write_(0, 1);
+    } else {
+      uint8_t cls = 0;
+      while (cls < sizeof(DOD_BITS) && (dod < -(1 << (DOD_BITS[cls] - 1)) || dod >= (1 << (DOD_BITS[cls] - 1))))
+        cls++;
+      // Unary class prefix: 10, 110, 1110, or 1111 for a full 32-bit value.
+      if (cls < sizeof(DOD_BITS)) {
+        this->write_((1u << (cls + 2)) - 2, cls + 2);
+        this->write_(uint32_t(dod) & ((1u << DOD_BITS[cls]) - 1), DOD_BITS[cls]);
+      } else {
+        this->write_(0b1111, 4);
+        this->write_(uint32_t(dod), 32);
+      }
+    }
+    for (uint8_t c = 0; c < SeriesRecord::NUM_CHANNELS; c++)
+      this->encode_value_(c, round_mantissa(float_bits(record.values[c]), this->mantissa_bits_));
+  }
+  this->state_.timestamp = record.timestamp;
+
+  if (this->overflow_) {
+    // Drop the partial record; the block stays valid as it was.
+    for (size_t pos = saved.bits; pos < this->state_.bits; pos++)
+      this->buffer_[pos >> 3] &= ~(0x80 >> (pos & 7));
+    this->state_ = saved;
+    return false;
+  }
+  return true;
+}
+
+uint32_t SeriesDecoder::read_(uint8_t bits) {
+  uint32_t value = 0;
+  for (uint8_t i = 0; i < bits && this->pos_ < this->bits_; i++, this->pos_++)
+    value = (value << 1) | ((this->buffer_[this->pos_ >> 3] >> (7 - (this->pos_ & 7))) & 1);
+  return value;
+}
+
+uint32_t SeriesDecoder::decode_value_(uint8_t channel) {
+  if (this->read_(1) == 0)
+    return this->value_[channel];
+  uint8_t leading, trailing;
+  if (this->read_(1) == 0) {
+    leading = this->leading_[channel];
+    trailing = this->trailing_[channel];
+  } else {
+    leading = this->read_(5);
+    uint8_t length = this->read_(5) + 1;
+    trailing = 32 - leading - length;
+    this->leading_[channel] = leading;
+    this->trailing_[channel] = trailing;
+  }
+  uint32_t x = this->read_(32 - leading - trailing) << trailing;
+  this->value_[channel] ^= x;
+  return this->value_[channel];
+}
+
+bool SeriesDecoder::next(SeriesRecord &record) {
+  if (this->index_ >= this->count_)
+    return false;
+  if (this->index_ == 0) {
+    this->timestamp_ = this->read_(32);
+    for (uint8_t c = 0; c < SeriesRecord::NUM_CHANNELS; c++)
+      this->value_[c] = this->read_(32);
+  } else {
+    uint8_t cls = 0;
+    while (cls < 4 && this->read_(1) == 1)
+      cls++;
+    if (cls > 0) {
+      uint8_t bits = cls <= 3 ? DOD_BITS[cls - 1] : 32;
+      uint32_t raw = this->read_(bits);
+      int32_t dod = bits == 32 ? int32_t(raw) : int32_t(raw << (32 - bits)) >> (32 - bits);
+      this->delta_ += dod;
+    }
+    this->timestamp_ += this->delta_;
+    for (uint8_t c = 0; c < SeriesRecord::NUM_CHANNELS; c++)
+      this->decode_value_(c);
+  }
+  this->index_++;
+  record.timestamp = this->timestamp_;
+  for (uint8_t c = 0; c < SeriesRecord::NUM_CHANNELS; c++)
+    record.values[c] = bits_float(this->value_[c]);
+  return true;
+}
+
+void CompressedHistory::init(size_t block_bytes, size_t num_blocks) {
+  this->block_bytes_ = block_bytes;
+  this->num_blocks_ = num_blocks;
+  this->data_.reset(num_blocks ? new uint8_t[block_bytes * num_blocks] : nullptr);
+  this->blocks_.reset(num_blocks ? new Block[num_blocks]() : nullptr);
+  this->first_ = 0;
+  this->used_ = 0;
+  if (num_blocks != 0)
+    this->open_block_(0);
+}
+
+void CompressedHistory::open_block_(size_t index) {
+  this->blocks_[index] = Block{0, 0};
+  this->encoder_.init(this->data_.get() + index * this->block_bytes_, this->block_bytes_);
+  if (this->used_ < this->num_blocks_) {
+    this->used_++;
+  } else {
+    this->first_ = (this->first_ + 1) % this->num_blocks_;
+  }
+}
+
+void CompressedHistory::add(const SeriesRecord &record) {
+  if (this->num_blocks_ == 0)
+    return;
+  size_t current = (this->first_ + this->used_ - 1) % this->num_blocks_;
+  if (!this->encoder_.append(record)) {
+    current = (current + 1) % this->num_blocks_;
+    this->open_block_(current);
+    if (!this->encoder_.append(record))
+      return;  // Block too small for a single record.
+  }
+  this->blocks_[current].bits = this->encoder_.get_bits();
+  this->blocks_[current].count = this->encoder_.get_count();
+}
+
+uint32_t CompressedHistory::get_count() const {
+  uint32_t count = 0;
+  for (size_t i = 0; i < this->used_; i++)
+    count += this->blocks_[(this->first_ + i) % this->num_blocks_].count;
+  return count;
+}
+
+size_t CompressedHistory::get_used_bytes() const {
+  size_t bits = 0;
+  for (size_t i = 0; i < this->used_; i++)
+    bits += this->blocks_[(this->first_ + i) % this->num_blocks_].bits;
+  return (bits + 7) / 8;
+}
+
+}  // namespace zmod4510
+
+#endif  // USE_ZMOD4510_COMPRESSED_HISTORY
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "sample_record.h"
+
+namespace zmod4510 {
+
+// Gorilla-style encoder: timestamps as delta-of-delta, values as the XOR with
+// the previous value of the same channel. Slowly changing gas readings on a
+// fixed sample period mostly encode to a few bits per channel.
+// The encoder appends to a caller-owned, zeroed buffer.
+class SeriesEncoder {
+ public:
+  void init(uint8_t *buffer, size_t capacity);
+  // Round values to `bits` mantissa bits before encoding (23 keeps them exact).
+  // Dropping the sensor noise below the reading resolution makes XOR residues
+  // much shorter.
+  void set_mantissa_bits(uint8_t bits) { this->mantissa_bits_ = bits > 23 ? 23 : bits; }
+  // Append one record; returns false (and leaves the block unchanged) if it
+  // does not fit.
+  bool append(const SeriesRecord &record);
+
+  uint16_t get_count() const { return this->state_.count; }
+  size_t get_bits() const { return this->state_.bits; }
+
+ protected:
+  struct State {
+    size_t bits;
+    uint16_t count;
+    uint32_t timestamp;
+    int32_t delta;
+    uint32_t value[SeriesRecord::NUM_CHANNELS];
+    uint8_t leading[SeriesRecord::NUM_CHANNELS];
+    uint8_t trailing[SeriesRecord::NUM_CHANNELS];
+  };
+
+  void write_(uint32_t value, uint8_t bits);
+  void encode_value_(uint8_t channel, uint32_t value);
+
+  uint8_t *buffer_{nullptr};
+  size_t capacity_bits_{0};
+  bool overflow_{false};
+  uint8_t mantissa_bits_{23};
+  State state_{};
+};
+
+// Sequential decoder for a block written by SeriesEncoder.
+class SeriesDecoder {
+ public:
+  SeriesDecoder(const uint8_t *buffer, size_t bits, uint16_t count) : buffer_(buffer), bits_(bits), count_(count) {}
+  // Decode the next record; returns false at the end of the block.
+  bool next(SeriesRecord &record);
+
+ protected:
+  uint32_t read_(uint8_t bits);
+  uint32_t decode_value_(uint8_t channel);
+
+  const uint8_t *buffer_;
+  size_t bits_;
+  uint16_t count_;
+  size_t pos_{0};
+  uint16_t index_{0};
+  uint32_t timestamp_{0};
+  int32_t delta_{0};
+  uint32_t value_[SeriesRecord::NUM_CHANNELS]{};
+  uint8_t leading_[SeriesRecord::NUM_CHANNELS]{};
+  uint8_t trailing_[SeriesRecord::NUM_CHANNELS]{};
+};
+
+// Rolling compressed history made of fixed-size, independently decodable
+// blocks. When all blocks are full the oldest one is reused.
+class CompressedHistory {
+ public:
+  void init(size_t block_bytes, size_t num_blocks);
+  void set_mantissa_bits(uint8_t bits) { this->encoder_.set_mantissa_bits(bits); }
+  void add(const SeriesRecord &record);
+
+  size_t get_memory_size() const { return this->block_bytes_ * this->num_blocks_; }
+  uint32_t get_count() const;
+  size_t get_used_bytes() const;
+
+  // Call `fn(const SeriesRecord &)` for every stored record, oldest first.
+  template<typename F> void for_each(F &&fn) const {
+    for (size_t i = 0; i < this->used_; i++) {
+      size_t b = (this->first_ + i) % this->num_blocks_;
+      SeriesDecoder decoder(this->data_.get() + b * this->block_bytes_, this->blocks_[b].bits, this->blocks_[b].count);
+      SeriesRecord record;
+      while (decoder.next(record))
+        fn(record);
+    }
+  }
+
+ protected:
+  struct Block {
+    size_t bits;
+    uint16_t count;
+  };
+
+  void open_block_(size_t index);
+
+  std::unique_ptr<uint8_t[]> data_;
+  std::unique_ptr<Block[]> blocks_;
+  size_t block_bytes_{0};
+  size_t num_blocks_{0};
+  size_t first_{0};
+  size_t used_{0};
+  SeriesEncoder encoder_;
+};
+
+}  // namespace zmod4510
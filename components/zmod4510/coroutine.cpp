@@ -0,0 +1,200 @@
+#include "coroutine.h"
+#include "esphome/core/defines.h"
+
+#if defined(USE_ZMOD4510_ASYNC_HAL) && defined(__cpp_impl_coroutine)
+
+#include <cstring>
+#include <new>
+
+namespace zmod4510 {
+
+namespace {
+
+struct FrameCacheState {
+  struct Entry {
+    void *frame;
+    size_t size;
+  };
+
+  Entry entries[FrameCache::MAX_FRAMES];
+  uint8_t count;
+  bool disabled;
+  uint32_t heap_allocations;
+  uint32_t reuses;
+  size_t largest_frame;
+};
+
+// Frames are allocated and freed by the thread running their executor.
+thread_local FrameCacheState frame_cache;
+
+}  // namespace
+
+void *FrameCache::allocate(size_t size) {
+  FrameCacheState &cache = frame_cache;
+  if (size > cache.largest_frame) {
+    cache.largest_frame = size;
+  }
+  for (uint8_t i = 0; i < cache.count; i++) {
+    if (cache.entries[i].size == size) {
+      void *frame = cache.entries[i].frame;
+      memmove(&cache.entries[i], &cache.entries[i + 1], sizeof(cache.entries[0]) * (--cache.count - i));
+      cache.reuses++;
+      return frame;
+    }
+  }
+  cache.heap_allocations++;
+  return ::operator new(size);
+}
+
+void FrameCache::release(void *frame, size_t size) {
+  FrameCacheState &cache = frame_cache;
+  if (cache.disabled) {
+    ::operator delete(frame);
+    return;
+  }
+  if (cache.count >= MAX_FRAMES) {
+    // Give up the oldest frame, which is likely left over from a sequence
+    // that has stopped running, such as the bring-up.
+    ::operator delete(cache.entries[0].frame);
+    memmove(&cache.entries[0], &cache.entries[1], sizeof(cache.entries[0]) * --cache.count);
+  }
+  cache.entries[cache.count++] = {frame, size};
+}
+
+void FrameCache::clear() {
+  FrameCacheState &cache = frame_cache;
+  while (cache.count != 0) {
+    ::operator delete(cache.entries[--cache.count].frame);
+  }
+}
+
+void FrameCache::set_enabled(bool enabled) {
+  frame_cache.disabled = !enabled;
+  if (!enabled) {
+    clear();
+  }
+}
+
+uint32_t FrameCache::get_heap_allocations() { return frame_cache.heap_allocations; }
+uint32_t FrameCache::get_reuses() { return frame_cache.reuses; }
+size_t FrameCache::get_largest_frame() { return frame_cache.largest_frame; }
+
+void FrameCache::reset_stats() {
+  frame_cache.heap_allocations = 0;
+  frame_cache.reuses = 0;
+  frame_cache.largest_frame = 0;
+}
+
+bool Operation::await_suspend(std::coroutine_handle<> handle) {
+  AsyncInterface *hal = this->executor_->hal_;
+  this->handle_ = handle;
+  switch (this->kind_) {
+    case READ:
+      this->result_ = hal->submit_read(hal->handle, this->sl_addr_, this->data1_, this->size1_, this->data2_,
+                                       this->size2_, done_, this);
+      break;
+    case WRITE:
+      this->result_ = hal->submit_write(hal->handle, this->sl_addr_, this->data1_, this->size1_, this->data2_,
+                                        this->size2_, done_, this);
+      break;
+    case SLEEP:
+      this->result_ = hal->schedule(hal->handle, this->ms_, done_, this);
+      break;
+  }
+  // A rejected submission resumes the coroutine right away with its error.
+  return this->result_ == ecSuccess;
+}
+
+void Operation::done_(void *context, int result) {
+  auto *self = static_cast<Operation *>(context);
+  self->result_ = result;
+  self->executor_->ready_(self->handle_);
+}
+
+Executor::~Executor() {
+  for (std::coroutine_handle<> &task : this->tasks_) {
+    if (task) {
+      task.destroy();
+    }
+  }
+}
+
+bool Executor::spawn(Task<> &&task) {
+  for (std::coroutine_handle<> &slot : this->tasks_) {
+    if (!slot) {
+      slot = task.release();
+      this->resumes_++;
+      slot.resume();
+      this->reap_();
+      return true;
+    }
+  }
+  return false;
+}
+
+void Executor::poll() {
+  this->hal_->poll(this->hal_->handle);
+  // Callbacks only queue coroutines; they run here, outside of the HAL.
+  while (this->ready_count_ != 0) {
+    std::coroutine_handle<> handle = this->ready_queue_[this->ready_head_];
+    this->ready_head_ = (this->ready_head_ + 1) % MAX_TASKS;
+    this->ready_count_--;
+    this->resumes_++;
+    handle.resume();
+  }
+  this->reap_();
+}
+
+uint8_t Executor::get_running() const {
+  uint8_t count = 0;
+  for (const std::coroutine_handle<> &task : this->tasks_) {
+    if (task) {
+      count++;
+    }
+  }
+  return count;
+}
+
+void Executor::ready_(std::coroutine_handle<> handle) {
+  this->ready_queue_[(this->ready_head_ + this->ready_count_) % MAX_TASKS] = handle;
+  this->ready_count_++;
+}
+
+void Executor::reap_() {
+  for (std::coroutine_handle<> &task : this->tasks_) {
+    if (task && task.done()) {
+      task.destroy();
+      task = nullptr;
+    }
+  }
+}
+
+Operation Executor::read(uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data, int rd_size) {
+  Operation operation(this, Operation::READ);
+  operation.sl_addr_ = sl_addr;
+  operation.data1_ = wr_data;
+  operation.size1_ = wr_size;
+  operation.data2_ = rd_data;
+  operation.size2_ = rd_size;
+  return operation;
+}
+
+Operation Executor::write(uint8_t sl_addr, uint8_t *wr_data1, int wr_size1, uint8_t *wr_data2, int wr_size2) {
+  Operation operation(this, Operation::WRITE);
+  operation.sl_addr_ = sl_addr;
+  operation.data1_ = wr_data1;
+  operation.size1_ = wr_size1;
+  operation.data2_ = wr_data2;
+  operation.size2_ = wr_size2;
+  return operation;
+}
+
+Operation Executor::sleep(uint32_t ms) {
+  Operation operation(this, Operation::SLEEP);
+  operation.ms_ = ms;
+  return operation;
+}
+
+}  // namespace zmod4510
+
+#endif  // USE_ZMOD4510_ASYNC_HAL && __cpp_impl_coroutine
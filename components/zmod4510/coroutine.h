@@ -0,0 +1,223 @@
+#pragma once
+
+// C++20 coroutines for sensor sequences on an AsyncInterface. Everything here
+// is compiled only when the compiler has coroutines enabled (-std=gnu++20, or
+// -fcoroutines with GCC 10); a gnu++17 build, ESPHome's default, sees none of
+// it. Like the rest of the async HAL, the sources are built with the
+// `async_hal` option (USE_ZMOD4510_ASYNC_HAL).
+#ifdef __cpp_impl_coroutine
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include <utility>
+#include "async_hal.h"
+
+namespace zmod4510 {
+
+// Recycles coroutine frames. A sensor sequence creates the same few frames in
+// every cycle, so freed frames are kept by size and handed out again instead
+// of going back to the heap, which keeps a running executor free of heap
+// allocations. The cache and its statistics belong to the calling thread.
+class FrameCache {
+ public:
+  // Room for a measurement and its sequencer wait in each of an Executor's
+  // tasks.
+  static const uint8_t MAX_FRAMES = 64;
+
+  static void *allocate(size_t size);
+  static void release(void *frame, size_t size);
+  // Return all cached frames to the heap.
+  static void clear();
+  // With the cache disabled every frame comes from the heap.
+  static void set_enabled(bool enabled);
+
+  static uint32_t get_heap_allocations();
+  static uint32_t get_reuses();
+  static size_t get_largest_frame();
+  static void reset_stats();
+};
+
+// Ends a coroutine by resuming the one awaiting it, unless that one is still
+// inside Task::await_suspend() and simply carries on.
+struct FinalAwaiter {
+  bool await_ready() const noexcept { return false; }
+  template<typename Promise> std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+    auto &promise = handle.promise();
+    if (promise.continuation && !promise.started_inline) {
+      return promise.continuation;
+    }
+    return std::noop_coroutine();
+  }
+  void await_resume() const noexcept {}
+};
+
+struct PromiseBase {
+  static void *operator new(size_t size) { return FrameCache::allocate(size); }
+  static void operator delete(void *frame, size_t size) { FrameCache::release(frame, size); }
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  FinalAwaiter final_suspend() const noexcept { return {}; }
+  // Builds run without exceptions, so there is nothing to propagate.
+  void unhandled_exception() const { abort(); }
+
+  std::coroutine_handle<> continuation;
+  bool started_inline{false};
+};
+
+template<typename T> class Task;
+
+template<typename T> struct TaskPromise : PromiseBase {
+  Task<T> get_return_object();
+  void return_value(T result) { this->value = std::move(result); }
+
+  T value{};
+};
+
+template<> struct TaskPromise<void> : PromiseBase {
+  Task<void> get_return_object();
+  void return_void() const {}
+};
+
+// A lazily started coroutine returning T. Awaiting it runs it up to its end,
+// suspending the awaiting coroutine as often as the task suspends; Executor
+// runs the outermost ones. The frame is destroyed with the Task.
+//
+// The awaiting coroutine starts the task with a plain resume() rather than a
+// symmetric transfer, so a task that ends without suspending returns to it
+// without growing the stack, also where the compiler makes no tail calls
+// (-O0, the Xtensa windowed ABI). Resuming after a suspension nests only as
+// deep as the tasks are.
+template<typename T = void> class Task {
+ public:
+  using promise_type = TaskPromise<T>;
+  using Handle = std::coroutine_handle<promise_type>;
+
+  explicit Task(Handle handle) : handle_(handle) {}
+  Task(Task &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+  ~Task() {
+    if (this->handle_) {
+      this->handle_.destroy();
+    }
+  }
+
+  bool await_ready() const noexcept { return false; }
+  bool await_suspend(std::coroutine_handle<> awaiting) {
+    promise_type &promise = this->handle_.promise();
+    promise.continuation = awaiting;
+    promise.started_inline = true;
+    this->handle_.resume();
+    promise.started_inline = false;
+    return !this->handle_.done();
+  }
+  T await_resume() {
+    if constexpr (!std::is_void_v<T>) {
+      return std::move(this->handle_.promise().value);
+    }
+  }
+
+  // Hand the frame over to the caller, which must destroy it.
+  Handle release() { return std::exchange(this->handle_, nullptr); }
+
+ protected:
+  Handle handle_;
+};
+
+template<typename T> Task<T> TaskPromise<T>::get_return_object() {
+  return Task<T>(Task<T>::Handle::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+  return Task<void>(Task<void>::Handle::from_promise(*this));
+}
+
+class Executor;
+
+// One AsyncInterface operation to co_await. The result is what the blocking
+// HAL call would have returned: ecSuccess or the value of HAL_SetError().
+class Operation {
+ public:
+  bool await_ready() const noexcept { return false; }
+  bool await_suspend(std::coroutine_handle<> handle);
+  int await_resume() const noexcept { return this->result_; }
+
+ protected:
+  friend class Executor;
+
+  enum Kind : uint8_t { READ, WRITE, SLEEP };
+
+  Operation(Executor *executor, Kind kind) : executor_(executor), kind_(kind) {}
+
+  static void done_(void *context, int result);
+
+  Executor *executor_;
+  std::coroutine_handle<> handle_;
+  uint8_t *data1_{nullptr};
+  uint8_t *data2_{nullptr};
+  int size1_{0};
+  int size2_{0};
+  uint32_t ms_{0};
+  int result_{ecSuccess};
+  uint8_t sl_addr_{0};
+  Kind kind_;
+};
+
+// Runs coroutines on one AsyncInterface, single threaded and in steps that fit
+// ESPHome's loop: each poll() dispatches the operations that have finished and
+// resumes the coroutines waiting for them until they suspend again. A
+// coroutine only ever runs inside spawn() or poll(), so it needs no locking
+// against other coroutines, and a sequence that would block for seconds costs
+// the loop a few short steps instead.
+//
+// Operations complete one poll() after they were submitted at the earliest,
+// so a sequence of n transfers takes n loop passes; sequences that need their
+// transfers back to back call the blocking driver functions in between.
+//
+// An executor must not outlive its AsyncInterface; destroying it destroys the
+// unfinished tasks, and their pending operations must not complete after that.
+class Executor {
+ public:
+  static const uint8_t MAX_TASKS = 32;
+
+  explicit Executor(AsyncInterface *hal) : hal_(hal) {}
+  Executor(const Executor &) = delete;
+  Executor &operator=(const Executor &) = delete;
+  ~Executor();
+
+  // Run `task` up to its first suspension. Returns false, dropping the task,
+  // if MAX_TASKS are running.
+  bool spawn(Task<> &&task);
+  void poll();
+
+  uint8_t get_running() const;
+  uint32_t get_resumes() const { return this->resumes_; }
+  AsyncInterface *get_hal() const { return this->hal_; }
+
+  // Awaitables with the arguments of AsyncInterface; buffers must live in
+  // the coroutine frame or longer.
+  Operation read(uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data, int rd_size);
+  Operation write(uint8_t sl_addr, uint8_t *wr_data1, int wr_size1, uint8_t *wr_data2, int wr_size2);
+  Operation sleep(uint32_t ms);
+
+ protected:
+  friend class Operation;
+
+  void ready_(std::coroutine_handle<> handle);
+  void reap_();
+
+  AsyncInterface *hal_;
+  std::coroutine_handle<> tasks_[MAX_TASKS]{};
+  // Every task waits for one operation at most, so MAX_TASKS entries suffice.
+  std::coroutine_handle<> ready_queue_[MAX_TASKS]{};
+  uint8_t ready_head_{0};
+  uint8_t ready_count_{0};
+  uint32_t resumes_{0};
+};
+
+}  // namespace zmod4510
+
+#endif  // __cpp_impl_coroutine
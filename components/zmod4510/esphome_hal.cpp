@@ -0,0 +1,91 @@
+#include "esphome_hal.h"
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include <cstdio>
+#include <cstring>
+
+namespace zmod4510 {
+
+// Largest register write issued by the drivers (sequencer config plus address).
+static const size_t MAX_WRITE_LEN = 64;
+
+static char const *get_error_string(int error, int scope, char *str, int str_len) {
+#ifdef HAL_NO_ERROR_STRINGS
+  snprintf(str, str_len, "ESPHome I2C Error: %d", error);
+  return str;
+#else
+  char const *err;
+  switch (error) {
+    case esphome::i2c::ERROR_INVALID_ARGUMENT:
+      err = "Invalid argument";
+      break;
+    case esphome::i2c::ERROR_NOT_ACKNOWLEDGED:
+      err = "Received NACK";
+      break;
+    case esphome::i2c::ERROR_TIMEOUT:
+      err = "Timeout";
+      break;
+    case esphome::i2c::ERROR_NOT_INITIALIZED:
+      err = "Bus not initialized";
+      break;
+    case esphome::i2c::ERROR_TOO_LARGE:
+      err = "Data too long to fit in transmit buffer";
+      break;
+    default:
+      snprintf(str, str_len, "ESPHome I2C Error: Unknown error %d", error);
+      return str;
+  }
+  snprintf(str, str_len, "ESPHome I2C Error: %s", err);
+  return str;
+#endif
+}
+
+static void esphome_delay(uint32_t ms) {
+  // Long driver waits (e.g. the one minute cleaning procedure) must not trip
+  // the task watchdog.
+  esphome::App.feed_wdt();
+  esphome::delay(ms);
+}
+
+static int esphome_i2c_read(void *handle, uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data,
+                            int rd_size) {
+  auto *bus = static_cast<esphome::i2c::I2CBus *>(handle);
+  esphome::i2c::ErrorCode err = esphome::i2c::ERROR_OK;
+  if (wr_size) {
+    // Register address followed by a repeated start.
+    err = bus->write(sl_addr, wr_data, wr_size, false);
+  }
+  if (err == esphome::i2c::ERROR_OK) {
+    err = bus->read(sl_addr, rd_data, rd_size);
+  }
+  if (err != esphome::i2c::ERROR_OK)
+    return HAL_SetError(err, eesESPHome, get_error_string);
+  return ecSuccess;
+}
+
+static int esphome_i2c_write(void *handle, uint8_t sl_addr, uint8_t *wr_data1, int wr_size1, uint8_t *wr_data2,
+                             int wr_size2) {
+  auto *bus = static_cast<esphome::i2c::I2CBus *>(handle);
+  uint8_t buf[MAX_WRITE_LEN];
+  if (static_cast<size_t>(wr_size1 + wr_size2) > sizeof(buf))
+    return HAL_SetError(esphome::i2c::ERROR_TOO_LARGE, eesESPHome, get_error_string);
+  if (wr_size1)
+    memcpy(buf, wr_data1, wr_size1);
+  if (wr_size2)
+    memcpy(buf + wr_size1, wr_data2, wr_size2);
+  esphome::i2c::ErrorCode err = bus->write(sl_addr, buf, wr_size1 + wr_size2);
+  if (err != esphome::i2c::ERROR_OK)
+    return HAL_SetError(err, eesESPHome, get_error_string);
+  return ecSuccess;
+}
+
+void esphome_hal_init(Interface_t *hal, esphome::i2c::I2CBus *bus) {
+  hal->handle = bus;
+  hal->i2cRead = esphome_i2c_read;
+  hal->i2cWrite = esphome_i2c_write;
+  hal->msSleep = esphome_delay;
+  hal->reset = nullptr;
+  hal->lastError = HALErrorInfo_t{};
+}
+
+}  // namespace zmod4510
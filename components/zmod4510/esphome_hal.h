@@ -0,0 +1,18 @@
+#pragma once
+
+#include "esphome/components/i2c/i2c.h"
+
+extern "C" {
+  #include "hal.h"
+}
+
+namespace zmod4510 {
+
+// Error scope of HAL errors raised by the ESPHome I2C bus, next to aesArduino.
+enum ESPHomeErrorDefs { eesESPHome = 0x5000 };
+
+// Populate `hal` with I2C and delay functions running on an ESPHome I2C bus.
+// This is the ESPHome counterpart of HAL_Init() in hal/arduino/arduino.cpp.
+void esphome_hal_init(Interface_t *hal, esphome::i2c::I2CBus *bus);
+
+}  // namespace zmod4510
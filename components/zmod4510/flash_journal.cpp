@@ -0,0 +1,209 @@
+#include "flash_journal.h"
+#include "esphome/core/defines.h"
+#ifdef USE_ZMOD4510_JOURNAL
+#include "crc32.h"
+#include <cstring>
+#include <memory>
+#ifdef USE_ESP32
+#include <esp_partition.h>
+#endif
+
+namespace zmod4510 {
+
+static const uint32_t SEGMENT_MAGIC = 0x4C4E4A5A;  // "ZJNL"
+static const uint16_t JOURNAL_VERSION = 1;
+static const uint16_t BATCH_MAGIC = 0xB47C;
+static const uint16_t ERASED_LENGTH = 0xFFFF;
+
+struct SegmentHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t reserved;
+  uint32_t sequence;
+  uint32_t crc;  // Over the fields above.
+};
+
+struct BatchHeader {
+  uint16_t length;
+  uint16_t magic;
+  uint32_t crc;  // Over the payload.
+};
+
+#ifdef USE_ESP32
+bool PartitionStorage::open() {
+  this->partition_ = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, this->label_);
+  return this->partition_ != nullptr;
+}
+
+size_t PartitionStorage::get_size() const {
+  return static_cast<const esp_partition_t *>(this->partition_)->size;
+}
+
+bool PartitionStorage::read(size_t offset, void *data, size_t len) {
+  return esp_partition_read(static_cast<const esp_partition_t *>(this->partition_), offset, data, len) == ESP_OK;
+}
+
+bool PartitionStorage::write(size_t offset, const void *data, size_t len) {
+  return esp_partition_write(static_cast<const esp_partition_t *>(this->partition_), offset, data, len) == ESP_OK;
+}
+
+bool PartitionStorage::erase(size_t offset, size_t len) {
+  return esp_partition_erase_range(static_cast<const esp_partition_t *>(this->partition_), offset, len) == ESP_OK;
+}
+#else
+FileStorage::~FileStorage() {
+  if (this->file_ != nullptr)
+    fclose(this->file_);
+}
+
+bool FileStorage::open() {
+  this->file_ = fopen(this->path_, "r+b");
+  if (this->file_ == nullptr) {
+    this->file_ = fopen(this->path_, "w+b");
+    if (this->file_ == nullptr)
+      return false;
+  }
+  // Grow the file to its full size with erased bytes.
+  fseek(this->file_, 0, SEEK_END);
+  long end = ftell(this->file_);
+  for (long i = end; i < long(this->size_); i++)
+    fputc(0xFF, this->file_);
+  return fflush(this->file_) == 0;
+}
+
+bool FileStorage::read(size_t offset, void *data, size_t len) {
+  if (offset + len > this->size_ || fseek(this->file_, offset, SEEK_SET) != 0)
+    return false;
+  return fread(data, 1, len, this->file_) == len;
+}
+
+bool FileStorage::write(size_t offset, const void *data, size_t len) {
+  std::unique_ptr<uint8_t[]> current(new uint8_t[len]);
+  if (!this->read(offset, current.get(), len))
+    return false;
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < len; i++)
+    current[i] &= bytes[i];
+  if (fseek(this->file_, offset, SEEK_SET) != 0 || fwrite(current.get(), 1, len, this->file_) != len)
+    return false;
+  return fflush(this->file_) == 0;
+}
+
+bool FileStorage::erase(size_t offset, size_t len) {
+  if (offset + len > this->size_ || fseek(this->file_, offset, SEEK_SET) != 0)
+    return false;
+  for (size_t i = 0; i < len; i++)
+    fputc(0xFF, this->file_);
+  return fflush(this->file_) == 0;
+}
+#endif
+
+uint32_t FlashJournal::read_header_(uint32_t segment) {
+  SegmentHeader header;
+  if (!this->storage_->read(segment * SEGMENT_SIZE, &header, sizeof(header)))
+    return 0;
+  if (header.magic != SEGMENT_MAGIC || header.version != JOURNAL_VERSION ||
+      header.crc != crc32(&header, offsetof(SegmentHeader, crc)))
+    return 0;
+  return header.sequence;
+}
+
+bool FlashJournal::read_batch_(uint32_t segment, size_t &offset, uint8_t *data, size_t &len) {
+  if (offset == 0) {
+    if (this->read_header_(segment) == 0)
+      return false;
+    offset = sizeof(SegmentHeader);
+  }
+  BatchHeader header;
+  if (offset + sizeof(header) > SEGMENT_SIZE ||
+      !this->storage_->read(segment * SEGMENT_SIZE + offset, &header, sizeof(header)))
+    return false;
+  if (header.length == ERASED_LENGTH || header.magic != BATCH_MAGIC || header.length > MAX_BATCH ||
+      offset + sizeof(header) + header.length > SEGMENT_SIZE)
+    return false;
+  if (!this->storage_->read(segment * SEGMENT_SIZE + offset + sizeof(header), data, header.length) ||
+      crc32(data, header.length) != header.crc)
+    return false;
+  offset += sizeof(header) + header.length;
+  len = header.length;
+  return true;
+}
+
+bool FlashJournal::mount() {
+  if (!this->storage_->open())
+    return false;
+  this->num_segments_ = this->storage_->get_size() / SEGMENT_SIZE;
+  if (this->num_segments_ < 2)
+    return false;
+
+  // Only segment headers are read to find the newest segment.
+  this->sequence_ = 0;
+  for (uint32_t segment = 0; segment < this->num_segments_; segment++) {
+    uint32_t sequence = this->read_header_(segment);
+    if (sequence > this->sequence_) {
+      this->sequence_ = sequence;
+      this->head_ = segment;
+    }
+  }
+  if (this->sequence_ == 0) {
+    // Empty or foreign partition: start over in the first segment.
+    this->head_ = this->num_segments_ - 1;
+    return this->advance_();
+  }
+
+  // Walk the batches of the head segment to find the append position. If it
+  // ends in a torn batch, the segment is closed and the next append moves on.
+  size_t offset = 0;
+  size_t len;
+  while (this->read_batch_(this->head_, offset, this->scratch_, len)) {
+  }
+  BatchHeader header;
+  if (offset == 0) {
+    offset = SEGMENT_SIZE;
+  } else if (offset + sizeof(header) <= SEGMENT_SIZE &&
+             this->storage_->read(this->head_ * SEGMENT_SIZE + offset, &header, sizeof(header)) &&
+             header.length != ERASED_LENGTH) {
+    offset = SEGMENT_SIZE;
+  }
+  this->write_offset_ = offset;
+  return true;
+}
+
+bool FlashJournal::advance_() {
+  uint32_t segment = (this->head_ + 1) % this->num_segments_;
+  if (!this->storage_->erase(segment * SEGMENT_SIZE, SEGMENT_SIZE))
+    return false;
+  this->erases_++;
+  SegmentHeader header{SEGMENT_MAGIC, JOURNAL_VERSION, 0xFFFF, this->sequence_ + 1, 0};
+  header.crc = crc32(&header, offsetof(SegmentHeader, crc));
+  if (!this->storage_->write(segment * SEGMENT_SIZE, &header, sizeof(header)))
+    return false;
+  this->flash_bytes_ += sizeof(header);
+  this->head_ = segment;
+  this->sequence_++;
+  this->write_offset_ = sizeof(header);
+  return true;
+}
+
+bool FlashJournal::append(const void *data, size_t len) {
+  if (this->num_segments_ == 0 || len == 0 || len > MAX_BATCH)
+    return false;
+  if (this->write_offset_ + sizeof(BatchHeader) + len > SEGMENT_SIZE && !this->advance_())
+    return false;
+
+  // Header first: a batch torn by a reset fails its CRC and closes the segment.
+  BatchHeader header{uint16_t(len), BATCH_MAGIC, crc32(data, len)};
+  size_t base = this->head_ * SEGMENT_SIZE + this->write_offset_;
+  if (!this->storage_->write(base, &header, sizeof(header)) || !this->storage_->write(base + sizeof(header), data, len)) {
+    this->write_offset_ = SEGMENT_SIZE;
+    return false;
+  }
+  this->write_offset_ += sizeof(header) + len;
+  this->flash_bytes_ += sizeof(header) + len;
+  this->payload_bytes_ += len;
+  return true;
+}
+
+}  // namespace zmod4510
+
+#endif  // USE_ZMOD4510_JOURNAL
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace zmod4510 {
+
+// Raw NOR-flash-like storage: erased bytes read 0xFF, writes only clear bits
+// and erases work on whole segments.
+class JournalStorage {
+ public:
+  virtual ~JournalStorage() = default;
+  virtual bool open() = 0;
+  virtual size_t get_size() const = 0;
+  virtual bool read(size_t offset, void *data, size_t len) = 0;
+  virtual bool write(size_t offset, const void *data, size_t len) = 0;
+  virtual bool erase(size_t offset, size_t len) = 0;
+};
+
+#ifdef USE_ESP32
+// Data partition looked up by label.
+class PartitionStorage : public JournalStorage {
+ public:
+  explicit PartitionStorage(const char *label) : label_(label) {}
+  bool open() override;
+  size_t get_size() const override;
+  bool read(size_t offset, void *data, size_t len) override;
+  bool write(size_t offset, const void *data, size_t len) override;
+  bool erase(size_t offset, size_t len) override;
+
+ protected:
+  const char *label_;
+  const void *partition_{nullptr};
+};
+#else
+// File-backed stand-in for host builds; emulates NOR write semantics.
+class FileStorage : public JournalStorage {
+ public:
+  FileStorage(const char *path, size_t size) : path_(path), size_(size) {}
+  ~FileStorage() override;
+  bool open() override;
+  size_t get_size() const override { return this->size_; }
+  bool read(size_t offset, void *data, size_t len) override;
+  bool write(size_t offset, const void *data, size_t len) override;
+  bool erase(size_t offset, size_t len) override;
+
+ protected:
+  const char *path_;
+  size_t size_;
+  FILE *file_{nullptr};
+};
+#endif
+
+// Append-only journal of batches over a ring of flash segments. Each segment
+// starts with a CRC-protected header carrying a sequence number, so mounting
+// reads one header per segment plus the batches of the newest segment. Batches
+// carry their own CRC; a torn batch ends its segment. Segments are used in
+// ring order, which spreads erases evenly over the partition.
+class FlashJournal {
+ public:
+  static const size_t SEGMENT_SIZE = 4096;
+  static const size_t MAX_BATCH = 1024;
+
+  explicit FlashJournal(JournalStorage *storage) : storage_(storage) {}
+
+  // Find the newest segment and the append position. Returns false if the
+  // storage cannot be used.
+  bool mount();
+  // Append one batch of at most MAX_BATCH bytes.
+  bool append(const void *data, size_t len);
+  // Call `fn(const uint8_t *data, size_t len)` for every valid batch, oldest
+  // first.
+  template<typename F> void for_each(F &&fn) {
+    for (uint32_t i = 1; i <= this->num_segments_; i++) {
+      uint32_t segment = (this->head_ + i) % this->num_segments_;
+      size_t offset = 0;
+      size_t len;
+      while (this->read_batch_(segment, offset, this->scratch_, len))
+        fn(this->scratch_, len);
+    }
+  }
+
+  uint32_t get_num_segments() const { return this->num_segments_; }
+  uint32_t get_erases() const { return this->erases_; }
+  uint32_t get_sequence() const { return this->sequence_; }
+  // Bytes programmed to flash (headers included) and batch payload bytes.
+  uint64_t get_flash_bytes() const { return this->flash_bytes_; }
+  uint64_t get_payload_bytes() const { return this->payload_bytes_; }
+
+ protected:
+  // Read the header of `segment`; returns its sequence number, or 0 if the
+  // segment holds no valid header.
+  uint32_t read_header_(uint32_t segment);
+  // Erase the segment after the head and make it the new head.
+  bool advance_();
+  // Read the batch at `offset` in `segment` and advance `offset` past it.
+  // An `offset` of 0 starts at the first batch.
+  bool read_batch_(uint32_t segment, size_t &offset, uint8_t *data, size_t &len);
+
+  JournalStorage *storage_;
+  uint32_t num_segments_{0};
+  uint32_t head_{0};
+  uint32_t sequence_{0};
+  size_t write_offset_{0};
+  uint32_t erases_{0};
+  uint64_t flash_bytes_{0};
+  uint64_t payload_bytes_{0};
+  uint8_t scratch_[MAX_BATCH];
+};
+
+}  // namespace zmod4510
@@ -24,6 +24,10 @@
 
 #include <stdint.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
  * @brief Error code definitions
  */
@@ -31,7 +35,8 @@ typedef enum {
   ecSuccess  = 0,           /**< Operation completed successfully */
   ecHALError = 0x100        /**< Returned by sensor API if a HAL function failed. 
                              * Specific information about the error can be 
-                             * obtained using the function HAL_GetErrorInfo(). */
+                             * obtained using the functions HAL_GetErrorInfo()
+                             * and HAL_GetInterfaceErrorInfo(). */
 } GenericError_t;
 
 /**
@@ -59,7 +64,9 @@ typedef enum {
   heI2CReadMissing,      /**< Interface_t::i2cRead not provided */
   heI2CWriteMissing,     /**< Interface_t::i2cWrite not provided */
   heSleepMissing,        /**< Interface_t::msSleep not provided */
-  heResetMissing         /**< Interface_t::reset not provided */
+  heResetMissing,        /**< Interface_t::reset not provided */
+  heNoDeviceSlot,        /**< Too many devices bound to a sensor API wrapper */
+  heQueueFull            /**< Too many asynchronous operations pending */
 } HALError_t;
 
 
@@ -72,6 +79,26 @@ typedef enum {
 typedef int ( *I2CImpl_t ) ( void*, uint8_t, uint8_t*, int, uint8_t*, int );
 
 
+/**
+ * @brief Function type used for generation of error strings
+ * 
+ * Functions of this type may be passed to HAL_SetError() to generate
+ *  meaningful descriptions of error conditions.
+ * 
+ */
+typedef char const*  ( *ErrorStringGenerator_t ) ( int, int, char*, int );
+
+
+/**
+ * @brief Error information stored by HAL_SetError()
+ */
+typedef struct {
+  int                     error;      /**< error code */
+  int                     scope;      /**< scope (module) that raised the error */
+  ErrorStringGenerator_t  errStrFn;   /**< optional error string generator */
+} HALErrorInfo_t;
+
+
 /**
  * @brief A structure of pointers to hardware specific functions
  */
@@ -123,6 +150,14 @@ typedef struct {
    * Implementation must pulse the reset pin
    */
   int  ( *reset ) ( void*  handle );
+
+  /** Last error raised through this interface
+   * 
+   * Written by HAL_SetError() during calls made through HAL_I2CRead() and
+   *  HAL_I2CWrite(), read with HAL_GetInterfaceErrorInfo(). Initialization
+   *  functions clear it.
+   */
+  HALErrorInfo_t  lastError;
 } Interface_t;
 
 
@@ -164,15 +199,6 @@ int  HAL_Deinit ( Interface_t*  hal );
  */
 void HAL_HandleError ( int  errorCode, void const*  context );
 
-/**
- * @brief Function type used for generation of error strings
- * 
- * Functions of this type may be passed to HAL_SetError() to generate
- *  meaningful descriptions of error conditions.
- * 
- */
-typedef char const*  ( *ErrorStringGenerator_t ) ( int, int, char*, int );
-
 /**
  * @brief Function storing error information
  * 
@@ -183,8 +209,12 @@ typedef char const*  ( *ErrorStringGenerator_t ) ( int, int, char*, int );
  *  error has occurred.
  * 
  * Internally, this function stores the error code and the scope of the
- *  error (that is which module was generating the error) in a data
- *  structure. For all errors which do not have the scope esSensor, this
+ *  error (that is which module was generating the error) in the
+ *  ::Interface_t::lastError of the interface being called through
+ *  HAL_I2CRead() or HAL_I2CWrite(), so sensors on different interfaces keep
+ *  their errors apart even when one task drives them all. Errors raised
+ *  outside of such a call go to a record shared by the whole program. For
+ *  all errors which do not have the scope esSensor, this
  *  function will return the generic error code ecHALError. Error codes
  *  generated by the sensor are returned directly.
  * 
@@ -202,14 +232,53 @@ typedef char const*  ( *ErrorStringGenerator_t ) ( int, int, char*, int );
 int HAL_SetError ( int  error, int  scope, 
                    ErrorStringGenerator_t  errStrFn );
 
+/**
+ * @brief Store error information with an interface
+ * 
+ * Like HAL_SetError(), for code that holds the ::Interface_t the error
+ *  belongs to, such as a sensor driver checking the functions it needs.
+ * 
+ * @param hal     The interface the error belongs to
+ * @param error   An error code
+ * @param scope   The scope of the error (integer identifying a module)
+ * @param errStrFn  Optional error string generator, NULL if not used
+ */
+int HAL_SetInterfaceError ( Interface_t*  hal, int  error, int  scope,
+                            ErrorStringGenerator_t  errStrFn );
+
+/**
+ * @brief Read through an interface
+ * 
+ * Calls Interface_t::i2cRead, recording errors raised during the call in
+ *  the interface's Interface_t::lastError. If the call is made from within
+ *  another call through an interface, as wrapping interfaces do, an error
+ *  is copied to the outer interface as well.
+ * 
+ * @return  the return value of Interface_t::i2cRead
+ */
+int HAL_I2CRead ( Interface_t*  hal, uint8_t  slAddr, uint8_t*  wrData, int  wrSize,
+                  uint8_t*  rdData, int  rdSize );
+
+/**
+ * @brief Write through an interface
+ * 
+ * Like HAL_I2CRead(), for Interface_t::i2cWrite.
+ * 
+ * @return  the return value of Interface_t::i2cWrite
+ */
+int HAL_I2CWrite ( Interface_t*  hal, uint8_t  slAddr, uint8_t*  wrData1, int  wrSize1,
+                   uint8_t*  wrData2, int  wrSize2 );
+
 /**
  * @brief Get detailed information for last error
  * 
  * Use this function in the error handler to obtain information about the 
- *  last error code and which component generated it. In addition if 
- *  an error string generator function was provided during error generation,
- *  this function may return a text string, describing the error in more
- *  detail.
+ *  last error code raised by the calling thread and which component
+ *  generated it. Programs driving several interfaces should use
+ *  HAL_GetInterfaceErrorInfo() instead.
+ *  In addition if an error string generator function was provided during
+ *  error generation, this function may return a text string, describing the
+ *  error in more detail.
  * 
  *  @param error    Pointer to integer, where the error code is written
  *  @param scope    Pointer to integer, where the error scope (module that was
@@ -221,6 +290,22 @@ int HAL_SetError ( int  error, int  scope,
  */
 char const*  HAL_GetErrorInfo ( int*  error, int*  scope, char*  str, int  bufSize );
 
+/**
+ * @brief Get detailed information for the last error of an interface
+ * 
+ * Like HAL_GetErrorInfo(), for the last error raised through `hal`.
+ * 
+ *  @param hal      The interface to query
+ *  @param error    Pointer to integer, where the error code is written
+ *  @param scope    Pointer to integer, where the error scope is written
+ *  @param str      Pointer to string buffer, where error message is written.
+ *                  If no string information is required, pass NULL pointer.
+ *  @param bufSize  Size of the string buffer, pass 0 if not used
+ *  @return         Value passed in str
+ */
+char const*  HAL_GetInterfaceErrorInfo ( Interface_t const*  hal, int*  error, int*  scope,
+                                         char*  str, int  bufSize );
+
 /**
  * @brief Error string generator for HAL-scoped errors
  * 
@@ -235,5 +320,9 @@ char const*  HAL_GetErrorInfo ( int*  error, int*  scope, char*  str, int  bufSi
  */
 char const*  HAL_GetErrorString ( int  error, int  scope, char*  str, int  bufSize );
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* HAL_H */
 /** @} */
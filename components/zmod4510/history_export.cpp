@@ -0,0 +1,122 @@
+#include "history_export.h"
+#include "esphome/core/defines.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#ifdef USE_ZMOD4510_HISTORY_EXPORT
+
+namespace zmod4510 {
+
+static const char *const RESOLUTION_NAMES[SampleHistory::NUM_RESOLUTIONS] = {"raw", "minute", "hour", "day"};
+static const char *const CSV_HEADER = "start,count,no2_min,no2_mean,no2_max,o3_min,o3_mean,o3_max\n";
+
+static char *put_le(char *out, uint32_t value, uint8_t bytes) {
+  for (uint8_t i = 0; i < bytes; i++)
+    *out++ = char(value >> (8 * i));
+  return out;
+}
+
+const char *HistoryExport::get_content_type(Format format) {
+  return format == FORMAT_CSV ? "text/csv" : "application/octet-stream";
+}
+
+bool HistoryExport::parse_format(const char *name, Format &format) {
+  if (strcmp(name, "csv") == 0) {
+    format = FORMAT_CSV;
+  } else if (strcmp(name, "bin") == 0) {
+    format = FORMAT_BINARY;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool HistoryExport::parse_resolution(const char *name, SampleHistory::Resolution &resolution) {
+  for (uint8_t i = 0; i < SampleHistory::NUM_RESOLUTIONS; i++) {
+    if (strcmp(name, RESOLUTION_NAMES[i]) == 0) {
+      resolution = SampleHistory::Resolution(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool HistoryExport::fill_pending_(const SampleHistory &history) {
+  this->pending_pos_ = 0;
+  this->pending_len_ = 0;
+  if (!this->header_done_) {
+    this->header_done_ = true;
+    if (this->format_ == FORMAT_CSV) {
+      this->pending_len_ = strlen(CSV_HEADER);
+      memcpy(this->pending_, CSV_HEADER, this->pending_len_);
+    } else {
+      const char header[8] = {'Z', 'H', 1, char(this->resolution_), HistoryBucket::NUM_CHANNELS, BINARY_RECORD_SIZE,
+                              0, 0};
+      memcpy(this->pending_, header, sizeof(header));
+      this->pending_len_ = sizeof(header);
+    }
+    return true;
+  }
+  if (this->done_)
+    return false;
+
+  const HistoryBucket *bucket = history.find(this->resolution_, this->next_);
+  if (bucket == nullptr || bucket->start > this->to_) {
+    this->done_ = true;
+    return false;
+  }
+  if (bucket->start == UINT32_MAX) {
+    this->done_ = true;
+  } else {
+    this->next_ = bucket->start + 1;
+  }
+  this->entries_++;
+
+  if (this->format_ == FORMAT_CSV) {
+    // snprintf returns the length it wanted, which for values like 1e30 runs
+    // past the buffer; clamp after every call and keep the last byte for the
+    // newline. A clamped line is cut short, but stays a line.
+    const size_t limit = sizeof(this->pending_) - 1;
+    int n = snprintf(this->pending_, limit, "%u,%u", unsigned(bucket->start), unsigned(bucket->count));
+    size_t len = n < 0 ? 0 : std::min(size_t(n), limit - 1);
+    for (uint8_t c = 0; c < HistoryBucket::NUM_CHANNELS && len < limit - 1; c++) {
+      n = snprintf(this->pending_ + len, limit - len, ",%.2f,%.2f,%.2f", bucket->min[c], bucket->mean[c],
+                   bucket->max[c]);
+      len = n < 0 ? len : std::min(len + size_t(n), limit - 1);
+    }
+    this->pending_[len++] = '\n';
+    this->pending_len_ = len;
+  } else {
+    char *out = put_le(this->pending_, bucket->start, 4);
+    out = put_le(out, bucket->count, 2);
+    for (uint8_t c = 0; c < HistoryBucket::NUM_CHANNELS; c++) {
+      const float values[3] = {bucket->min[c], bucket->mean[c], bucket->max[c]};
+      for (float value : values) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        out = put_le(out, bits, 4);
+      }
+    }
+    this->pending_len_ = out - this->pending_;
+  }
+  return true;
+}
+
+size_t HistoryExport::read(const SampleHistory &history, uint8_t *buffer, size_t max_len) {
+  size_t written = 0;
+  while (written < max_len) {
+    if (this->pending_pos_ == this->pending_len_ && !this->fill_pending_(history))
+      break;
+    size_t n = this->pending_len_ - this->pending_pos_;
+    if (n > max_len - written)
+      n = max_len - written;
+    memcpy(buffer + written, this->pending_ + this->pending_pos_, n);
+    this->pending_pos_ += n;
+    written += n;
+  }
+  return written;
+}
+
+}  // namespace zmod4510
+
+#endif  // USE_ZMOD4510_HISTORY_EXPORT
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "sample_history.h"
+
+namespace zmod4510 {
+
+// Incremental serializer for SampleHistory. Each read() fills the caller's
+// buffer with the next part of the export, so the response never exists in
+// RAM as a whole. The position is kept as a timestamp rather than an index,
+// which keeps the export consistent while new samples rotate the rings.
+//
+// CSV: a header line, then one line per entry.
+// Binary: an 8-byte header ("ZH", version, resolution, channels, record size,
+// 2 reserved) followed by packed little-endian records: start (u32), count
+// (u16), then min/mean/max (f32) for each channel.
+class HistoryExport {
+ public:
+  enum Format : uint8_t { FORMAT_CSV = 0, FORMAT_BINARY };
+  static const uint8_t BINARY_RECORD_SIZE = 6 + 3 * 4 * HistoryBucket::NUM_CHANNELS;
+
+  HistoryExport(Format format, SampleHistory::Resolution resolution, uint32_t from, uint32_t to)
+      : format_(format), resolution_(resolution), next_(from), to_(to) {}
+
+  // Write up to `max_len` bytes; returns 0 once the export is complete.
+  size_t read(const SampleHistory &history, uint8_t *buffer, size_t max_len);
+  bool is_done() const { return this->done_ && this->pending_pos_ == this->pending_len_; }
+  uint32_t get_entries() const { return this->entries_; }
+
+  static const char *get_content_type(Format format);
+  // Parse "csv"/"bin" and "raw"/"minute"/"hour"/"day"; return false if unknown.
+  static bool parse_format(const char *name, Format &format);
+  static bool parse_resolution(const char *name, SampleHistory::Resolution &resolution);
+
+ protected:
+  // Render the header or the next entry into pending_; false when done.
+  bool fill_pending_(const SampleHistory &history);
+
+  Format format_;
+  SampleHistory::Resolution resolution_;
+  uint32_t next_;
+  uint32_t to_;
+  bool header_done_{false};
+  bool done_{false};
+  uint32_t entries_{0};
+  // One rendered entry that did not fit into the caller's buffer yet.
+  char pending_[160];
+  size_t pending_len_{0};
+  size_t pending_pos_{0};
+};
+
+}  // namespace zmod4510
@@ -0,0 +1,47 @@
+#include "history_web_handler.h"
+#ifdef USE_ZMOD4510_EXPORT_WEB
+
+#include <cstdlib>
+#include <memory>
+#include "zmod4510_component.h"
+
+namespace zmod4510 {
+
+bool HistoryWebHandler::canHandle(AsyncWebServerRequest *request) {
+  return request->method() == HTTP_GET && request->url() == "/zmod4510/history";
+}
+
+void HistoryWebHandler::handleRequest(AsyncWebServerRequest *request) {
+  HistoryExport::Format format = HistoryExport::FORMAT_CSV;
+  SampleHistory::Resolution resolution = SampleHistory::MINUTE;
+  uint32_t from = 0;
+  uint32_t to = UINT32_MAX;
+  if ((request->hasParam("format") &&
+       !HistoryExport::parse_format(request->getParam("format")->value().c_str(), format)) ||
+      (request->hasParam("resolution") &&
+       !HistoryExport::parse_resolution(request->getParam("resolution")->value().c_str(), resolution))) {
+    request->send(400, "text/plain", "format must be csv|bin, resolution raw|minute|hour|day");
+    return;
+  }
+  if (request->hasParam("from")) {
+    from = strtoul(request->getParam("from")->value().c_str(), nullptr, 10);
+  }
+  if (request->hasParam("to")) {
+    to = strtoul(request->getParam("to")->value().c_str(), nullptr, 10);
+  }
+
+  // The export state lives as long as the response; each chunk is rendered
+  // straight into the web server's send buffer.
+  std::shared_ptr<HistoryExport> state = std::make_shared<HistoryExport>(format, resolution, from, to);
+  ZMOD4510 *parent = this->parent_;
+  AsyncWebServerResponse *response = request->beginChunkedResponse(
+      HistoryExport::get_content_type(format),
+      [parent, state](uint8_t *buffer, size_t max_len, size_t index) -> size_t {
+        return parent->read_history_export(*state, buffer, max_len);
+      });
+  request->send(response);
+}
+
+}  // namespace zmod4510
+
+#endif  // USE_ZMOD4510_EXPORT_WEB
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+#ifdef USE_ZMOD4510_EXPORT_WEB
+
+#include "esphome/components/web_server_base/web_server_base.h"
+
+namespace zmod4510 {
+
+class ZMOD4510;
+
+// Streams the sample history as a chunked HTTP response, which only the
+// Arduino web server (ESPAsyncWebServer) provides:
+//   GET /zmod4510/history?format=csv|bin&resolution=raw|minute|hour|day&from=<s>&to=<s>
+class HistoryWebHandler : public AsyncWebHandler {
+ public:
+  explicit HistoryWebHandler(ZMOD4510 *parent) : parent_(parent) {}
+
+  bool canHandle(AsyncWebServerRequest *request) override;
+  void handleRequest(AsyncWebServerRequest *request) override;
+
+ protected:
+  ZMOD4510 *parent_;
+};
+
+}  // namespace zmod4510
+
+#endif  // USE_ZMOD4510_EXPORT_WEB
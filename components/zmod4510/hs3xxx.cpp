@@ -21,10 +21,14 @@
 
 static char const*
 _GetErrorString ( int  error, int  scope,  char*  buf, int  bufLen ) {
+#ifdef HAL_NO_ERROR_STRINGS
+  snprintf ( buf, bufLen, "HS3xxx Error: %d", error );
+#else
   if ( error == hteStaleData )
     snprintf ( buf, bufLen, "HS3xxx Error: Stale data - new data is not yet ready for readout." );
   else
     snprintf ( buf, bufLen, "HS3xxx Error: Unkown error code %d", error );
+#endif
   
   return buf;
 }
@@ -39,15 +43,15 @@ HS3xxx_Init ( HSxxxx_t*  sensor, Interface_t*  hal ) {
   sensor -> i2cAddress = 0;
 
   /* Ensure the HAL is appropriately initialized. */
-  if ( !hal -> i2cWrite ) return HAL_SetError ( heI2CWriteMissing, 0x44, HAL_GetErrorString );
-  if ( !hal -> i2cRead )  return HAL_SetError ( heI2CReadMissing,  0x44, HAL_GetErrorString );
+  if ( !hal -> i2cWrite ) return HAL_SetInterfaceError ( hal, heI2CWriteMissing, 0x44, HAL_GetErrorString );
+  if ( !hal -> i2cRead )  return HAL_SetInterfaceError ( hal, heI2CReadMissing,  0x44, HAL_GetErrorString );
 
   /* HAL is appropriate - try to access sensor */
   sensor -> i2cAddress = 0x44;
   sensor -> interface = hal;
-  err = sensor -> interface -> i2cWrite ( sensor -> interface -> handle, 
-                                          sensor -> i2cAddress,
-                                          dummy, 0, dummy, 0 );
+  err = HAL_I2CWrite ( sensor -> interface, 
+                       sensor -> i2cAddress,
+                       dummy, 0, dummy, 0 );
 
   if ( err )
     sensor -> interface = NULL;
@@ -57,7 +61,7 @@ HS3xxx_Init ( HSxxxx_t*  sensor, Interface_t*  hal ) {
 
 int
 HS3xxx_ReadID ( HSxxxx_t*  sensor, uint32_t*  id ) {
-  return  HAL_SetError ( heNotImplemented, 0x44, HAL_GetErrorString );
+  return  HAL_SetInterfaceError ( sensor -> interface, heNotImplemented, 0x44, HAL_GetErrorString );
 }
 
 int
@@ -65,7 +69,7 @@ HS3xxx_Measure ( HSxxxx_t*  sensor, HSxxxx_Results_t*  results ) {
   int error;
 
   if ( !sensor -> interface -> msSleep ) 
-    return HAL_SetError ( heSleepMissing, 0x44, HAL_GetErrorString );
+    return HAL_SetInterfaceError ( sensor -> interface, heSleepMissing, 0x44, HAL_GetErrorString );
 
   error = HS3xxx_MeasureStart ( sensor );
   if ( error )
@@ -80,9 +84,9 @@ int
 HS3xxx_MeasureStart ( HSxxxx_t*  sensor ) {
   /* Issue meausurement request (write without data). */
   uint8_t  dummy;
-  return sensor -> interface -> i2cWrite ( sensor -> interface -> handle, 
-                                           sensor -> i2cAddress,
-                                           &dummy, 0, NULL, 0 );
+  return HAL_I2CWrite ( sensor -> interface, 
+                        sensor -> i2cAddress,
+                        &dummy, 0, NULL, 0 );
 }
 
 int
@@ -90,14 +94,14 @@ HS3xxx_MeasureRead ( HSxxxx_t*  sensor, HSxxxx_Results_t*  results ) {
   int  error;
   uint8_t  buf [ 4 ];
 
-  error = sensor -> interface -> i2cRead ( sensor -> interface -> handle,
-                                           sensor -> i2cAddress,
-                                           NULL, 0, buf, 4 );
+  error = HAL_I2CRead ( sensor -> interface,
+                        sensor -> i2cAddress,
+                        NULL, 0, buf, 4 );
   if ( error )
     return error;
 
   if ( buf [ 3 ] & 0x01 ) 
-    return HAL_SetError ( hteStaleData, 0x44, _GetErrorString );
+    return HAL_SetInterfaceError ( sensor -> interface, hteStaleData, 0x44, _GetErrorString );
 
   float  rawHumidity    = ( ( buf [ 0 ] & 0x3f ) << 8 ) | buf [ 1 ];
   float  rawTemperature = ( ( buf [ 2 ] << 8 ) | ( buf [ 3 ] & 0xfc ) ) >> 2;
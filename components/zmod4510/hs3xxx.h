@@ -22,6 +22,10 @@
 #include <stdbool.h>
 #include "hsxxxx.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
  * @brief Error code definitions specific for the HS3xxx API
  */
@@ -111,6 +115,10 @@ int
 HS3xxx_MeasureRead ( HSxxxx_t*  sensor, HSxxxx_Results_t*  results );
 
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* HS3XXX_H */
 
 /** @} */
@@ -22,6 +22,10 @@
 #include <stdbool.h>
 #include "hsxxxx.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
  * @brief Error code definitions specific for the HS4xxx API
  */
@@ -142,6 +146,10 @@ HS4xxx_MeasureStart ( HSxxxx_t*  sensor );
 int
 HS4xxx_MeasureRead ( HSxxxx_t*  sensor, HSxxxx_Results_t*  results );
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* HS4XXX_H */
 
 /** @} */
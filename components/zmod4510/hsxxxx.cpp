@@ -55,6 +55,48 @@ HSxxxx_Measure ( HSxxxx_t*  sensor, HSxxxx_Results_t*  results ) {
 }
 
 
+int
+HSxxxx_MeasureStart ( HSxxxx_t*  sensor ) {
+  int err = 0;
+
+  switch ( sensor -> i2cAddress ) {
+  case 0x54:
+    err = HS4xxx_MeasureStart ( sensor );
+    break;
+
+  case 0x44:
+    err = HS3xxx_MeasureStart ( sensor );
+    break;
+
+  default:
+    err = 42;
+  }
+
+  return err;
+}
+
+
+int
+HSxxxx_MeasureRead ( HSxxxx_t*  sensor, HSxxxx_Results_t*  results ) {
+  int err = 0;
+
+  switch ( sensor -> i2cAddress ) {
+  case 0x54:
+    err = HS4xxx_MeasureRead ( sensor, results );
+    break;
+
+  case 0x44:
+    err = HS3xxx_MeasureRead ( sensor, results );
+    break;
+
+  default:
+    err = 42;
+  }
+
+  return err;
+}
+
+
 char const*
 HSxxxx_Name ( HSxxxx_t*  sensor ) {
   switch ( sensor -> i2cAddress ) {
@@ -22,6 +22,10 @@
 #include <stdbool.h>
 #include "hal.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
  * @brief Data structure holding humidity/temperature results
  */
@@ -76,6 +80,33 @@ HSxxxx_Init ( HSxxxx_t*  sensor, Interface_t*  hal );
 int
 HSxxxx_Measure ( HSxxxx_t*  sensor, HSxxxx_Results_t*  results );
 
+/**
+ * @brief  Start a temperature/humidity measurement
+ * 
+ * Non-blocking counterpart of HSxxxx_Measure(). The result can be read using
+ *  HSxxxx_MeasureRead() once HSxxxx_MeasurementDuration() milliseconds have
+ *  passed.
+ * 
+ * @param sensor   Pointer to the sensor object to be used.
+ * @return int     Error code
+ * @retval 0       On success
+ * @retval other   On error
+ */
+int
+HSxxxx_MeasureStart ( HSxxxx_t*  sensor );
+
+/**
+ * @brief  Read the result of a measurement started by HSxxxx_MeasureStart()
+ * 
+ * @param sensor   Pointer to the sensor object to be used.
+ * @param results  Pointer to data structure for result storage.
+ * @return int     Error code
+ * @retval 0       On success
+ * @retval other   On error
+ */
+int
+HSxxxx_MeasureRead ( HSxxxx_t*  sensor, HSxxxx_Results_t*  results );
+
 /**
  * @brief  Return the temperature/humidity sensor type name
  * 
@@ -111,6 +142,10 @@ HSxxxx_MeasurementDuration ( HSxxxx_t*  sensor ) {
   return 0;
 }
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* HSXXXX_H */
 
 /** @} */
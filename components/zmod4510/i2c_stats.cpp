@@ -0,0 +1,116 @@
+#include "i2c_stats.h"
+#include "esphome/core/defines.h"
+#ifdef USE_ZMOD4510_I2C_STATS
+
+namespace zmod4510 {
+
+void I2CStats::wrap(Interface_t *inner, Interface_t *wrapped, uint32_t (*clock_us)()) {
+  this->inner_ = inner;
+  this->clock_us_ = clock_us;
+  wrapped->handle = this;
+  wrapped->i2cRead = inner->i2cRead ? i2c_read_ : nullptr;
+  wrapped->i2cWrite = inner->i2cWrite ? i2c_write_ : nullptr;
+  wrapped->msSleep = inner->msSleep;
+  wrapped->reset = inner->reset ? reset_ : nullptr;
+  wrapped->lastError = HALErrorInfo_t{};
+}
+
+void I2CStats::reset() {
+  for (auto &slot : this->slots_) {
+    slot = Slot{};
+  }
+  this->num_slots_ = 0;
+  this->transactions_ = 0;
+  this->errors_ = 0;
+  this->bytes_ = 0;
+  this->bus_time_us_ = 0;
+  for (auto &count : this->error_codes_) {
+    count = 0;
+  }
+}
+
+int I2CStats::i2c_read_(void *handle, uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data,
+                        int rd_size) {
+  auto *self = static_cast<I2CStats *>(handle);
+  uint32_t start = self->clock_us_();
+  int ret = HAL_I2CRead(self->inner_, sl_addr, wr_data, wr_size, rd_data, rd_size);
+  uint32_t elapsed = self->clock_us_() - start;
+  self->record_(sl_addr, wr_size ? wr_data[0] : NO_REGISTER, true, wr_size + rd_size, elapsed, ret);
+  return ret;
+}
+
+int I2CStats::i2c_write_(void *handle, uint8_t sl_addr, uint8_t *wr_data1, int wr_size1, uint8_t *wr_data2,
+                         int wr_size2) {
+  auto *self = static_cast<I2CStats *>(handle);
+  uint32_t start = self->clock_us_();
+  int ret = HAL_I2CWrite(self->inner_, sl_addr, wr_data1, wr_size1, wr_data2, wr_size2);
+  uint32_t elapsed = self->clock_us_() - start;
+  self->record_(sl_addr, wr_size1 ? wr_data1[0] : NO_REGISTER, false, wr_size1 + wr_size2, elapsed, ret);
+  return ret;
+}
+
+int I2CStats::reset_(void *handle) {
+  auto *self = static_cast<I2CStats *>(handle);
+  return self->inner_->reset(self->inner_->handle);
+}
+
+void I2CStats::record_(uint8_t slave, uint16_t reg, bool read, int bytes, uint32_t elapsed_us, int ret) {
+  Slot *slot = nullptr;
+  for (uint8_t i = 0; i < this->num_slots_; i++) {
+    if (this->slots_[i].slave == slave && this->slots_[i].reg == reg) {
+      slot = &this->slots_[i];
+      break;
+    }
+  }
+  if (slot == nullptr) {
+    if (this->num_slots_ < MAX_SLOTS - 1) {
+      slot = &this->slots_[this->num_slots_++];
+      slot->slave = slave;
+      slot->reg = reg;
+    } else {
+      // Table full: the reserved last slot aggregates all remaining addresses.
+      slot = &this->slots_[MAX_SLOTS - 1];
+      if (this->num_slots_ < MAX_SLOTS) {
+        this->num_slots_ = MAX_SLOTS;
+        slot->slave = OTHER_SLAVE;
+        slot->reg = NO_REGISTER;
+      }
+    }
+  }
+
+  if (read) {
+    slot->reads++;
+  } else {
+    slot->writes++;
+  }
+  slot->bytes += bytes;
+  slot->total_us += elapsed_us;
+  if (elapsed_us > slot->max_us) {
+    slot->max_us = elapsed_us;
+  }
+  uint8_t bucket = 0;
+  while (bucket + 1 < NUM_LATENCY_BUCKETS && elapsed_us >= get_latency_bound(bucket)) {
+    bucket++;
+  }
+  slot->latency[bucket]++;
+
+  this->transactions_++;
+  this->bytes_ += bytes;
+  this->bus_time_us_ += elapsed_us;
+
+  if (ret != ecSuccess) {
+    slot->errors++;
+    this->errors_++;
+    // The HAL returns ecHALError for bus errors; the bus specific code is kept
+    // with the interface that raised it.
+    int error = ret, scope;
+    if (ret == ecHALError) {
+      HAL_GetInterfaceErrorInfo(this->inner_, &error, &scope, nullptr, 0);
+    }
+    this->error_codes_[(error > 0 && error < NUM_ERROR_CODES) ? error : 0]++;
+  }
+}
+
+}  // namespace zmod4510
+
+#endif  // USE_ZMOD4510_I2C_STATS
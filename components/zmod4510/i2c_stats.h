@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+
+extern "C" {
+  #include "hal.h"
+}
+
+namespace zmod4510 {
+
+// Collects per-transaction I2C statistics by sitting between the drivers and
+// an Interface_t. All storage is fixed; transactions are keyed by slave and
+// register address (the first written byte). Once MAX_SLOTS - 1 keys are in
+// use, the last slot, keyed OTHER_SLAVE/NO_REGISTER, takes all the others.
+class I2CStats {
+ public:
+  static const uint8_t MAX_SLOTS = 16;
+  // Latency buckets double from 128 us; the last one is open-ended.
+  static const uint8_t NUM_LATENCY_BUCKETS = 8;
+  // HAL error codes 1..6 are counted individually, everything else in slot 0.
+  static const uint8_t NUM_ERROR_CODES = 7;
+  static const uint16_t NO_REGISTER = 0x100;
+  // Not a 7-bit address.
+  static const uint8_t OTHER_SLAVE = 0xFF;
+
+  struct Slot {
+    uint8_t slave;
+    uint16_t reg;
+    uint32_t reads;
+    uint32_t writes;
+    uint32_t errors;
+    uint32_t bytes;
+    uint32_t total_us;
+    uint32_t max_us;
+    uint32_t latency[NUM_LATENCY_BUCKETS];
+  };
+
+  // Route `wrapped` through `inner`. `clock_us` provides a microsecond clock.
+  void wrap(Interface_t *inner, Interface_t *wrapped, uint32_t (*clock_us)());
+  void reset();
+
+  uint8_t get_slot_count() const { return this->num_slots_; }
+  const Slot &get_slot(uint8_t i) const { return this->slots_[i]; }
+  uint32_t get_transactions() const { return this->transactions_; }
+  uint32_t get_errors() const { return this->errors_; }
+  uint32_t get_bytes() const { return this->bytes_; }
+  uint32_t get_bus_time_us() const { return this->bus_time_us_; }
+  uint32_t get_error_count(uint8_t code) const { return this->error_codes_[code]; }
+  // Upper latency bound of bucket `i` in us; 0 for the open-ended last bucket.
+  static uint32_t get_latency_bound(uint8_t i) { return i + 1 < NUM_LATENCY_BUCKETS ? 128u << i : 0; }
+
+ protected:
+  static int i2c_read_(void *handle, uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data, int rd_size);
+  static int i2c_write_(void *handle, uint8_t sl_addr, uint8_t *wr_data1, int wr_size1, uint8_t *wr_data2,
+                        int wr_size2);
+  static int reset_(void *handle);
+
+  void record_(uint8_t slave, uint16_t reg, bool read, int bytes, uint32_t elapsed_us, int ret);
+
+  Interface_t *inner_{nullptr};
+  uint32_t (*clock_us_)(){nullptr};
+
+  Slot slots_[MAX_SLOTS]{};
+  uint8_t num_slots_{0};
+  uint32_t transactions_{0};
+  uint32_t errors_{0};
+  uint32_t bytes_{0};
+  uint32_t bus_time_us_{0};
+  uint32_t error_codes_[NUM_ERROR_CODES]{};
+};
+
+}  // namespace zmod4510
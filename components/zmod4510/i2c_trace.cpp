@@ -0,0 +1,277 @@
+#include "i2c_trace.h"
+#include "esphome/core/defines.h"
+#include <cstring>
+#ifdef USE_ZMOD4510_I2C_TRACE
+
+namespace zmod4510 {
+
+using namespace i2c_trace;
+
+static uint8_t *put_varint(uint8_t *out, uint32_t value) {
+  while (value >= 0x80) {
+    *out++ = uint8_t(value) | 0x80;
+    value >>= 7;
+  }
+  *out++ = uint8_t(value);
+  return out;
+}
+
+static bool get_varint(const uint8_t *data, size_t size, size_t &pos, uint32_t &value) {
+  value = 0;
+  for (uint8_t shift = 0; shift < 35 && pos < size; shift += 7) {
+    uint8_t byte = data[pos++];
+    value |= uint32_t(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+      return true;
+  }
+  return false;
+}
+
+// memcpy()/memcmp() on empty buffers, which the drivers pass as nullptr.
+static uint8_t *put_bytes(uint8_t *out, const uint8_t *data, int size) {
+  if (size > 0)
+    memcpy(out, data, size);
+  return out + size;
+}
+
+static bool same_bytes(const uint8_t *a, const uint8_t *b, int size) { return size == 0 || memcmp(a, b, size) == 0; }
+
+static int8_t clamp_ret(int ret) { return ret < -128 ? -128 : ret > 127 ? 127 : int8_t(ret); }
+
+I2CTraceRecorder *I2CTraceRecorder::active_ = nullptr;
+
+void I2CTraceRecorder::wrap(Interface_t *inner, Interface_t *wrapped, uint32_t (*clock_us)(), uint8_t *buffer,
+                            size_t capacity) {
+  this->inner_ = inner;
+  this->clock_us_ = clock_us;
+  this->last_us_ = clock_us();
+  this->buffer_ = buffer;
+  this->capacity_ = capacity;
+  this->size_ = 0;
+  this->events_ = 0;
+  this->full_ = false;
+  active_ = this;
+  wrapped->handle = this;
+  wrapped->i2cRead = inner->i2cRead ? i2c_read_ : nullptr;
+  wrapped->i2cWrite = inner->i2cWrite ? i2c_write_ : nullptr;
+  wrapped->msSleep = inner->msSleep ? ms_sleep_ : nullptr;
+  wrapped->reset = inner->reset ? reset_ : nullptr;
+  wrapped->lastError = HALErrorInfo_t{};
+}
+
+void I2CTraceRecorder::record_(uint8_t type, uint8_t slave, int ret, const uint8_t *a, int a_size, const uint8_t *b,
+                               int b_size, uint32_t sleep_ms) {
+  if (this->full_)
+    return;
+  if (a_size > 255 || b_size > 255 || this->size_ + MAX_EVENT_SIZE > this->capacity_) {
+    this->full_ = true;
+    return;
+  }
+  uint32_t now = this->clock_us_();
+  uint8_t *out = this->buffer_ + this->size_;
+  *out++ = type;
+  *out++ = slave;
+  *out++ = uint8_t(clamp_ret(ret));
+  out = put_varint(out, now - this->last_us_);
+  this->last_us_ = now;
+  switch (type) {
+    case EVENT_READ:
+      *out++ = uint8_t(a_size);
+      out = put_bytes(out, a, a_size);
+      *out++ = uint8_t(b_size);
+      out = put_bytes(out, b, b_size);
+      break;
+    case EVENT_WRITE:
+      *out++ = uint8_t(a_size);
+      *out++ = uint8_t(b_size);
+      out = put_bytes(out, a, a_size);
+      out = put_bytes(out, b, b_size);
+      break;
+    case EVENT_SLEEP:
+      out = put_varint(out, sleep_ms);
+      break;
+    default:
+      break;
+  }
+  this->size_ = out - this->buffer_;
+  this->events_++;
+}
+
+int I2CTraceRecorder::i2c_read_(void *handle, uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data,
+                                int rd_size) {
+  auto *self = static_cast<I2CTraceRecorder *>(handle);
+  int ret = HAL_I2CRead(self->inner_, sl_addr, wr_data, wr_size, rd_data, rd_size);
+  self->record_(EVENT_READ, sl_addr, ret, wr_data, wr_size, rd_data, rd_size, 0);
+  return ret;
+}
+
+int I2CTraceRecorder::i2c_write_(void *handle, uint8_t sl_addr, uint8_t *wr_data1, int wr_size1, uint8_t *wr_data2,
+                                 int wr_size2) {
+  auto *self = static_cast<I2CTraceRecorder *>(handle);
+  int ret = HAL_I2CWrite(self->inner_, sl_addr, wr_data1, wr_size1, wr_data2, wr_size2);
+  self->record_(EVENT_WRITE, sl_addr, ret, wr_data1, wr_size1, wr_data2, wr_size2, 0);
+  return ret;
+}
+
+void I2CTraceRecorder::ms_sleep_(uint32_t ms) {
+  I2CTraceRecorder *self = active_;
+  self->record_(EVENT_SLEEP, 0, 0, nullptr, 0, nullptr, 0, ms);
+  self->inner_->msSleep(ms);
+}
+
+int I2CTraceRecorder::reset_(void *handle) {
+  auto *self = static_cast<I2CTraceRecorder *>(handle);
+  int ret = self->inner_->reset(self->inner_->handle);
+  self->record_(EVENT_RESET, 0, ret, nullptr, 0, nullptr, 0, 0);
+  return ret;
+}
+
+I2CTraceReplay *I2CTraceReplay::active_ = nullptr;
+
+void I2CTraceReplay::init(Interface_t *hal, const uint8_t *trace, size_t size) {
+  this->trace_ = trace;
+  this->size_ = size;
+  this->pos_ = 0;
+  this->events_ = 0;
+  this->recorded_us_ = 0;
+  this->done_ = false;
+  this->diverged_ = false;
+  this->divergence_ = "";
+  this->filter_ = false;
+  active_ = this;
+  hal->handle = this;
+  hal->i2cRead = i2c_read_;
+  hal->i2cWrite = i2c_write_;
+  hal->msSleep = ms_sleep_;
+  hal->reset = reset_;
+  hal->lastError = HALErrorInfo_t{};
+}
+
+int I2CTraceReplay::diverge_(const char *reason) {
+  if (!this->diverged_) {
+    this->diverged_ = true;
+    this->divergence_ = reason;
+  }
+  return ecHALError;
+}
+
+bool I2CTraceReplay::decode_(size_t &pos, Event &event) const {
+  if (pos + 3 > this->size_)
+    return false;
+  event.type = this->trace_[pos++];
+  event.slave = this->trace_[pos++];
+  event.ret = int8_t(this->trace_[pos++]);
+  event.sleep_ms = 0;
+  event.a_size = 0;
+  event.b_size = 0;
+  if (!get_varint(this->trace_, this->size_, pos, event.delta_us))
+    return false;
+  switch (event.type) {
+    case EVENT_READ:
+      if (pos >= this->size_)
+        return false;
+      event.a_size = this->trace_[pos++];
+      event.a = this->trace_ + pos;
+      pos += event.a_size;
+      if (pos >= this->size_)
+        return false;
+      event.b_size = this->trace_[pos++];
+      event.b = this->trace_ + pos;
+      pos += event.b_size;
+      break;
+    case EVENT_WRITE:
+      if (pos + 2 > this->size_)
+        return false;
+      event.a_size = this->trace_[pos++];
+      event.b_size = this->trace_[pos++];
+      event.a = this->trace_ + pos;
+      event.b = event.a + event.a_size;
+      pos += event.a_size + event.b_size;
+      break;
+    case EVENT_SLEEP:
+      if (!get_varint(this->trace_, this->size_, pos, event.sleep_ms))
+        return false;
+      break;
+    case EVENT_RESET:
+      break;
+    default:
+      return false;
+  }
+  return pos <= this->size_;
+}
+
+bool I2CTraceReplay::next_(uint8_t type, uint8_t slave, Event &event) {
+  if (this->diverged_ || this->done_)
+    return false;
+  for (;;) {
+    if (this->pos_ >= this->size_) {
+      this->done_ = true;
+      return false;
+    }
+    size_t pos = this->pos_;
+    if (!this->decode_(pos, event)) {
+      this->diverge_("corrupt trace");
+      return false;
+    }
+    if (this->filter_) {
+      bool other_device = (event.type == EVENT_READ || event.type == EVENT_WRITE) && event.slave != this->filter_slave_;
+      if (type == EVENT_SLEEP && event.type != EVENT_SLEEP && !other_device)
+        return false;  // Sleep of this device that was not recorded here.
+      if (other_device || (event.type == EVENT_SLEEP && type != EVENT_SLEEP)) {
+        this->pos_ = pos;
+        this->recorded_us_ += event.delta_us;
+        continue;
+      }
+    }
+    if (event.type != type || event.slave != slave) {
+      this->diverge_("unexpected call");
+      return false;
+    }
+    this->pos_ = pos;
+    this->events_++;
+    this->recorded_us_ += event.delta_us;
+    return true;
+  }
+}
+
+int I2CTraceReplay::i2c_read_(void *handle, uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data,
+                              int rd_size) {
+  auto *self = static_cast<I2CTraceReplay *>(handle);
+  Event event;
+  if (!self->next_(EVENT_READ, sl_addr, event))
+    return ecHALError;
+  if (event.a_size != wr_size || !same_bytes(event.a, wr_data, wr_size) || event.b_size != rd_size)
+    return self->diverge_("read differs");
+  put_bytes(rd_data, event.b, rd_size);
+  return event.ret;
+}
+
+int I2CTraceReplay::i2c_write_(void *handle, uint8_t sl_addr, uint8_t *wr_data1, int wr_size1, uint8_t *wr_data2,
+                               int wr_size2) {
+  auto *self = static_cast<I2CTraceReplay *>(handle);
+  Event event;
+  if (!self->next_(EVENT_WRITE, sl_addr, event))
+    return ecHALError;
+  if (event.a_size != wr_size1 || event.b_size != wr_size2 || !same_bytes(event.a, wr_data1, wr_size1) ||
+      !same_bytes(event.b, wr_data2, wr_size2))
+    return self->diverge_("write differs");
+  return event.ret;
+}
+
+void I2CTraceReplay::ms_sleep_(uint32_t ms) {
+  Event event;
+  if (active_->next_(EVENT_SLEEP, 0, event) && event.sleep_ms != ms && !active_->filter_)
+    active_->diverge_("sleep differs");
+}
+
+int I2CTraceReplay::reset_(void *handle) {
+  auto *self = static_cast<I2CTraceReplay *>(handle);
+  Event event;
+  if (!self->next_(EVENT_RESET, 0, event))
+    return ecHALError;
+  return event.ret;
+}
+
+}  // namespace zmod4510
+
+#endif  // USE_ZMOD4510_I2C_TRACE
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+extern "C" {
+  #include "hal.h"
+}
+
+namespace zmod4510 {
+
+// Binary I2C trace. Every call through the interface becomes one event:
+//   type (u8), slave (u8), result (i8), time since the previous event in us
+//   (varint, taken when the call returns), then per type:
+//   READ:  write length (u8), written bytes, read length (u8), bytes read
+//   WRITE: length 1 (u8), length 2 (u8), bytes of both buffers
+//   SLEEP: milliseconds (varint)
+//   RESET: nothing
+namespace i2c_trace {
+enum EventType : uint8_t { EVENT_READ = 1, EVENT_WRITE, EVENT_SLEEP, EVENT_RESET };
+static const size_t MAX_EVENT_SIZE = 3 + 5 + 2 + 2 * 255;
+}  // namespace i2c_trace
+
+// Records all traffic of an Interface_t into a fixed buffer. Recording stops
+// when the buffer is full, so a capture always starts at boot, which is what
+// a replay needs to rebuild the driver state.
+//
+// Interface_t::msSleep carries no handle, so sleeps are attributed to the
+// most recently wrapped recorder; only one recorder can be active.
+class I2CTraceRecorder {
+ public:
+  // Route `wrapped` through `inner` and record into `buffer`.
+  void wrap(Interface_t *inner, Interface_t *wrapped, uint32_t (*clock_us)(), uint8_t *buffer, size_t capacity);
+
+  const uint8_t *get_data() const { return this->buffer_; }
+  size_t get_size() const { return this->size_; }
+  uint32_t get_events() const { return this->events_; }
+  bool is_full() const { return this->full_; }
+
+ protected:
+  static int i2c_read_(void *handle, uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data, int rd_size);
+  static int i2c_write_(void *handle, uint8_t sl_addr, uint8_t *wr_data1, int wr_size1, uint8_t *wr_data2,
+                        int wr_size2);
+  static void ms_sleep_(uint32_t ms);
+  static int reset_(void *handle);
+
+  // Append one event; `a`/`b` are the type-specific payload parts.
+  void record_(uint8_t type, uint8_t slave, int ret, const uint8_t *a, int a_size, const uint8_t *b, int b_size,
+               uint32_t sleep_ms);
+
+  static I2CTraceRecorder *active_;
+
+  Interface_t *inner_{nullptr};
+  uint32_t (*clock_us_)(){nullptr};
+  uint32_t last_us_{0};
+  uint8_t *buffer_{nullptr};
+  size_t capacity_{0};
+  size_t size_{0};
+  uint32_t events_{0};
+  bool full_{false};
+};
+
+// Interface_t backend that answers from a recorded trace: reads return the
+// recorded bytes and results, writes are checked against the recording, and
+// sleeps return immediately. The first deviation from the recorded call
+// sequence is kept for diagnosis; from then on all calls fail.
+class I2CTraceReplay {
+ public:
+  void init(Interface_t *hal, const uint8_t *trace, size_t size);
+  // Replay only the traffic of `slave`. Transactions with other devices are
+  // skipped and recorded sleeps are matched loosely, as they cannot be told
+  // apart by device.
+  void set_slave_filter(uint8_t slave) {
+    this->filter_ = true;
+    this->filter_slave_ = slave;
+  }
+
+  // True once a call found the end of the trace; that call and all later ones fail.
+  bool is_done() const { return this->done_; }
+  bool has_diverged() const { return this->diverged_; }
+  // Event index of the divergence and a short description.
+  uint32_t get_divergence_event() const { return this->events_; }
+  const char *get_divergence() const { return this->divergence_; }
+  uint32_t get_events() const { return this->events_; }
+  // Device time covered so far: recorded gaps plus replayed sleeps.
+  uint64_t get_recorded_us() const { return this->recorded_us_; }
+
+ protected:
+  static int i2c_read_(void *handle, uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data, int rd_size);
+  static int i2c_write_(void *handle, uint8_t sl_addr, uint8_t *wr_data1, int wr_size1, uint8_t *wr_data2,
+                        int wr_size2);
+  static void ms_sleep_(uint32_t ms);
+  static int reset_(void *handle);
+
+  struct Event {
+    uint8_t type;
+    uint8_t slave;
+    int8_t ret;
+    uint32_t delta_us;
+    uint32_t sleep_ms;
+    const uint8_t *a;
+    uint8_t a_size;
+    const uint8_t *b;
+    uint8_t b_size;
+  };
+
+  // Decode the event at `pos` and advance `pos` past it.
+  bool decode_(size_t &pos, Event &event) const;
+  // Consume the next event if it has `type` and `slave`; otherwise diverge.
+  bool next_(uint8_t type, uint8_t slave, Event &event);
+  int diverge_(const char *reason);
+
+  static I2CTraceReplay *active_;
+
+  const uint8_t *trace_{nullptr};
+  size_t size_{0};
+  size_t pos_{0};
+  uint32_t events_{0};
+  uint64_t recorded_us_{0};
+  bool done_{false};
+  bool diverged_{false};
+  const char *divergence_{""};
+  bool filter_{false};
+  uint8_t filter_slave_{0};
+};
+
+}  // namespace zmod4510
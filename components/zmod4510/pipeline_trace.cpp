@@ -0,0 +1,67 @@
+#include "pipeline_trace.h"
+#include "esphome/core/defines.h"
+#ifdef USE_ZMOD4510_PIPELINE_TRACE
+
+namespace zmod4510 {
+
+void PipelineTrace::record(Stage stage, uint32_t duration_us) {
+  StageData &data = this->stages_[stage];
+  if (data.count >= WINDOW) {
+    data.count = 0;
+    for (auto &bucket : data.buckets) {
+      bucket /= 2;
+      data.count += bucket;
+    }
+  }
+
+  uint8_t bucket = 0;
+  while (bucket + 1 < NUM_BUCKETS && duration_us >= (1u << bucket)) {
+    bucket++;
+  }
+  data.buckets[bucket]++;
+  data.count++;
+  data.total++;
+  data.last = duration_us;
+  if (duration_us > data.max) {
+    data.max = duration_us;
+  }
+}
+
+uint32_t PipelineTrace::get_percentile(Stage stage, uint8_t percent) const {
+  const StageData &data = this->stages_[stage];
+  if (data.count == 0) {
+    return 0;
+  }
+  uint32_t target = (static_cast<uint32_t>(data.count) * percent + 99) / 100;
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i + 1 < NUM_BUCKETS; i++) {
+    seen += data.buckets[i];
+    if (seen >= target) {
+      return 1u << i;
+    }
+  }
+  return data.max;
+}
+
+const char *PipelineTrace::get_stage_name(Stage stage) {
+  switch (stage) {
+    case STAGE_DISPATCH:
+      return "dispatch";
+    case STAGE_MEASUREMENT:
+      return "measurement";
+    case STAGE_ADC_READ:
+      return "adc read";
+    case STAGE_CALC:
+      return "calc";
+    case STAGE_PUBLISH_WAIT:
+      return "publish wait";
+    case STAGE_PUBLISH:
+      return "publish";
+    default:
+      return "unknown";
+  }
+}
+
+}  // namespace zmod4510
+
+#endif  // USE_ZMOD4510_PIPELINE_TRACE
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zmod4510 {
+
+// Rolling per-stage duration histograms for the sample pipeline, from the
+// measurement start to publish_state(). Buckets are powers of two in
+// microseconds; once a stage has seen WINDOW samples all its buckets are
+// halved, so old samples fade out without storing them.
+class PipelineTrace {
+ public:
+  enum Stage : uint8_t {
+    STAGE_DISPATCH = 0,   // sample deadline until loop() served it
+    STAGE_MEASUREMENT,    // start command until the read at the next deadline;
+                          // the sequence itself ends earlier, unobserved
+    STAGE_ADC_READ,       // reading and validating the ADC result
+    STAGE_CALC,           // calc_no2_o3()
+    STAGE_PUBLISH_WAIT,   // algorithm results until update() published them
+    STAGE_PUBLISH,        // all publish_state() calls of one update()
+    NUM_STAGES,
+  };
+  // Up to 2^30 us (~18 min) and above, so that the publish wait fits with
+  // any sensible update interval.
+  static const uint8_t NUM_BUCKETS = 32;
+  static const uint16_t WINDOW = 256;
+
+  void record(Stage stage, uint32_t duration_us);
+
+  uint32_t get_count(Stage stage) const { return this->stages_[stage].total; }
+  uint32_t get_last(Stage stage) const { return this->stages_[stage].last; }
+  uint32_t get_max(Stage stage) const { return this->stages_[stage].max; }
+  // Upper bucket bound (us) below which `percent` of the recent samples fall.
+  uint32_t get_percentile(Stage stage, uint8_t percent) const;
+
+  static const char *get_stage_name(Stage stage);
+
+ protected:
+  struct StageData {
+    uint16_t buckets[NUM_BUCKETS];
+    uint16_t count;  // samples currently represented in buckets
+    uint32_t total;  // samples ever recorded
+    uint32_t last;
+    uint32_t max;
+  };
+  StageData stages_[NUM_STAGES]{};
+};
+
+}  // namespace zmod4510
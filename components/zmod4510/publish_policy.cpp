@@ -0,0 +1,45 @@
+#include "publish_policy.h"
+#include "esphome/core/defines.h"
+#include <cmath>
+#ifdef USE_ZMOD4510_PUBLISH_POLICY
+
+namespace zmod4510 {
+
+bool PublishPolicy::on_tick(float value, uint32_t now) {
+  bool publish = !this->published_ || std::fabs(value - this->last_published_) > this->deadband_ ||
+                 (this->max_interval_ms_ != 0 && now - this->last_published_ms_ >= this->max_interval_ms_);
+  if (!publish) {
+    this->suppressed_++;
+    return false;
+  }
+  this->mark_published_(value, now);
+  return true;
+}
+
+bool PublishPolicy::on_sample(float value, uint32_t now) {
+  bool fast = false;
+  if (this->has_rate_threshold() && this->has_sample_ && now != this->last_sample_ms_) {
+    float per_minute = std::fabs(value - this->last_sample_) * 60000.0f / (now - this->last_sample_ms_);
+    fast = per_minute >= this->rate_threshold_;
+  }
+  this->has_sample_ = true;
+  this->last_sample_ = value;
+  this->last_sample_ms_ = now;
+
+  // A fast change that was already published needs no second publish.
+  if (!fast || (this->published_ && value == this->last_published_)) {
+    return false;
+  }
+  this->mark_published_(value, now);
+  return true;
+}
+
+void PublishPolicy::mark_published_(float value, uint32_t now) {
+  this->published_ = true;
+  this->last_published_ = value;
+  this->last_published_ms_ = now;
+}
+
+}  // namespace zmod4510
+
+#endif  // USE_ZMOD4510_PUBLISH_POLICY
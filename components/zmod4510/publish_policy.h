@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zmod4510 {
+
+// Decides when an output is worth publishing. On the regular update() tick a
+// value is published when it left the deadband around the last published
+// value or when the heartbeat interval ran out. On every 6 s sample the rate of
+// change is checked and a fast change is published right away.
+class PublishPolicy {
+ public:
+  PublishPolicy() = default;
+  // deadband: absolute change, max_interval_ms: heartbeat (0 = none),
+  // rate_threshold: change per minute that triggers an immediate publish (0 = off).
+  PublishPolicy(float deadband, uint32_t max_interval_ms, float rate_threshold)
+      : deadband_(deadband), max_interval_ms_(max_interval_ms), rate_threshold_(rate_threshold) {}
+
+  // Regular update() tick.
+  bool on_tick(float value, uint32_t now);
+  // New sample from the algorithm.
+  bool on_sample(float value, uint32_t now);
+
+  bool has_rate_threshold() const { return this->rate_threshold_ > 0.0f; }
+  uint32_t get_suppressed() const { return this->suppressed_; }
+
+ protected:
+  void mark_published_(float value, uint32_t now);
+
+  float deadband_{0.0f};
+  uint32_t max_interval_ms_{0};
+  float rate_threshold_{0.0f};
+
+  bool published_{false};
+  float last_published_{0.0f};
+  uint32_t last_published_ms_{0};
+  bool has_sample_{false};
+  float last_sample_{0.0f};
+  uint32_t last_sample_ms_{0};
+  uint32_t suppressed_{0};
+};
+
+}  // namespace zmod4510
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "crc32.h"
+
+// On-disk/on-wire layout of ZMOD4510 recordings. Shared by the component
+// writer and the host tools, so it only depends on the standard library.
+//
+// A recording is a FileHeader, followed by `num_columns` ColumnDesc entries,
+// followed by any number of blocks. A block is a BlockHeader and then one
+// contiguous array per column, in directory order, each starting on an
+// 8-byte boundary relative to the block start. Column arrays are sized for
+// `capacity` rows, of which the first `rows` are valid, so every column of a
+// block can be used in place from a memory mapping. All fields are little
+// endian.
+
+namespace zmod4510 {
+namespace recording {
+
+static const char FILE_MAGIC[8] = {'Z', 'M', 'O', 'D', 'R', 'E', 'C', '\0'};
+static const uint32_t BLOCK_MAGIC = 0x314B4C42;  // "BLK1"
+static const uint16_t FORMAT_VERSION = 1;
+static const size_t COLUMN_ALIGN = 8;
+
+enum ColumnType : uint8_t { TYPE_U8 = 0, TYPE_I8, TYPE_U16, TYPE_U32, TYPE_F32 };
+
+enum ColumnId : uint16_t {
+  COLUMN_TIMESTAMP_MS = 0,  // u32: millis() when the sample was read
+  COLUMN_ADC_RESULT,        // u8 x 32: raw zmod4xxx_read_adc_result() frame
+  COLUMN_HUMIDITY,          // f32: no2_o3_inputs_t::humidity_pct
+  COLUMN_TEMPERATURE,       // f32: no2_o3_inputs_t::temperature_degc
+  COLUMN_RMOX,              // f32 x 4
+  COLUMN_NO2,               // f32: ppb
+  COLUMN_O3,                // f32: ppb
+  COLUMN_FAST_AQI,          // u16
+  COLUMN_EPA_AQI,           // u16
+  COLUMN_COMPENSATION_TEMPERATURE,  // f32: no2_o3_results_t::temperature
+  COLUMN_ALGO_STATUS,       // i8: calc_no2_o3() return code
+  COLUMN_SENSOR_STATUS,     // u8: status register at read time
+  COLUMN_FLAGS,             // u8: FLAG_* bits
+  COLUMN_READ_RETRIES,      // u8: ADC re-reads after access conflicts
+  NUM_COLUMNS,
+};
+
+enum Flag : uint8_t {
+  FLAG_STABILIZATION = 1 << 0,     // Algorithm still stabilizing
+  FLAG_DAMAGE = 1 << 1,            // Algorithm reported a damaged sensor
+  FLAG_READ_RETRIED = 1 << 2,      // ADC result was read more than once
+  FLAG_AFTER_RESET = 1 << 3,       // First sample after a POR recovery
+  FLAG_EXTERNAL_HUMIDITY = 1 << 4,
+  FLAG_EXTERNAL_TEMPERATURE = 1 << 5,
+};
+
+// Besides the stream layout, the header carries the sensor's calibration
+// (zmod4xxx_dev_t fields read from the device), so a recording holds
+// everything needed to recompute Rmox and re-run the algorithm offline.
+struct FileHeader {
+  char magic[8];
+  uint16_t version;
+  uint16_t num_columns;
+  uint32_t sample_period_ms;
+  uint16_t pid;
+  uint16_t mox_lr;
+  uint16_t mox_er;
+  uint8_t config[6];
+  uint8_t prod_data_len;
+  uint8_t prod_data[15];
+  uint8_t reserved[4];
+};
+static_assert(sizeof(FileHeader) == 48, "FileHeader layout");
+
+struct ColumnDesc {
+  uint16_t id;
+  uint8_t type;   // ColumnType
+  uint8_t count;  // Elements per row
+};
+static_assert(sizeof(ColumnDesc) == 4, "ColumnDesc layout");
+
+struct BlockHeader {
+  uint32_t magic;
+  uint32_t size;  // Whole block, header included
+  uint16_t capacity;
+  uint16_t rows;
+  uint32_t sequence;
+  uint32_t crc;  // crc32() of the column data
+  uint32_t reserved;
+};
+static_assert(sizeof(BlockHeader) == 24, "BlockHeader layout");
+
+inline size_t type_size(uint8_t type) {
+  switch (type) {
+    case TYPE_U16:
+      return 2;
+    case TYPE_U32:
+    case TYPE_F32:
+      return 4;
+    default:
+      return 1;
+  }
+}
+
+inline size_t align_column(size_t offset) { return (offset + COLUMN_ALIGN - 1) & ~(COLUMN_ALIGN - 1); }
+
+// Offset of column `index` from the block start, for a block of `capacity`
+// rows. Passing num_columns yields the block size.
+inline size_t column_offset(const ColumnDesc *columns, size_t index, size_t capacity) {
+  size_t offset = align_column(sizeof(BlockHeader));
+  for (size_t i = 0; i < index; i++)
+    offset = align_column(offset + type_size(columns[i].type) * columns[i].count * capacity);
+  return offset;
+}
+
+}  // namespace recording
+}  // namespace zmod4510
@@ -0,0 +1,62 @@
+#include "recording_sinks.h"
+
+namespace zmod4510 {
+
+#ifdef USE_ZMOD4510_RECORDING_UART
+bool UARTRecordingSink::begin(bool &restart) {
+  restart = !this->started_;
+  this->started_ = true;
+  return true;
+}
+
+bool UARTRecordingSink::write(const uint8_t *data, size_t len) {
+  this->uart_->write_array(data, len);
+  return true;
+}
+#endif
+
+#ifdef USE_ZMOD4510_RECORDING_TCP
+bool TCPRecordingSink::start() {
+  this->server_ = esphome::socket::socket_ip(SOCK_STREAM, 0);
+  if (this->server_ == nullptr)
+    return false;
+  int enable = 1;
+  this->server_->setsockopt(SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+  this->server_->setblocking(false);
+  struct sockaddr_storage addr;
+  socklen_t addr_len = esphome::socket::set_sockaddr_any((struct sockaddr *) &addr, sizeof(addr), this->port_);
+  if (addr_len == 0 || this->server_->bind((struct sockaddr *) &addr, addr_len) != 0 ||
+      this->server_->listen(1) != 0) {
+    this->server_.reset();
+    return false;
+  }
+  return true;
+}
+
+bool TCPRecordingSink::begin(bool &restart) {
+  restart = false;
+  if (this->server_ == nullptr)
+    return false;
+  std::unique_ptr<esphome::socket::Socket> client = this->server_->accept(nullptr, nullptr);
+  if (client != nullptr) {
+    // A newer client replaces the current one.
+    client->setblocking(false);
+    this->client_ = std::move(client);
+    restart = true;
+  }
+  return this->client_ != nullptr;
+}
+
+bool TCPRecordingSink::write(const uint8_t *data, size_t len) {
+  if (this->client_ == nullptr)
+    return false;
+  ssize_t written = this->client_->write(data, len);
+  if (written != ssize_t(len)) {
+    this->client_.reset();
+    return false;
+  }
+  return true;
+}
+#endif
+
+}  // namespace zmod4510
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+#include "recording_writer.h"
+#ifdef USE_ZMOD4510_RECORDING_UART
+#include "esphome/components/uart/uart.h"
+#endif
+#ifdef USE_ZMOD4510_RECORDING_TCP
+#include "esphome/components/socket/socket.h"
+#endif
+
+namespace zmod4510 {
+
+#ifdef USE_ZMOD4510_RECORDING_UART
+// Writes the recording to a UART; the file header is sent once after boot.
+class UARTRecordingSink : public RecordingSink {
+ public:
+  explicit UARTRecordingSink(esphome::uart::UARTComponent *uart) : uart_(uart) {}
+  bool begin(bool &restart) override;
+  bool write(const uint8_t *data, size_t len) override;
+
+ protected:
+  esphome::uart::UARTComponent *uart_;
+  bool started_{false};
+};
+#endif
+
+#ifdef USE_ZMOD4510_RECORDING_TCP
+// Serves the recording to one TCP client at a time, e.g. `nc <host> <port>`.
+// Every new client gets a complete stream starting with the file header. A
+// client that cannot keep up is disconnected rather than sent a torn block.
+class TCPRecordingSink : public RecordingSink {
+ public:
+  explicit TCPRecordingSink(uint16_t port) : port_(port) {}
+  bool start();
+  bool begin(bool &restart) override;
+  bool write(const uint8_t *data, size_t len) override;
+
+ protected:
+  uint16_t port_;
+  std::unique_ptr<esphome::socket::Socket> server_;
+  std::unique_ptr<esphome::socket::Socket> client_;
+};
+#endif
+
+}  // namespace zmod4510
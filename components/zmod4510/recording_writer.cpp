@@ -0,0 +1,120 @@
+#include "recording_writer.h"
+#include "esphome/core/defines.h"
+#include <cstring>
+#ifdef USE_ZMOD4510_RECORDING
+
+namespace zmod4510 {
+
+using namespace recording;
+
+// Version 1 schema; the directory is sent with every file header.
+static const ColumnDesc COLUMNS[NUM_COLUMNS] = {
+    {COLUMN_TIMESTAMP_MS, TYPE_U32, 1},
+    {COLUMN_ADC_RESULT, TYPE_U8, 32},
+    {COLUMN_HUMIDITY, TYPE_F32, 1},
+    {COLUMN_TEMPERATURE, TYPE_F32, 1},
+    {COLUMN_RMOX, TYPE_F32, 4},
+    {COLUMN_NO2, TYPE_F32, 1},
+    {COLUMN_O3, TYPE_F32, 1},
+    {COLUMN_FAST_AQI, TYPE_U16, 1},
+    {COLUMN_EPA_AQI, TYPE_U16, 1},
+    {COLUMN_COMPENSATION_TEMPERATURE, TYPE_F32, 1},
+    {COLUMN_ALGO_STATUS, TYPE_I8, 1},
+    {COLUMN_SENSOR_STATUS, TYPE_U8, 1},
+    {COLUMN_FLAGS, TYPE_U8, 1},
+    {COLUMN_READ_RETRIES, TYPE_U8, 1},
+};
+
+// Where each column's value sits in RecordingRow.
+static const size_t FIELDS[NUM_COLUMNS] = {
+    offsetof(RecordingRow, timestamp_ms),
+    offsetof(RecordingRow, adc_result),
+    offsetof(RecordingRow, humidity),
+    offsetof(RecordingRow, temperature),
+    offsetof(RecordingRow, rmox),
+    offsetof(RecordingRow, no2),
+    offsetof(RecordingRow, o3),
+    offsetof(RecordingRow, fast_aqi),
+    offsetof(RecordingRow, epa_aqi),
+    offsetof(RecordingRow, compensation_temperature),
+    offsetof(RecordingRow, algo_status),
+    offsetof(RecordingRow, sensor_status),
+    offsetof(RecordingRow, flags),
+    offsetof(RecordingRow, read_retries),
+};
+
+void RecordingWriter::init(RecordingSink *sink, uint16_t capacity, uint32_t sample_period_ms) {
+  this->sink_ = sink;
+  this->capacity_ = capacity;
+  this->rows_ = 0;
+  for (size_t c = 0; c < NUM_COLUMNS; c++)
+    this->offsets_[c] = column_offset(COLUMNS, c, capacity);
+  this->block_size_ = column_offset(COLUMNS, NUM_COLUMNS, capacity);
+  this->block_.reset(new uint8_t[this->block_size_]());
+
+  memset(&this->file_header_, 0, sizeof(this->file_header_));
+  memcpy(this->file_header_.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+  this->file_header_.version = FORMAT_VERSION;
+  this->file_header_.num_columns = NUM_COLUMNS;
+  this->file_header_.sample_period_ms = sample_period_ms;
+}
+
+void RecordingWriter::set_calibration(uint16_t pid, uint16_t mox_lr, uint16_t mox_er, const uint8_t *config,
+                                      const uint8_t *prod_data, uint8_t prod_data_len) {
+  if (prod_data_len > sizeof(this->file_header_.prod_data))
+    prod_data_len = sizeof(this->file_header_.prod_data);
+  this->file_header_.pid = pid;
+  this->file_header_.mox_lr = mox_lr;
+  this->file_header_.mox_er = mox_er;
+  memcpy(this->file_header_.config, config, sizeof(this->file_header_.config));
+  this->file_header_.prod_data_len = prod_data_len;
+  memcpy(this->file_header_.prod_data, prod_data, prod_data_len);
+}
+
+void RecordingWriter::add(const RecordingRow &row) {
+  if (this->block_ == nullptr)
+    return;
+  const uint8_t *src = reinterpret_cast<const uint8_t *>(&row);
+  for (size_t c = 0; c < NUM_COLUMNS; c++) {
+    size_t width = type_size(COLUMNS[c].type) * COLUMNS[c].count;
+    memcpy(this->block_.get() + this->offsets_[c] + this->rows_ * width, src + FIELDS[c], width);
+  }
+  if (++this->rows_ >= this->capacity_)
+    this->flush();
+}
+
+void RecordingWriter::flush() {
+  if (this->rows_ == 0)
+    return;
+  uint16_t rows = this->rows_;
+  this->rows_ = 0;
+
+  bool restart = false;
+  if (!this->sink_->begin(restart)) {
+    this->blocks_dropped_++;
+    return;
+  }
+  if (restart) {
+    this->sink_->write(reinterpret_cast<const uint8_t *>(&this->file_header_), sizeof(this->file_header_));
+    this->sink_->write(reinterpret_cast<const uint8_t *>(COLUMNS), sizeof(COLUMNS));
+  }
+
+  BlockHeader header;
+  header.magic = BLOCK_MAGIC;
+  header.size = this->block_size_;
+  header.capacity = this->capacity_;
+  header.rows = rows;
+  header.sequence = this->sequence_++;
+  header.crc = crc32(this->block_.get() + sizeof(header), this->block_size_ - sizeof(header));
+  header.reserved = 0;
+  memcpy(this->block_.get(), &header, sizeof(header));
+  if (this->sink_->write(this->block_.get(), this->block_size_)) {
+    this->blocks_sent_++;
+  } else {
+    this->blocks_dropped_++;
+  }
+}
+
+}  // namespace zmod4510
+
+#endif  // USE_ZMOD4510_RECORDING
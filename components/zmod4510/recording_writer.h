@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "recording_format.h"
+
+namespace zmod4510 {
+
+// Everything known about one measurement; one row of a recording.
+struct RecordingRow {
+  uint32_t timestamp_ms;
+  uint8_t adc_result[32];
+  float humidity;
+  float temperature;
+  float rmox[4];
+  float no2;
+  float o3;
+  uint16_t fast_aqi;
+  uint16_t epa_aqi;
+  float compensation_temperature;
+  int8_t algo_status;
+  uint8_t sensor_status;
+  uint8_t flags;
+  uint8_t read_retries;
+};
+
+// Destination of a recording stream.
+class RecordingSink {
+ public:
+  virtual ~RecordingSink() = default;
+  // Called before each block. Returns false if nobody is listening, in which
+  // case the block is dropped. Sets `restart` when the stream (re)started and
+  // needs the file header first.
+  virtual bool begin(bool &restart) = 0;
+  virtual bool write(const uint8_t *data, size_t len) = 0;
+};
+
+// Collects rows into column-major blocks (see recording_format.h) and hands
+// complete blocks to the sink. Memory use is one block.
+class RecordingWriter {
+ public:
+  void init(RecordingSink *sink, uint16_t capacity, uint32_t sample_period_ms);
+  // Sensor calibration for the file header; see recording::FileHeader.
+  void set_calibration(uint16_t pid, uint16_t mox_lr, uint16_t mox_er, const uint8_t *config, const uint8_t *prod_data,
+                       uint8_t prod_data_len);
+  void add(const RecordingRow &row);
+  // Send the current block even if it is not full.
+  void flush();
+
+  uint32_t get_blocks_sent() const { return this->blocks_sent_; }
+  uint32_t get_blocks_dropped() const { return this->blocks_dropped_; }
+  size_t get_block_size() const { return this->block_size_; }
+
+ protected:
+  RecordingSink *sink_{nullptr};
+  std::unique_ptr<uint8_t[]> block_;
+  size_t block_size_{0};
+  size_t offsets_[recording::NUM_COLUMNS];
+  uint16_t capacity_{0};
+  uint16_t rows_{0};
+  uint32_t sequence_{0};
+  recording::FileHeader file_header_;
+  uint32_t blocks_sent_{0};
+  uint32_t blocks_dropped_{0};
+};
+
+}  // namespace zmod4510
@@ -0,0 +1,92 @@
+#include "sample_history.h"
+#include "esphome/core/defines.h"
+#ifdef USE_ZMOD4510_HISTORY
+
+namespace zmod4510 {
+
+static const uint32_t RESOLUTION_WIDTH[SampleHistory::NUM_RESOLUTIONS] = {0, 60, 3600, 86400};
+
+void SampleHistory::init(size_t raw, size_t minutes, size_t hours, size_t days) {
+  this->levels_[RAW].ring.init(raw);
+  this->levels_[MINUTE].ring.init(minutes);
+  this->levels_[HOUR].ring.init(hours);
+  this->levels_[DAY].ring.init(days);
+}
+
+uint32_t SampleHistory::get_width(Resolution res) { return RESOLUTION_WIDTH[res]; }
+
+void SampleHistory::add(uint32_t timestamp, const float values[HistoryBucket::NUM_CHANNELS]) {
+  HistoryBucket sample;
+  sample.start = timestamp;
+  sample.count = 1;
+  for (uint8_t c = 0; c < HistoryBucket::NUM_CHANNELS; c++) {
+    sample.min[c] = sample.mean[c] = sample.max[c] = values[c];
+  }
+  this->levels_[RAW].ring.push(sample);
+  this->feed_(MINUTE, sample);
+}
+
+void SampleHistory::feed_(uint8_t level, const HistoryBucket &in) {
+  Level &lvl = this->levels_[level];
+  uint32_t width = RESOLUTION_WIDTH[level];
+  uint32_t start = in.start - in.start % width;
+
+  if (lvl.has_open && lvl.open.start != start) {
+    // Period is over: store it and pass it up the pyramid.
+    lvl.ring.push(lvl.open);
+    if (level + 1 < NUM_RESOLUTIONS) {
+      this->feed_(level + 1, lvl.open);
+    }
+    lvl.has_open = false;
+  }
+
+  if (!lvl.has_open) {
+    lvl.open = in;
+    lvl.open.start = start;
+    lvl.has_open = true;
+    return;
+  }
+
+  HistoryBucket &open = lvl.open;
+  uint32_t total = open.count + in.count;
+  for (uint8_t c = 0; c < HistoryBucket::NUM_CHANNELS; c++) {
+    if (in.min[c] < open.min[c])
+      open.min[c] = in.min[c];
+    if (in.max[c] > open.max[c])
+      open.max[c] = in.max[c];
+    open.mean[c] = (open.mean[c] * open.count + in.mean[c] * in.count) / total;
+  }
+  open.count = total > UINT16_MAX ? UINT16_MAX : total;
+}
+
+size_t SampleHistory::lower_bound_(const HistoryRing<HistoryBucket> &ring, uint32_t from) {
+  size_t lo = 0, hi = ring.size();
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (ring[mid].start < from) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+const HistoryBucket *SampleHistory::find(Resolution res, uint32_t from) const {
+  const HistoryRing<HistoryBucket> &ring = this->levels_[res].ring;
+  size_t i = lower_bound_(ring, from);
+  return i < ring.size() ? &ring[i] : nullptr;
+}
+
+size_t SampleHistory::query(Resolution res, uint32_t from, uint32_t to, HistoryBucket *out, size_t max_out) const {
+  size_t n = 0;
+  const HistoryRing<HistoryBucket> &ring = this->levels_[res].ring;
+  for (size_t i = lower_bound_(ring, from); i < ring.size() && ring[i].start <= to && n < max_out; i++) {
+    out[n++] = ring[i];
+  }
+  return n;
+}
+
+}  // namespace zmod4510
+
+#endif  // USE_ZMOD4510_HISTORY
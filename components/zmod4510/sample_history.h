@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace zmod4510 {
+
+// One aggregated history entry. Raw samples are reported as buckets with a
+// count of one, so all resolutions share the same query interface.
+struct HistoryBucket {
+  static const uint8_t NUM_CHANNELS = 2;  // NO2, O3
+  uint32_t start;                         // seconds
+  uint16_t count;
+  float min[NUM_CHANNELS];
+  float mean[NUM_CHANNELS];
+  float max[NUM_CHANNELS];
+};
+
+// Fixed-capacity ring of T, oldest first. Storage is allocated once.
+template<typename T> class HistoryRing {
+ public:
+  void init(size_t capacity) {
+    this->data_.reset(capacity ? new T[capacity] : nullptr);
+    this->capacity_ = capacity;
+    this->head_ = 0;
+    this->size_ = 0;
+  }
+  void push(const T &item) {
+    if (this->capacity_ == 0)
+      return;
+    this->data_[(this->head_ + this->size_) % this->capacity_] = item;
+    if (this->size_ < this->capacity_) {
+      this->size_++;
+    } else {
+      this->head_ = (this->head_ + 1) % this->capacity_;
+    }
+  }
+  size_t size() const { return this->size_; }
+  size_t capacity() const { return this->capacity_; }
+  const T &operator[](size_t i) const { return this->data_[(this->head_ + i) % this->capacity_]; }
+
+ protected:
+  std::unique_ptr<T[]> data_;
+  size_t capacity_{0};
+  size_t head_{0};
+  size_t size_{0};
+};
+
+// Sample history with a downsampling pyramid: raw samples for a short window,
+// cascading into minute, hour and day buckets with min/mean/max per channel.
+// Each insert touches at most one open bucket per level, so insertion is O(1).
+class SampleHistory {
+ public:
+  enum Resolution : uint8_t { RAW = 0, MINUTE, HOUR, DAY, NUM_RESOLUTIONS };
+
+  void init(size_t raw, size_t minutes, size_t hours, size_t days);
+  void add(uint32_t timestamp, const float values[HistoryBucket::NUM_CHANNELS]);
+
+  size_t size(Resolution res) const { return this->levels_[res].ring.size(); }
+  static uint32_t get_width(Resolution res);
+
+  // Call `fn(const HistoryBucket &)` for every stored entry of `res` whose
+  // start lies in [from, to], oldest first. Returns the number of entries.
+  template<typename F> size_t for_each(Resolution res, uint32_t from, uint32_t to, F &&fn) const {
+    const HistoryRing<HistoryBucket> &ring = this->levels_[res].ring;
+    size_t count = 0;
+    for (size_t i = this->lower_bound_(ring, from); i < ring.size() && ring[i].start <= to; i++) {
+      fn(ring[i]);
+      count++;
+    }
+    return count;
+  }
+  // First stored entry of `res` starting at or after `from`, or nullptr. Lets
+  // readers walk the history by timestamp while new samples are added.
+  const HistoryBucket *find(Resolution res, uint32_t from) const;
+  // Copy up to `max_out` entries of `res` in [from, to] into `out`.
+  size_t query(Resolution res, uint32_t from, uint32_t to, HistoryBucket *out, size_t max_out) const;
+
+ protected:
+  struct Level {
+    HistoryRing<HistoryBucket> ring;
+    HistoryBucket open;
+    bool has_open{false};
+  };
+
+  // Merge `in` into the open bucket of `level`, closing it first when `in`
+  // starts a new period.
+  void feed_(uint8_t level, const HistoryBucket &in);
+  static size_t lower_bound_(const HistoryRing<HistoryBucket> &ring, uint32_t from);
+
+  Level levels_[NUM_RESOLUTIONS];
+};
+
+}  // namespace zmod4510
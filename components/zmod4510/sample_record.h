@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zmod4510 {
+
+// One algorithm sample as kept by the history stores and the flash journal.
+struct SeriesRecord {
+  static const uint8_t NUM_CHANNELS = 6;  // NO2, O3, Rmox 0..3
+  uint32_t timestamp;                     // seconds
+  float values[NUM_CHANNELS];
+};
+
+}  // namespace zmod4510
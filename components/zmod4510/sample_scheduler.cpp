@@ -0,0 +1,62 @@
+#include "sample_scheduler.h"
+
+namespace zmod4510 {
+
+static const uint32_t BUCKET_BOUNDS[SampleScheduler::NUM_BUCKETS] = {1,   2,   5,   10,   20,   50,
+                                                                      100, 200, 500, 1000, 2000, UINT32_MAX};
+
+void SampleScheduler::start(uint32_t now) {
+  this->next_deadline_ = now;
+  this->started_ = true;
+}
+
+bool SampleScheduler::poll(uint32_t now) {
+  if (!this->started_) {
+    return false;
+  }
+  // Signed difference keeps the comparison valid across millis() roll-over.
+  int32_t diff = static_cast<int32_t>(now - this->next_deadline_);
+  if (diff < 0) {
+    return false;
+  }
+  uint32_t lateness = static_cast<uint32_t>(diff);
+  if (lateness >= this->period_ms_) {
+    uint32_t skipped = lateness / this->period_ms_;
+    this->missed_ += skipped;
+    this->next_deadline_ += skipped * this->period_ms_;
+    lateness -= skipped * this->period_ms_;
+  }
+  this->next_deadline_ += this->period_ms_;
+
+  this->samples_++;
+  this->last_lateness_ = lateness;
+  if (lateness > this->late_threshold_ms_) {
+    this->late_++;
+  }
+  if (lateness > this->max_lateness_) {
+    this->max_lateness_ = lateness;
+  }
+  uint8_t bucket = 0;
+  while (lateness > BUCKET_BOUNDS[bucket]) {
+    bucket++;
+  }
+  this->histogram_[bucket]++;
+  return true;
+}
+
+uint32_t SampleScheduler::get_jitter_percentile(uint8_t percent) const {
+  if (this->samples_ == 0) {
+    return 0;
+  }
+  uint64_t target = (static_cast<uint64_t>(this->samples_) * percent + 99) / 100;
+  uint64_t seen = 0;
+  for (uint8_t i = 0; i < NUM_BUCKETS; i++) {
+    seen += this->histogram_[i];
+    if (seen >= target) {
+      return BUCKET_BOUNDS[i] < this->max_lateness_ ? BUCKET_BOUNDS[i] : this->max_lateness_;
+    }
+  }
+  return this->max_lateness_;
+}
+
+}  // namespace zmod4510
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zmod4510 {
+
+// Schedules measurement cycles on absolute deadlines of a monotonic millisecond
+// clock. Deadlines advance by exact multiples of the period, so processing time
+// and late polls never accumulate into drift. The clock is passed in by the
+// caller, which keeps the scheduler independent of millis().
+class SampleScheduler {
+ public:
+  // Upper bounds (ms) of the lateness histogram buckets; the last bucket is open.
+  static const uint8_t NUM_BUCKETS = 12;
+
+  explicit SampleScheduler(uint32_t period_ms, uint32_t late_threshold_ms = 100)
+      : period_ms_(period_ms), late_threshold_ms_(late_threshold_ms) {}
+
+  // Place the first deadline at `now`.
+  void start(uint32_t now);
+  // Return true once the current deadline has passed and advance to the next one.
+  // Whole periods that passed unserved are counted as missed samples.
+  bool poll(uint32_t now);
+
+  uint32_t get_period() const { return this->period_ms_; }
+  uint32_t get_next_deadline() const { return this->next_deadline_; }
+  uint32_t get_samples() const { return this->samples_; }
+  uint32_t get_late_samples() const { return this->late_; }
+  uint32_t get_missed_samples() const { return this->missed_; }
+  uint32_t get_max_lateness() const { return this->max_lateness_; }
+  // Lateness (ms) of the sample most recently returned by poll().
+  uint32_t get_last_lateness() const { return this->last_lateness_; }
+  // Lateness (ms) below which `percent` of the served samples fall, resolved to
+  // the histogram bucket bounds.
+  uint32_t get_jitter_percentile(uint8_t percent) const;
+
+ protected:
+  uint32_t period_ms_;
+  uint32_t late_threshold_ms_;
+  uint32_t next_deadline_{0};
+  bool started_{false};
+
+  uint32_t samples_{0};
+  uint32_t late_{0};
+  uint32_t missed_{0};
+  uint32_t max_lateness_{0};
+  uint32_t last_lateness_{0};
+  uint32_t histogram_[NUM_BUCKETS]{};
+};
+
+}  // namespace zmod4510
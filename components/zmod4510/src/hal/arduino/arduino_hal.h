@@ -1,24 +0,0 @@
-/*****************************************************************************
- * Copyright (c) 2024 Renesas Electronics Corporation
- * All Rights Reserved.
- * 
- * This code is proprietary to Renesas, and is license pursuant to the terms and
- * conditions that may be accessed at:
- * https://www.renesas.com/eu/en/document/msc/renesas-software-license-terms-gas-sensor-software
- *****************************************************************************/
-
-/**
- * @file    arduino_hal.h
- * @brief   Arduino HAL type and function declarations
- * @version 2.7.1
- * @author  Renesas Electronics Corporation
- */
-
-#ifndef ARDUINO_H
-#define ARDUINO_H
-
-typedef enum {
-  aesArduino = 0x4000
-} ArduinoErrorDefs_t;
-
-#endif
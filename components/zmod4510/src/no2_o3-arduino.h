@@ -1,10 +0,0 @@
-// This is an include wrapper for arduino, allowing usage of
-// the include file structure of the EVK and Raspberry examples
-
-#include "hal/hal.h"
-#include "hal/zmod4xxx_hal.h"
-#include "sensors/zmod4xxx.h"
-#include "sensors/hsxxxx.h"
-#include "algos/no2_o3.h"
-#include "algos/zmod4510_config_no2_o3.h"
-#include "algos/zmod4xxx_cleaning.h"
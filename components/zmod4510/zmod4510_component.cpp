@@ -1,8 +1,12 @@
 #include "zmod4510_component.h"
 #include "esphome/core/log.h"
+#include "esphome/core/hal.h"
 #include <Arduino.h>
+#include <algorithm>
 #include <cstring>
+#include <cstdio>
 #include <cstdarg>
+#include <cmath>
 
 // If esp_log_printf_ is not defined, supply a fallback definition.
 #ifndef esp_log_printf_
@@ -23,10 +27,27 @@ namespace zmod4510 {
 
 static const char *TAG = "zmod4510";
 
+// Number of times the ADC result is re-read after an access conflict.
+static const uint8_t MAX_READ_RETRIES = 3;
+// Time given to the sequencer to finish before re-reading the ADC result.
+static const uint32_t READ_RETRY_DELAY_MS = 50;
+// Time the sensor settles after the second init sequence before measuring.
+static const uint32_t PREPARE_SETTLE_MS = 50;
+#ifdef USE_ZMOD4510_HSXXXX
+// Ambient readings averaged per measurement window.
+static const uint8_t AMBIENT_OVERSAMPLING = 4;
+static const uint32_t AMBIENT_INTERVAL_MS = ZMOD4510_NO2_O3_SAMPLE_TIME / AMBIENT_OVERSAMPLING;
+#endif
+
 ZMOD4510::ZMOD4510() : PollingComponent(60000) {  // Default update interval: 60s
   this->i2c_address_ = 0x33;
 }
 
+ZMOD4510::~ZMOD4510() {
+  // Free the device's binding in the Renesas HAL wrapper.
+  zmod4xxx_deinit(&this->dev_);
+}
+
 void ZMOD4510::set_i2c_address(uint8_t address) {
   this->i2c_address_ = address;
 }
@@ -46,80 +67,883 @@ void ZMOD4510::set_aqi_sensor(esphome::sensor::Sensor *sensor) {
 void ZMOD4510::setup() {
   ESP_LOGI(TAG, "Setting up ZMOD4510 sensor");
 
+  // Route the Renesas drivers through the ESPHome I2C bus.
+  esphome_hal_init(&this->bus_hal_, this->bus_);
+#ifdef USE_ZMOD4510_I2C_TRACE
+  Interface_t *driver_hal = &this->trace_inner_hal_;
+#else
+  Interface_t *driver_hal = &this->hal_;
+#endif
+#ifdef USE_ZMOD4510_I2C_STATS
+  this->i2c_stats_.wrap(&this->bus_hal_, driver_hal, esphome::micros);
+#else
+  *driver_hal = this->bus_hal_;
+#endif
+#ifdef USE_ZMOD4510_I2C_TRACE
+  this->i2c_trace_buffer_.reset(new uint8_t[this->i2c_trace_size_]);
+  this->i2c_trace_.wrap(&this->trace_inner_hal_, &this->hal_, esphome::micros, this->i2c_trace_buffer_.get(),
+                        this->i2c_trace_size_);
+#endif
+
   // Configure the device structure.
   this->dev_.i2c_addr = this->i2c_address_;
-  memcpy(this->dev_.config, this->config_, sizeof(this->config_));
+  this->dev_.pid = ZMOD4510_PID;
   this->dev_.prod_data = this->prod_data_;
 
   // Point to the pre-defined configuration arrays.
   this->dev_.init_conf = &zmod_no2_o3_sensor_cfg[INIT];
   this->dev_.meas_conf = &zmod_no2_o3_sensor_cfg[MEASUREMENT];
 
-  int ret = zmod4xxx_init_sensor(&this->dev_);
-  if (ret != ZMOD4XXX_OK) {
-    ESP_LOGE(TAG, "zmod4xxx_init_sensor failed with code %d", ret);
+  // All sensors power up with the node, so the power-on wait is counted from
+  // boot and only the first one to set up waits.
+  uint32_t uptime = millis();
+  if (uptime < ZMOD4XXX_POWER_ON_TIME_MS) {
+    delay(ZMOD4XXX_POWER_ON_TIME_MS - uptime);
   }
-  ret = zmod4xxx_init_measurement(&this->dev_);
+  int ret = zmod4xxx_connect(&this->dev_, &this->hal_);
   if (ret != ZMOD4XXX_OK) {
-    ESP_LOGE(TAG, "zmod4xxx_init_measurement failed with code %d", ret);
+    ESP_LOGE(TAG, "zmod4xxx_connect failed with code %d", ret);
+    this->mark_failed();
+    return;
   }
-  ret = zmod4xxx_prepare_sensor(&this->dev_);
+  ret = zmod4xxx_read_sensor_info(&this->dev_);
   if (ret != ZMOD4XXX_OK) {
-    ESP_LOGE(TAG, "zmod4xxx_prepare_sensor failed with code %d", ret);
+    ESP_LOGE(TAG, "zmod4xxx_read_sensor_info failed with code %d", ret);
+    this->mark_failed();
+    return;
   }
+
+#ifdef USE_ZMOD4510_CLEANING
+  // The cleaning procedure runs only once in the sensor lifetime and blocks
+  // for about a minute; afterwards it reports ERROR_CLEANING.
+  ESP_LOGI(TAG, "Starting cleaning procedure, this might take up to 1 min");
+  ret = zmod4xxx_cleaning_run(&this->dev_);
+  if (ret == ERROR_CLEANING) {
+    ESP_LOGI(TAG, "Skipping cleaning procedure, it has already been performed");
+  } else if (ret != ZMOD4XXX_OK) {
+    ESP_LOGE(TAG, "zmod4xxx_cleaning_run failed with code %d", ret);
+  }
+#endif
+
+  // The init sequences finish in loop(), so the sequencers of all sensors on
+  // the node run at the same time instead of one after another.
+  this->start_init_sequence_(BRING_UP_INIT);
   ret = init_no2_o3(&this->algo_handle_);
   if (ret != NO2_O3_OK) {
     ESP_LOGE(TAG, "init_no2_o3 failed with code %d", ret);
   }
+
+#ifdef USE_ZMOD4510_HISTORY
+  this->history_.init(this->history_raw_ms_ / ZMOD4510_NO2_O3_SAMPLE_TIME, this->history_minutes_,
+                      this->history_hours_, this->history_days_);
+#endif
+#ifdef USE_ZMOD4510_COMPRESSED_HISTORY
+  this->compressed_history_.init(COMPRESSED_BLOCK_SIZE, this->compressed_blocks_);
+  this->compressed_history_.set_mantissa_bits(this->compressed_mantissa_bits_);
+#endif
+#ifdef USE_ZMOD4510_JOURNAL
+  this->restore_journal_();
+#endif
+#ifdef USE_ZMOD4510_RECORDING
+  this->start_recording_();
+#endif
+#ifdef USE_ZMOD4510_EXPORT_WEB
+  if (this->web_server_base_ != nullptr) {
+    this->web_server_base_->init();
+    this->web_server_base_->add_handler(new HistoryWebHandler(this));
+  }
+#endif
+
+  if (this->temperature_source_ != nullptr) {
+    this->temperature_source_->add_on_state_callback(
+        [this](float state) { this->temperature_updated_ms_ = millis(); });
+  }
+  if (this->humidity_source_ != nullptr) {
+    this->humidity_source_->add_on_state_callback([this](float state) { this->humidity_updated_ms_ = millis(); });
+  }
+
+#ifdef USE_ZMOD4510_HSXXXX
+  // Renesas temperature/humidity sensor for ambient compensation; optional and
+  // not needed when both values already come from other sensors.
+  if (this->temperature_source_ != nullptr && this->humidity_source_ != nullptr) {
+    ESP_LOGI(TAG, "Using external temperature and humidity sources");
+  } else if (HSxxxx_Init(&this->hs_, &this->hal_) == 0) {
+    this->ht_sensor_ = &this->hs_;
+    ESP_LOGI(TAG, "Found %s humidity & temperature sensor", HSxxxx_Name(this->ht_sensor_));
+  } else {
+    ESP_LOGI(TAG, "No temperature/humidity sensor found, using on-chip temperature and 50%% RH");
+  }
+  this->ht_next_ms_ = millis();
+#endif
 }
 
-void ZMOD4510::update() {
-  ESP_LOGD(TAG, "Starting sensor update");
+bool ZMOD4510::start_init_sequence_(BringUpState state) {
+  this->bring_up_ = state;
+  this->bring_up_polls_ = 0;
+  this->bring_up_started_ms_ = millis();
+  this->bring_up_next_ms_ = this->bring_up_started_ms_ + ZMOD4XXX_INIT_SEQ_TIME_MS;
+  int ret = zmod4xxx_init_sensor_start(&this->dev_);
+  if (ret != ZMOD4XXX_OK) {
+    ESP_LOGE(TAG, "zmod4xxx_init_sensor failed with code %d", ret);
+    this->bring_up_next_ms_ = this->bring_up_started_ms_;
+    return false;
+  }
+  return true;
+}
 
-  int ret = zmod4xxx_start_measurement(&this->dev_);
+bool ZMOD4510::poll_init_sequence_(uint32_t now, int &ret) {
+  uint8_t status;
+  this->bring_up_polls_++;
+  ret = zmod4xxx_read_status(&this->dev_, &status);
   if (ret != ZMOD4XXX_OK) {
+    return true;
+  }
+  if ((status & STATUS_SEQUENCER_RUNNING_MASK) == 0) {
+    return true;
+  }
+  if (now - this->bring_up_started_ms_ >= ZMOD4XXX_INIT_TIMEOUT_MS) {
+    ret = ERROR_GAS_TIMEOUT;
+    return true;
+  }
+  // Back off as zmod4xxx_wait_sequencer() does: a short step after the first
+  // poll, doubling up to ZMOD4XXX_POLL_MAX_STEP_MS, none past the timeout.
+  if (this->bring_up_polls_ == 1) {
+    this->bring_up_step_ms_ = ZMOD4XXX_POLL_MIN_STEP_MS;
+  } else if (this->bring_up_step_ms_ < ZMOD4XXX_POLL_MAX_STEP_MS) {
+    this->bring_up_step_ms_ = std::min<uint32_t>(2 * this->bring_up_step_ms_, ZMOD4XXX_POLL_MAX_STEP_MS);
+  }
+  uint32_t left = ZMOD4XXX_INIT_TIMEOUT_MS - (now - this->bring_up_started_ms_);
+  this->bring_up_next_ms_ = now + std::min(this->bring_up_step_ms_, left);
+  return false;
+}
+
+void ZMOD4510::poll_bring_up_() {
+  uint32_t now = millis();
+  if (static_cast<int32_t>(now - this->bring_up_next_ms_) < 0) {
+    return;
+  }
+  int ret;
+  switch (this->bring_up_) {
+    case BRING_UP_INIT:
+    case BRING_UP_PREPARE:
+      if (!this->poll_init_sequence_(now, ret)) {
+        return;
+      }
+      if (ret == ZMOD4XXX_OK) {
+        ret = zmod4xxx_init_sensor_finish(&this->dev_);
+      }
+      if (this->bring_up_ == BRING_UP_INIT) {
+        if (ret != ZMOD4XXX_OK) {
+          ESP_LOGE(TAG, "zmod4xxx_init_sensor failed with code %d", ret);
+        }
+        ESP_LOGD(TAG, "Init sequence waited %u ms over %u status polls", now - this->bring_up_started_ms_,
+                 this->bring_up_polls_);
+        ret = zmod4xxx_init_measurement(&this->dev_);
+        if (ret != ZMOD4XXX_OK) {
+          ESP_LOGE(TAG, "zmod4xxx_init_measurement failed with code %d", ret);
+        }
+        // zmod4xxx_prepare_sensor(), split up the same way.
+        this->start_init_sequence_(BRING_UP_PREPARE);
+        return;
+      }
+      if (ret != ZMOD4XXX_OK) {
+        ESP_LOGE(TAG, "zmod4xxx_prepare_sensor failed with code %d", ret);
+      }
+      this->bring_up_ = BRING_UP_SETTLE;
+      this->bring_up_next_ms_ = now + PREPARE_SETTLE_MS;
+      return;
+    case BRING_UP_SETTLE:
+      ret = zmod4xxx_init_measurement(&this->dev_);
+      if (ret != ZMOD4XXX_OK) {
+        ESP_LOGE(TAG, "zmod4xxx_prepare_sensor failed with code %d", ret);
+      }
+      this->bring_up_ = BRING_UP_DONE;
+      this->start_measuring_();
+      return;
+    case BRING_UP_RECOVER:
+      if (!this->poll_init_sequence_(now, ret)) {
+        return;
+      }
+      this->finish_recovery_(ret);
+      return;
+    case BRING_UP_DONE:
+      return;
+  }
+}
+
+void ZMOD4510::start_measuring_() {
+#ifdef USE_ZMOD4510_BUS_SCHEDULER
+  if (this->bus_scheduler_ != nullptr) {
+    if (this->bus_scheduler_->add_device(&this->scheduler_, [this]() { this->run_cycle_(); })) {
+      ESP_LOGI(TAG, "Measuring at phase %u ms of the shared bus schedule",
+               this->bus_scheduler_->get_phase(this->bus_scheduler_->get_device_count() - 1));
+      return;
+    }
+    ESP_LOGW(TAG, "Bus scheduler is full, measuring on an independent schedule");
+    this->bus_scheduler_ = nullptr;
+  }
+#endif
+  this->scheduler_.start(millis());
+}
+
+void ZMOD4510::loop() {
+#ifdef USE_ZMOD4510_SAMPLE_RECORDS
+  // Catch every wrap of millis(), even while no samples are taken.
+  this->uptime_s_();
+#endif
+#ifdef USE_ZMOD4510_HSXXXX
+  this->poll_ambient_();
+#endif
+#ifdef USE_ZMOD4510_EXPORT_UART
+  if (this->export_uart_ != nullptr) {
+    this->poll_export_uart_();
+  }
+#endif
+  if (this->bring_up_ != BRING_UP_DONE) {
+    this->poll_bring_up_();
+    return;
+  }
+
+#ifdef USE_ZMOD4510_BUS_SCHEDULER
+  // The loop() of any sensor on the shared schedule serves all that are due.
+  if (this->bus_scheduler_ != nullptr) {
+    this->bus_scheduler_->poll();
+    return;
+  }
+#endif
+  if (!this->scheduler_.poll(millis())) {
+    return;
+  }
+  this->run_cycle_();
+}
+
+void ZMOD4510::run_cycle_() {
+  // A shared schedule keeps calling while a recovery is polled from loop().
+  if (this->bring_up_ != BRING_UP_DONE) {
+    return;
+  }
+  if (this->recovery_pending_) {
+    this->recover_from_reset_();
+    return;
+  }
+#ifdef USE_ZMOD4510_PIPELINE_TRACE
+  this->trace_.record(PipelineTrace::STAGE_DISPATCH, this->scheduler_.get_last_lateness() * 1000);
+#endif
+
+  bool have_sample = false;
+  if (this->measuring_) {
+    int ret = this->read_sample_();
+    // Either a recovery has taken over, or a measurement that started late is
+    // still running; starting another one would abort it, so it is read at
+    // the next deadline instead.
+    if (this->bring_up_ != BRING_UP_DONE || ret == ERROR_GAS_TIMEOUT) {
+      return;
+    }
+    have_sample = ret == ZMOD4XXX_OK;
+  }
+
+  // Start the next cycle right at the deadline; the algorithm runs while the
+  // sensor is already measuring, so processing time does not shift the cadence.
+  int ret = zmod4xxx_start_measurement(&this->dev_);
+#ifdef USE_ZMOD4510_PIPELINE_TRACE
+  this->measurement_start_us_ = esphome::micros();
+#endif
+  this->measuring_ = ret == ZMOD4XXX_OK;
+  if (!this->measuring_) {
     ESP_LOGE(TAG, "zmod4xxx_start_measurement failed with code %d", ret);
+  }
+
+  if (have_sample) {
+    this->process_sample_();
+  }
+}
+
+void ZMOD4510::update() {
+  ESP_LOGD(TAG, "Cadence: %u samples, %u late, %u missed, jitter p50 %u ms, p95 %u ms, p99 %u ms",
+           this->scheduler_.get_samples(), this->scheduler_.get_late_samples(),
+           this->scheduler_.get_missed_samples(), this->scheduler_.get_jitter_percentile(50),
+           this->scheduler_.get_jitter_percentile(95), this->scheduler_.get_jitter_percentile(99));
+
+#ifdef USE_ZMOD4510_I2C_STATS
+  if (this->i2c_transactions_sensor_ != nullptr) {
+    this->i2c_transactions_sensor_->publish_state(this->i2c_stats_.get_transactions());
+  }
+  if (this->i2c_errors_sensor_ != nullptr) {
+    this->i2c_errors_sensor_->publish_state(this->i2c_stats_.get_errors());
+  }
+  if (this->i2c_bus_time_sensor_ != nullptr) {
+    uint32_t bus_time_us = this->i2c_stats_.get_bus_time_us();
+    this->i2c_bus_time_sensor_->publish_state((bus_time_us - this->last_bus_time_us_) / 1000.0f);
+    this->last_bus_time_us_ = bus_time_us;
+  }
+#endif
+
+  if (!this->results_valid_) {
+    ESP_LOGD(TAG, "No valid results yet");
     return;
   }
 
-  // Wait for the measurement to complete (6000 ms for NO₂/O₃ mode).
-  delay(6000);
+#ifdef USE_ZMOD4510_PIPELINE_TRACE
+  uint32_t publish_start_us = esphome::micros();
+  // Only the first publish of a result tells how long it waited for the loop.
+  if (!this->results_published_) {
+    this->trace_.record(PipelineTrace::STAGE_PUBLISH_WAIT, publish_start_us - this->results_ready_us_);
+    this->results_published_ = true;
+  }
+#endif
+  this->publish_outputs_(false);
+#ifdef USE_ZMOD4510_PIPELINE_TRACE
+  this->trace_.record(PipelineTrace::STAGE_PUBLISH, esphome::micros() - publish_start_us);
+#endif
+}
 
-  ret = zmod4xxx_read_adc_result(&this->dev_, this->adc_buffer_);
-  if (ret != ZMOD4XXX_OK) {
-    ESP_LOGE(TAG, "zmod4xxx_read_adc_result failed with code %d", ret);
+void ZMOD4510::publish_outputs_(bool sample) {
+  this->publish_(this->no2_sensor_, this->results_.NO2_conc_ppb, sample);
+  this->publish_(this->o3_sensor_, this->results_.O3_conc_ppb, sample);
+  this->publish_(this->aqi_sensor_, static_cast<float>(this->results_.FAST_AQI), sample);
+#ifdef USE_ZMOD4510_EPA_AQI
+  this->publish_(this->epa_aqi_sensor_, static_cast<float>(this->results_.EPA_AQI), sample);
+#endif
+#ifdef USE_ZMOD4510_RMOX
+  for (uint8_t i = 0; i < 4; i++) {
+    this->publish_(this->rmox_sensors_[i], this->results_.rmox[i], sample);
+  }
+#endif
+#ifdef USE_ZMOD4510_COMPENSATION_TEMPERATURE
+  this->publish_(this->compensation_temperature_sensor_, this->results_.temperature, sample);
+#endif
+#ifdef USE_ZMOD4510_AVERAGES
+  this->publish_(this->o3_1h_sensor_, this->algo_handle_.o3_1h_ppb, sample);
+  this->publish_(this->o3_8h_sensor_, this->algo_handle_.o3_8h_ppb, sample);
+  this->publish_(this->no2_1h_sensor_, this->algo_handle_.no2_1h_ppb, sample);
+#endif
+}
+
+void ZMOD4510::publish_(esphome::sensor::Sensor *sensor, float value, bool sample) {
+  if (sensor == nullptr) {
+    return;
+  }
+#ifdef USE_ZMOD4510_PUBLISH_POLICY
+  for (uint8_t i = 0; i < this->num_policies_; i++) {
+    if (this->policies_[i].sensor == sensor) {
+      PublishPolicy &policy = this->policies_[i].policy;
+      if (sample ? policy.on_sample(value, millis()) : policy.on_tick(value, millis())) {
+        sensor->publish_state(value);
+      }
+      return;
+    }
+  }
+#endif
+  if (!sample) {
+    sensor->publish_state(value);
+  }
+}
+
+#ifdef USE_ZMOD4510_PUBLISH_POLICY
+void ZMOD4510::add_publish_policy(esphome::sensor::Sensor *sensor, float deadband, uint32_t max_interval_ms,
+                                  float rate_threshold) {
+  if (this->num_policies_ >= MAX_POLICIES) {
     return;
   }
+  OutputPolicy &entry = this->policies_[this->num_policies_++];
+  entry.sensor = sensor;
+  entry.policy = PublishPolicy(deadband, max_interval_ms, rate_threshold);
+  this->has_rate_policies_ |= entry.policy.has_rate_threshold();
+}
+#endif
+
+int ZMOD4510::read_sample_() {
+#ifdef USE_ZMOD4510_PIPELINE_TRACE
+  uint32_t read_start_us = esphome::micros();
+#endif
+  int ret = this->read_adc_result_();
+  if (ret == ERROR_POR_EVENT) {
+    ESP_LOGW(TAG, "Unexpected sensor reset; discarding sample");
+    this->recover_from_reset_();
+    return ret;
+  }
+  if (ret == ERROR_GAS_TIMEOUT) {
+    ESP_LOGW(TAG, "Measurement still running at its deadline; reading it at the next one");
+    return ret;
+  }
+  if (ret != ZMOD4XXX_OK) {
+    ESP_LOGE(TAG, "Reading ADC result failed with code %d", ret);
+    return ret;
+  }
+#ifdef USE_ZMOD4510_PIPELINE_TRACE
+  // The sequencer is only polled at the deadline, so this spans the sample
+  // period rather than the sequence.
+  this->trace_.record(PipelineTrace::STAGE_MEASUREMENT, read_start_us - this->measurement_start_us_);
+  this->trace_.record(PipelineTrace::STAGE_ADC_READ, esphome::micros() - read_start_us);
+#endif
+  return ZMOD4XXX_OK;
+}
+
+void ZMOD4510::process_sample_() {
+#ifdef USE_ZMOD4510_HSXXXX
+  // Average the ambient readings taken during this window; without new
+  // readings the previous values are kept.
+  if (this->ht_count_ != 0) {
+    this->temperature_ = this->ht_temperature_sum_ / this->ht_count_;
+    this->humidity_ = this->ht_humidity_sum_ / this->ht_count_;
+    this->ht_temperature_sum_ = 0.0f;
+    this->ht_humidity_sum_ = 0.0f;
+    this->ht_count_ = 0;
+  }
+#endif
 
-  // Prepare algorithm input with default ambient conditions.
   no2_o3_inputs_t algo_input;
   algo_input.adc_result = this->adc_buffer_;
-  algo_input.humidity_pct = 50.0f;      // Default: 50% RH
-  algo_input.temperature_degc = 25.0f;  // Default: 25°C
+  algo_input.humidity_pct = this->humidity_;
+  algo_input.temperature_degc = this->temperature_;
+  if (this->source_is_fresh_(this->humidity_source_, this->humidity_updated_ms_)) {
+    algo_input.humidity_pct = this->humidity_source_->state;
+  }
+  if (this->source_is_fresh_(this->temperature_source_, this->temperature_updated_ms_)) {
+    algo_input.temperature_degc = this->temperature_source_->state;
+  }
 
-  no2_o3_results_t algo_results;
-  ret = calc_no2_o3(&this->algo_handle_, &this->dev_, &algo_input, &algo_results);
+#ifdef USE_ZMOD4510_PIPELINE_TRACE
+  uint32_t calc_start_us = esphome::micros();
+#endif
+  int ret = calc_no2_o3(&this->algo_handle_, &this->dev_, &algo_input, &this->results_);
+#ifdef USE_ZMOD4510_PIPELINE_TRACE
+  this->results_ready_us_ = esphome::micros();
+  this->trace_.record(PipelineTrace::STAGE_CALC, this->results_ready_us_ - calc_start_us);
+  this->results_published_ = false;
+#endif
+#ifdef USE_ZMOD4510_RECORDING
+  this->record_sample_(algo_input, ret);
+#endif
   if (ret != NO2_O3_OK) {
     if (ret == NO2_O3_STABILIZATION) {
-      ESP_LOGW(TAG, "Sensor in stabilization phase; ignoring results");
+      ESP_LOGV(TAG, "Sensor in stabilization phase; ignoring results");
     } else {
       ESP_LOGE(TAG, "calc_no2_o3 failed with code %d", ret);
     }
+    this->results_valid_ = false;
+    return;
+  }
+  this->results_valid_ = true;
+#ifdef USE_ZMOD4510_SAMPLE_RECORDS
+  SeriesRecord record{this->timestamp_(),
+                      {this->results_.NO2_conc_ppb, this->results_.O3_conc_ppb, this->results_.rmox[0],
+                       this->results_.rmox[1], this->results_.rmox[2], this->results_.rmox[3]}};
+  this->store_sample_(record);
+#endif
+#ifdef USE_ZMOD4510_JOURNAL
+  this->journal_batch_[this->journal_pending_++] = record;
+  if (this->journal_pending_ >= this->journal_batch_size_) {
+    this->flush_journal();
+  }
+#endif
+#ifdef USE_ZMOD4510_PUBLISH_POLICY
+  if (this->has_rate_policies_) {
+    this->publish_outputs_(true);
+  }
+#endif
+
+  ESP_LOGV(TAG, "Algorithm results: NO2: %.2f ppb, O3: %.2f ppb, FAST AQI: %d",
+           this->results_.NO2_conc_ppb, this->results_.O3_conc_ppb, this->results_.FAST_AQI);
+}
+
+#ifdef USE_ZMOD4510_SAMPLE_RECORDS
+uint32_t ZMOD4510::timestamp_() { return this->uptime_s_() + this->clock_offset_s_; }
+
+uint32_t ZMOD4510::uptime_s_() {
+  uint32_t now = millis();
+  if (now < this->last_millis_) {
+    this->millis_wraps_++;
+  }
+  this->last_millis_ = now;
+  return uint32_t(((uint64_t(this->millis_wraps_) << 32) | now) / 1000);
+}
+
+void ZMOD4510::store_sample_(const SeriesRecord &record) {
+#ifdef USE_ZMOD4510_HISTORY
+#ifdef USE_ZMOD4510_HISTORY_EXPORT
+  esphome::LockGuard guard(this->history_lock_);
+#endif
+  this->history_.add(record.timestamp, record.values);
+#endif
+#ifdef USE_ZMOD4510_COMPRESSED_HISTORY
+  this->compressed_history_.add(record);
+#endif
+}
+#endif
+
+#ifdef USE_ZMOD4510_JOURNAL
+void ZMOD4510::restore_journal_() {
+#ifdef USE_ESP32
+  this->journal_storage_.reset(new PartitionStorage(this->journal_partition_));
+#else
+  this->journal_storage_.reset(new FileStorage(this->journal_path_, this->journal_size_));
+#endif
+  this->journal_.reset(new FlashJournal(this->journal_storage_.get()));
+  uint32_t start_us = esphome::micros();
+  if (!this->journal_->mount()) {
+    ESP_LOGW(TAG, "History journal storage not available");
+    this->journal_.reset();
+    return;
+  }
+  uint32_t mount_us = esphome::micros() - start_us;
+
+  uint32_t restored = 0;
+  uint32_t last_timestamp = 0;
+  this->journal_->for_each([this, &restored, &last_timestamp](const uint8_t *data, size_t len) {
+    for (size_t offset = 0; offset + sizeof(SeriesRecord) <= len; offset += sizeof(SeriesRecord)) {
+      SeriesRecord record;
+      memcpy(&record, data + offset, sizeof(record));
+      this->store_sample_(record);
+      last_timestamp = record.timestamp;
+      restored++;
+    }
+  });
+  // Continue the sample clock after the last journaled sample, so timestamps
+  // stay monotonic across reboots.
+  if (restored != 0) {
+    this->clock_offset_s_ = last_timestamp + ZMOD4510_NO2_O3_SAMPLE_TIME / 1000 - this->uptime_s_();
+  }
+  ESP_LOGI(TAG, "Journal: %u segments, sequence %u, mounted in %u us, restored %u samples in %u us",
+           this->journal_->get_num_segments(), this->journal_->get_sequence(), mount_us, restored,
+           esphome::micros() - start_us);
+}
+
+void ZMOD4510::flush_journal() {
+  if (this->journal_pending_ == 0) {
     return;
   }
+  if (this->journal_ != nullptr &&
+      !this->journal_->append(this->journal_batch_, this->journal_pending_ * sizeof(SeriesRecord))) {
+    ESP_LOGW(TAG, "Failed to write %u samples to the journal", this->journal_pending_);
+  }
+  this->journal_pending_ = 0;
+}
+#endif
 
-  ESP_LOGD(TAG, "Algorithm results: NO2: %.2f ppb, O3: %.2f ppb, FAST AQI: %d",
-           algo_results.NO2_conc_ppb, algo_results.O3_conc_ppb, algo_results.FAST_AQI);
+#ifdef USE_ZMOD4510_HISTORY_EXPORT
+size_t ZMOD4510::read_history_export(HistoryExport &state, uint8_t *buffer, size_t len) {
+  esphome::LockGuard guard(this->history_lock_);
+  return state.read(this->history_, buffer, len);
+}
+#endif
 
-  if (this->no2_sensor_ != nullptr) {
-    this->no2_sensor_->publish_state(algo_results.NO2_conc_ppb);
+#ifdef USE_ZMOD4510_EXPORT_UART
+void ZMOD4510::poll_export_uart_() {
+  if (this->uart_export_ != nullptr) {
+    // A small chunk per loop() keeps the UART from stalling the main loop.
+    uint8_t buffer[64];
+    size_t len = this->read_history_export(*this->uart_export_, buffer, sizeof(buffer));
+    if (len != 0) {
+      this->export_uart_->write_array(buffer, len);
+    } else {
+      ESP_LOGD(TAG, "UART history export done, %u entries", this->uart_export_->get_entries());
+      this->uart_export_.reset();
+    }
+    return;
+  }
+
+  uint8_t c;
+  while (this->export_uart_->available() && this->export_uart_->read_byte(&c)) {
+    if (c == '\r') {
+      continue;
+    }
+    if (c != '\n') {
+      if (this->command_len_ < sizeof(this->command_) - 1) {
+        this->command_[this->command_len_++] = c;
+      }
+      continue;
+    }
+    this->command_[this->command_len_] = '\0';
+    this->command_len_ = 0;
+
+    char format_name[8];
+    char resolution_name[8];
+    unsigned from = 0;
+    unsigned to = UINT32_MAX;
+    HistoryExport::Format format;
+    SampleHistory::Resolution resolution;
+    if (sscanf(this->command_, "history %7s %7s %u %u", format_name, resolution_name, &from, &to) < 2 ||
+        !HistoryExport::parse_format(format_name, format) ||
+        !HistoryExport::parse_resolution(resolution_name, resolution)) {
+      this->export_uart_->write_str("usage: history <csv|bin> <raw|minute|hour|day> [from] [to]\n");
+      continue;
+    }
+    this->uart_export_.reset(new HistoryExport(format, resolution, from, to));
+    return;
+  }
+}
+#endif
+
+#ifdef USE_ZMOD4510_RECORDING
+void ZMOD4510::start_recording_() {
+#ifdef USE_ZMOD4510_RECORDING_UART
+  if (this->recording_uart_ != nullptr) {
+    this->recording_sink_.reset(new UARTRecordingSink(this->recording_uart_));
+  }
+#endif
+#ifdef USE_ZMOD4510_RECORDING_TCP
+  if (this->recording_port_ != 0) {
+    auto *sink = new TCPRecordingSink(this->recording_port_);
+    this->recording_sink_.reset(sink);
+    if (!sink->start()) {
+      ESP_LOGW(TAG, "Could not listen on port %u for recordings", this->recording_port_);
+    }
+  }
+#endif
+  if (this->recording_sink_ != nullptr) {
+    this->recording_.init(this->recording_sink_.get(), this->recording_block_rows_, ZMOD4510_NO2_O3_SAMPLE_TIME);
+    this->recording_.set_calibration(this->dev_.pid, this->dev_.mox_lr, this->dev_.mox_er, this->dev_.config,
+                                     this->prod_data_, ZMOD4510_PROD_DATA_LEN);
+    ESP_LOGD(TAG, "Recording blocks of %u samples, %u bytes", this->recording_block_rows_,
+             (unsigned) this->recording_.get_block_size());
+  }
+}
+
+void ZMOD4510::record_sample_(const no2_o3_inputs_t &input, int algo_ret) {
+  RecordingRow row;
+  row.timestamp_ms = millis();
+  memcpy(row.adc_result, input.adc_result, sizeof(row.adc_result));
+  row.humidity = input.humidity_pct;
+  row.temperature = input.temperature_degc;
+  memcpy(row.rmox, this->results_.rmox, sizeof(row.rmox));
+  row.no2 = this->results_.NO2_conc_ppb;
+  row.o3 = this->results_.O3_conc_ppb;
+  row.fast_aqi = this->results_.FAST_AQI;
+  row.epa_aqi = this->results_.EPA_AQI;
+  row.compensation_temperature = this->results_.temperature;
+  row.algo_status = algo_ret;
+  row.sensor_status = this->sample_status_;
+  row.read_retries = this->sample_retries_;
+  row.flags = 0;
+  if (algo_ret == NO2_O3_STABILIZATION) {
+    row.flags |= recording::FLAG_STABILIZATION;
+  }
+  if (algo_ret == NO2_O3_DAMAGE) {
+    row.flags |= recording::FLAG_DAMAGE;
+  }
+  if (this->sample_retries_ != 0) {
+    row.flags |= recording::FLAG_READ_RETRIED;
+  }
+  if (this->sample_after_reset_) {
+    row.flags |= recording::FLAG_AFTER_RESET;
+  }
+  if (this->source_is_fresh_(this->humidity_source_, this->humidity_updated_ms_)) {
+    row.flags |= recording::FLAG_EXTERNAL_HUMIDITY;
   }
-  if (this->o3_sensor_ != nullptr) {
-    this->o3_sensor_->publish_state(algo_results.O3_conc_ppb);
+  if (this->source_is_fresh_(this->temperature_source_, this->temperature_updated_ms_)) {
+    row.flags |= recording::FLAG_EXTERNAL_TEMPERATURE;
   }
-  if (this->aqi_sensor_ != nullptr) {
-    this->aqi_sensor_->publish_state(static_cast<float>(algo_results.FAST_AQI));
+  this->sample_after_reset_ = false;
+  this->recording_.add(row);
+}
+#endif
+
+#if defined(USE_ZMOD4510_JOURNAL) || defined(USE_ZMOD4510_RECORDING)
+void ZMOD4510::on_shutdown() {
+#ifdef USE_ZMOD4510_JOURNAL
+  this->flush_journal();
+#endif
+#ifdef USE_ZMOD4510_RECORDING
+  if (this->recording_sink_ != nullptr) {
+    this->recording_.flush();
   }
+#endif
 }
+#endif
+
+bool ZMOD4510::source_is_fresh_(esphome::sensor::Sensor *source, uint32_t updated_ms) const {
+  if (source == nullptr || !source->has_state() || std::isnan(source->state)) {
+    return false;
+  }
+  return millis() - updated_ms <= this->source_timeout_ms_;
+}
+
+#ifdef USE_ZMOD4510_HSXXXX
+void ZMOD4510::poll_ambient_() {
+  if (this->ht_sensor_ == nullptr) {
+    return;
+  }
+  uint32_t now = millis();
+
+  if (this->ht_converting_) {
+    if (now - this->ht_started_ms_ <= static_cast<uint32_t>(HSxxxx_MeasurementDuration(this->ht_sensor_))) {
+      return;
+    }
+    this->ht_converting_ = false;
+    HSxxxx_Results_t results;
+    int ret = HSxxxx_MeasureRead(this->ht_sensor_, &results);
+    if (ret != 0) {
+      ESP_LOGV(TAG, "HSxxxx_MeasureRead failed with code %d", ret);
+      return;
+    }
+    this->ht_temperature_sum_ += results.temperature;
+    this->ht_humidity_sum_ += results.humidity;
+    this->ht_count_++;
+    return;
+  }
+
+  if (static_cast<int32_t>(now - this->ht_next_ms_) < 0) {
+    return;
+  }
+  this->ht_next_ms_ += AMBIENT_INTERVAL_MS;
+  if (static_cast<int32_t>(now - this->ht_next_ms_) >= 0) {
+    this->ht_next_ms_ = now + AMBIENT_INTERVAL_MS;
+  }
+  int ret = HSxxxx_MeasureStart(this->ht_sensor_);
+  if (ret != 0) {
+    ESP_LOGV(TAG, "HSxxxx_MeasureStart failed with code %d", ret);
+    return;
+  }
+  this->ht_converting_ = true;
+  this->ht_started_ms_ = now;
+}
+#endif
+
+int ZMOD4510::read_adc_result_() {
+  uint8_t status;
+  int ret = zmod4xxx_read_status(&this->dev_, &status);
+  if (ret != ZMOD4XXX_OK) {
+    return ret;
+  }
+#ifdef USE_ZMOD4510_RECORDING
+  this->sample_status_ = status;
+  this->sample_retries_ = 0;
+#endif
+  // A sequencer that is still running after the sample time either points to
+  // a reset during the measurement or to a read that came too early, after a
+  // measurement that was started late.
+  if (status & STATUS_SEQUENCER_RUNNING_MASK) {
+    ret = zmod4xxx_check_error_event(&this->dev_);
+    if (ret != ZMOD4XXX_OK) {
+      return ret;
+    }
+    return ERROR_GAS_TIMEOUT;
+  }
+
+  for (uint8_t attempt = 0;; attempt++) {
+    ret = zmod4xxx_read_adc_result(&this->dev_, this->adc_buffer_);
+    if (ret != ZMOD4XXX_OK) {
+      return ret;
+    }
+    ret = zmod4xxx_check_error_event(&this->dev_);
+    if (ret != ERROR_ACCESS_CONFLICT || attempt >= MAX_READ_RETRIES) {
+      return ret;
+    }
+    // Only the read is invalid; the measurement itself is fine, so wait for
+    // the sequencer and read the same result again.
+    this->access_conflicts_++;
+#ifdef USE_ZMOD4510_RECORDING
+    this->sample_retries_++;
+#endif
+    ESP_LOGW(TAG, "Access conflict while reading ADC result, retrying (%u)", attempt + 1);
+    this->dev_.delay_ms(READ_RETRY_DELAY_MS);
+  }
+}
+
+void ZMOD4510::recover_from_reset_() {
+  if (!this->recovery_pending_) {
+    this->recovery_started_ms_ = millis();
+  }
+  this->recovery_pending_ = false;
+  this->measuring_ = false;
+  // Sensor info (config, prod_data) is non-volatile and still valid in dev_,
+  // so only the init sequence and the measurement configuration are redone.
+  if (!this->start_init_sequence_(BRING_UP_RECOVER)) {
+    this->bring_up_ = BRING_UP_DONE;
+    this->recovery_pending_ = true;
+  }
+}
+
+void ZMOD4510::finish_recovery_(int ret) {
+  this->bring_up_ = BRING_UP_DONE;
+  if (ret == ZMOD4XXX_OK) {
+    ret = zmod4xxx_init_sensor_finish(&this->dev_);
+  }
+  if (ret != ZMOD4XXX_OK) {
+    ESP_LOGE(TAG, "zmod4xxx_init_sensor failed with code %d during recovery", ret);
+    this->recovery_pending_ = true;
+    return;
+  }
+  ret = zmod4xxx_init_measurement(&this->dev_);
+  if (ret != ZMOD4XXX_OK) {
+    ESP_LOGE(TAG, "zmod4xxx_init_measurement failed with code %d during recovery", ret);
+    this->recovery_pending_ = true;
+    return;
+  }
+
+  this->last_recovery_ms_ = millis() - this->recovery_started_ms_;
+  this->reset_recoveries_++;
+#ifdef USE_ZMOD4510_RECORDING
+  this->sample_after_reset_ = true;
+#endif
+  ESP_LOGI(TAG, "Recovered from sensor reset in %u ms (%u recoveries, %u access conflicts)",
+           this->last_recovery_ms_, this->reset_recoveries_, this->access_conflicts_);
+}
+
+#ifdef USE_ZMOD4510_PIPELINE_TRACE
+void ZMOD4510::dump_pipeline_trace() {
+  for (uint8_t i = 0; i < PipelineTrace::NUM_STAGES; i++) {
+    auto stage = static_cast<PipelineTrace::Stage>(i);
+    ESP_LOGI(TAG, "%-12s: %u samples, last %u us, p50 < %u us, p95 < %u us, max %u us",
+             PipelineTrace::get_stage_name(stage), this->trace_.get_count(stage), this->trace_.get_last(stage),
+             this->trace_.get_percentile(stage, 50), this->trace_.get_percentile(stage, 95),
+             this->trace_.get_max(stage));
+  }
+}
+#endif
+
+#ifdef USE_ZMOD4510_I2C_TRACE
+void ZMOD4510::dump_i2c_trace() {
+  const uint8_t *data = this->i2c_trace_.get_data();
+  size_t size = this->i2c_trace_.get_size();
+  ESP_LOGI(TAG, "I2C trace: %u events, %u bytes%s", this->i2c_trace_.get_events(), (unsigned) size,
+           this->i2c_trace_.is_full() ? " (buffer full, recording stopped)" : "");
+  char line[2 * 32 + 1];
+  for (size_t offset = 0; offset < size; offset += 32) {
+    size_t n = size - offset < 32 ? size - offset : 32;
+    for (size_t i = 0; i < n; i++) {
+      snprintf(line + 2 * i, 3, "%02X", data[offset + i]);
+    }
+    ESP_LOGI(TAG, "TRACE %06X %s", (unsigned) offset, line);
+  }
+}
+#endif
+
+#ifdef USE_ZMOD4510_I2C_STATS
+void ZMOD4510::dump_i2c_stats() {
+  ESP_LOGI(TAG, "I2C: %u transactions, %u bytes, %u errors, %u us on the bus", this->i2c_stats_.get_transactions(),
+           this->i2c_stats_.get_bytes(), this->i2c_stats_.get_errors(), this->i2c_stats_.get_bus_time_us());
+  for (uint8_t code = 1; code < I2CStats::NUM_ERROR_CODES; code++) {
+    if (this->i2c_stats_.get_error_count(code) != 0) {
+      ESP_LOGI(TAG, "  error code %u: %u", code, this->i2c_stats_.get_error_count(code));
+    }
+  }
+  if (this->i2c_stats_.get_error_count(0) != 0) {
+    ESP_LOGI(TAG, "  other errors: %u", this->i2c_stats_.get_error_count(0));
+  }
+  for (uint8_t i = 0; i < this->i2c_stats_.get_slot_count(); i++) {
+    const I2CStats::Slot &slot = this->i2c_stats_.get_slot(i);
+    uint32_t count = slot.reads + slot.writes;
+    if (slot.slave == I2CStats::OTHER_SLAVE) {
+      ESP_LOGI(TAG, "  other: %u rd, %u wr, %u bytes, %u err, avg %u us, max %u us", slot.reads, slot.writes,
+               slot.bytes, slot.errors, count ? slot.total_us / count : 0, slot.max_us);
+    } else {
+      ESP_LOGI(TAG, "  0x%02X/0x%02X: %u rd, %u wr, %u bytes, %u err, avg %u us, max %u us", slot.slave, slot.reg,
+               slot.reads, slot.writes, slot.bytes, slot.errors, count ? slot.total_us / count : 0, slot.max_us);
+    }
+    for (uint8_t b = 0; b < I2CStats::NUM_LATENCY_BUCKETS; b++) {
+      if (slot.latency[b] == 0) {
+        continue;
+      }
+      if (I2CStats::get_latency_bound(b) != 0) {
+        ESP_LOGI(TAG, "    < %u us: %u", I2CStats::get_latency_bound(b), slot.latency[b]);
+      } else {
+        ESP_LOGI(TAG, "    >= %u us: %u", I2CStats::get_latency_bound(b - 1), slot.latency[b]);
+      }
+    }
+  }
+}
+#endif
 
 }  // namespace zmod4510
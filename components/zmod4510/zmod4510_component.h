@@ -4,6 +4,52 @@
 #include "esphome/components/i2c/i2c.h"
 #include "esphome/components/sensor/sensor.h"
 #include <cstring>  // For memcpy
+#include "sample_scheduler.h"
+#include "esphome_hal.h"
+#ifdef USE_ZMOD4510_BUS_SCHEDULER
+#include "bus_scheduler.h"
+#endif
+#ifdef USE_ZMOD4510_I2C_STATS
+#include "i2c_stats.h"
+#endif
+#ifdef USE_ZMOD4510_I2C_TRACE
+#include "i2c_trace.h"
+#include <memory>
+#endif
+#ifdef USE_ZMOD4510_PIPELINE_TRACE
+#include "pipeline_trace.h"
+#endif
+#ifdef USE_ZMOD4510_PUBLISH_POLICY
+#include "publish_policy.h"
+#endif
+#ifdef USE_ZMOD4510_HISTORY
+#include "sample_history.h"
+#endif
+#ifdef USE_ZMOD4510_COMPRESSED_HISTORY
+#include "compressed_series.h"
+#endif
+#ifdef USE_ZMOD4510_SAMPLE_RECORDS
+#include "sample_record.h"
+#endif
+#ifdef USE_ZMOD4510_JOURNAL
+#include "flash_journal.h"
+#include <memory>
+#endif
+#ifdef USE_ZMOD4510_HISTORY_EXPORT
+#include "history_export.h"
+#include "esphome/core/helpers.h"
+#include <memory>
+#endif
+#ifdef USE_ZMOD4510_EXPORT_WEB
+#include "history_web_handler.h"
+#endif
+#ifdef USE_ZMOD4510_RECORDING
+#include "recording_sinks.h"
+#include <memory>
+#endif
+#ifdef USE_ZMOD4510_EXPORT_UART
+#include "esphome/components/uart/uart.h"
+#endif
 
 // Wrap Renesas C headers in extern "C" to avoid C++ name mangling.
 extern "C" {
@@ -13,7 +59,12 @@ extern "C" {
   #include "zmod4xxx.h"
   #include "no2_o3.h"
   #include "zmod4510_config_no2_o3.h"
+#ifdef USE_ZMOD4510_CLEANING
   #include "zmod4xxx_cleaning.h"
+#endif
+#ifdef USE_ZMOD4510_HSXXXX
+  #include "hsxxxx.h"
+#endif
 }
 
 namespace zmod4510 {
@@ -21,29 +72,354 @@ namespace zmod4510 {
 class ZMOD4510 : public esphome::PollingComponent, public esphome::i2c::I2CDevice {
  public:
   ZMOD4510();
+  ~ZMOD4510();
 
   void set_i2c_address(uint8_t address);
   void set_no2_sensor(esphome::sensor::Sensor *sensor);
   void set_o3_sensor(esphome::sensor::Sensor *sensor);
   void set_aqi_sensor(esphome::sensor::Sensor *sensor);
+#ifdef USE_ZMOD4510_EPA_AQI
+  void set_epa_aqi_sensor(esphome::sensor::Sensor *sensor) { this->epa_aqi_sensor_ = sensor; }
+#endif
+#ifdef USE_ZMOD4510_RMOX
+  void set_rmox_sensor(uint8_t index, esphome::sensor::Sensor *sensor) { this->rmox_sensors_[index] = sensor; }
+#endif
+#ifdef USE_ZMOD4510_COMPENSATION_TEMPERATURE
+  void set_compensation_temperature_sensor(esphome::sensor::Sensor *sensor) {
+    this->compensation_temperature_sensor_ = sensor;
+  }
+#endif
+#ifdef USE_ZMOD4510_AVERAGES
+  void set_o3_1h_sensor(esphome::sensor::Sensor *sensor) { this->o3_1h_sensor_ = sensor; }
+  void set_o3_8h_sensor(esphome::sensor::Sensor *sensor) { this->o3_8h_sensor_ = sensor; }
+  void set_no2_1h_sensor(esphome::sensor::Sensor *sensor) { this->no2_1h_sensor_ = sensor; }
+#endif
+#ifdef USE_ZMOD4510_PUBLISH_POLICY
+  // Attach a deadband/heartbeat/rate-of-change policy to one of the outputs.
+  void add_publish_policy(esphome::sensor::Sensor *sensor, float deadband, uint32_t max_interval_ms,
+                          float rate_threshold);
+#endif
+  void set_temperature_source(esphome::sensor::Sensor *source) { this->temperature_source_ = source; }
+  void set_humidity_source(esphome::sensor::Sensor *source) { this->humidity_source_ = source; }
+  void set_source_timeout(uint32_t timeout_ms) { this->source_timeout_ms_ = timeout_ms; }
+
+  // Recovery statistics since boot. The recovery time runs from detecting a
+  // sensor reset to the sensor being ready to measure again.
+  uint32_t get_reset_recoveries() const { return this->reset_recoveries_; }
+  uint32_t get_access_conflicts() const { return this->access_conflicts_; }
+  uint32_t get_last_recovery_ms() const { return this->last_recovery_ms_; }
+#ifdef USE_ZMOD4510_BUS_SCHEDULER
+  // Run the measurement cycles on a phase of a scheduler shared with the other
+  // devices on the bus.
+  void set_bus_scheduler(BusScheduler *bus_scheduler) { this->bus_scheduler_ = bus_scheduler; }
+#endif
+#ifdef USE_ZMOD4510_I2C_STATS
+  void set_i2c_transactions_sensor(esphome::sensor::Sensor *sensor) { this->i2c_transactions_sensor_ = sensor; }
+  void set_i2c_errors_sensor(esphome::sensor::Sensor *sensor) { this->i2c_errors_sensor_ = sensor; }
+  void set_i2c_bus_time_sensor(esphome::sensor::Sensor *sensor) { this->i2c_bus_time_sensor_ = sensor; }
+  // Log the per-register I2C statistics, e.g. from a button lambda.
+  void dump_i2c_stats();
+#endif
+#ifdef USE_ZMOD4510_I2C_TRACE
+  void set_i2c_trace_size(uint32_t size) { this->i2c_trace_size_ = size; }
+  const I2CTraceRecorder &get_i2c_trace() const { return this->i2c_trace_; }
+  // Log the I2C trace recorded since boot as hex, for replay on a host.
+  void dump_i2c_trace();
+#endif
+#ifdef USE_ZMOD4510_PIPELINE_TRACE
+  // Log the per-stage pipeline durations, e.g. from a button lambda.
+  void dump_pipeline_trace();
+#endif
+#ifdef USE_ZMOD4510_HISTORY
+  // Retention per resolution; the storage is allocated once in setup().
+  void set_history_size(uint32_t raw_ms, uint16_t minutes, uint16_t hours, uint16_t days) {
+    this->history_raw_ms_ = raw_ms;
+    this->history_minutes_ = minutes;
+    this->history_hours_ = hours;
+    this->history_days_ = days;
+  }
+  // NO2/O3 history keyed by sample time in seconds (see timestamp_()).
+  const SampleHistory &get_history() const { return this->history_; }
+#endif
+#ifdef USE_ZMOD4510_COMPRESSED_HISTORY
+  void set_compressed_history(uint16_t blocks, uint8_t mantissa_bits) {
+    this->compressed_blocks_ = blocks;
+    this->compressed_mantissa_bits_ = mantissa_bits;
+  }
+  // Full-rate NO2/O3/Rmox records keyed by sample time in seconds.
+  const CompressedHistory &get_compressed_history() const { return this->compressed_history_; }
+#endif
+#ifdef USE_ZMOD4510_HISTORY_EXPORT
+  // Render the next part of `state` into `buffer`; safe to call from the web
+  // server task. Returns 0 once the export is complete.
+  size_t read_history_export(HistoryExport &state, uint8_t *buffer, size_t len);
+#endif
+#ifdef USE_ZMOD4510_EXPORT_WEB
+  void set_web_server_base(esphome::web_server_base::WebServerBase *base) { this->web_server_base_ = base; }
+#endif
+#ifdef USE_ZMOD4510_EXPORT_UART
+  // Accepts "history <csv|bin> <raw|minute|hour|day> [from] [to]" lines.
+  void set_export_uart(esphome::uart::UARTComponent *uart) { this->export_uart_ = uart; }
+#endif
+#ifdef USE_ZMOD4510_RECORDING
+  // Stream every measurement (raw frame, inputs, results, flags) to a UART or
+  // to TCP clients on `port`, `block_rows` measurements per block.
+#ifdef USE_ZMOD4510_RECORDING_UART
+  void set_recording_uart(esphome::uart::UARTComponent *uart) { this->recording_uart_ = uart; }
+#endif
+#ifdef USE_ZMOD4510_RECORDING_TCP
+  void set_recording_port(uint16_t port) { this->recording_port_ = port; }
+#endif
+  void set_recording_block_rows(uint16_t rows) { this->recording_block_rows_ = rows; }
+#endif
+#ifdef USE_ZMOD4510_JOURNAL
+  // Flash partition label on ESP32; backing file and its size on other platforms.
+  void set_journal_partition(const char *partition) { this->journal_partition_ = partition; }
+  void set_journal_file(const char *path, uint32_t size) {
+    this->journal_path_ = path;
+    this->journal_size_ = size;
+  }
+  void set_journal_batch_size(uint8_t batch_size) { this->journal_batch_size_ = batch_size; }
+  // Write the pending batch to flash, e.g. before a planned restart.
+  void flush_journal();
+#endif
 
   void setup() override;
+  void loop() override;
   void update() override;
+#if defined(USE_ZMOD4510_JOURNAL) || defined(USE_ZMOD4510_RECORDING)
+  void on_shutdown() override;
+#endif
 
  protected:
+  // Bring-up after setup(): the init sequence, the second one of
+  // zmod4xxx_prepare_sensor() and the settle time after it, polled from loop().
+  // BRING_UP_RECOVER re-runs the init sequence after a sensor reset.
+  enum BringUpState : uint8_t { BRING_UP_INIT, BRING_UP_PREPARE, BRING_UP_SETTLE, BRING_UP_RECOVER, BRING_UP_DONE };
+
+  // Returns false if the sequence could not be started.
+  bool start_init_sequence_(BringUpState state);
+  // Returns true once the running init sequence has ended; `ret` holds its outcome.
+  bool poll_init_sequence_(uint32_t now, int &ret);
+  void poll_bring_up_();
+  // Start the measurement schedule, shared or independent.
+  void start_measuring_();
+  // Read the last sample, start the next measurement and process the sample.
+  void run_cycle_();
+  // Read the finished measurement; returns ZMOD4XXX_OK if adc_buffer_ holds a
+  // valid sample, ERROR_GAS_TIMEOUT if the measurement is still running.
+  int read_sample_();
+  // Run the algorithm on adc_buffer_ and keep the results for the next update().
+  void process_sample_();
+  // Offer the latest results to all outputs, either on the update() tick or
+  // right after a new sample (only rate-of-change policies act on those).
+  void publish_outputs_(bool sample);
+  void publish_(esphome::sensor::Sensor *sensor, float value, bool sample);
+#ifdef USE_ZMOD4510_SAMPLE_RECORDS
+  // Sample time in seconds: uptime, continued from the journal after a reboot.
+  uint32_t timestamp_();
+  // Uptime in seconds, counting on where millis() wraps after 49.7 days.
+  // Needs a call at least once per wrap, which loop() makes.
+  uint32_t uptime_s_();
+  // Add a record to the in-memory history stores.
+  void store_sample_(const SeriesRecord &record);
+#endif
+#ifdef USE_ZMOD4510_EXPORT_UART
+  // Read command lines and send the running export a chunk per loop().
+  void poll_export_uart_();
+#endif
+#ifdef USE_ZMOD4510_RECORDING
+  void start_recording_();
+  void record_sample_(const no2_o3_inputs_t &input, int algo_ret);
+#endif
+#ifdef USE_ZMOD4510_JOURNAL
+  // Mount the journal and load its records into the history stores.
+  void restore_journal_();
+#endif
+#ifdef USE_ZMOD4510_HSXXXX
+  // Advance the HSxxxx start/read cycle; never waits for a conversion.
+  void poll_ambient_();
+#endif
+  // True if `source` has published a usable value within source_timeout_ms_.
+  bool source_is_fresh_(esphome::sensor::Sensor *source, uint32_t updated_ms) const;
+  // Read the ADC result, re-reading it if the sensor flags an access conflict.
+  // Returns ERROR_GAS_TIMEOUT without reading while the sequencer runs.
+  int read_adc_result_();
+  // Start re-running the sensor init sequence after a POR event; loop() polls
+  // it like the bring-up. The algorithm handle is left untouched so the
+  // averaging windows survive the reset.
+  void recover_from_reset_();
+  // Finish a recovery whose init sequence ended with `ret`.
+  void finish_recovery_(int ret);
+
   uint8_t i2c_address_;
   esphome::sensor::Sensor *no2_sensor_{nullptr};
   esphome::sensor::Sensor *o3_sensor_{nullptr};
   esphome::sensor::Sensor *aqi_sensor_{nullptr};
+  // Additional outputs; each group is only compiled in when configured.
+#ifdef USE_ZMOD4510_EPA_AQI
+  esphome::sensor::Sensor *epa_aqi_sensor_{nullptr};
+#endif
+#ifdef USE_ZMOD4510_RMOX
+  esphome::sensor::Sensor *rmox_sensors_[4]{};
+#endif
+#ifdef USE_ZMOD4510_COMPENSATION_TEMPERATURE
+  esphome::sensor::Sensor *compensation_temperature_sensor_{nullptr};
+#endif
+#ifdef USE_ZMOD4510_AVERAGES
+  esphome::sensor::Sensor *o3_1h_sensor_{nullptr};
+  esphome::sensor::Sensor *o3_8h_sensor_{nullptr};
+  esphome::sensor::Sensor *no2_1h_sensor_{nullptr};
+#endif
+
+#ifdef USE_ZMOD4510_PUBLISH_POLICY
+  static const uint8_t MAX_POLICIES = 12;
+  struct OutputPolicy {
+    esphome::sensor::Sensor *sensor;
+    PublishPolicy policy;
+  };
+  OutputPolicy policies_[MAX_POLICIES];
+  uint8_t num_policies_{0};
+  bool has_rate_policies_{false};
+#endif
+
+  // HAL objects: bus_hal_ talks to the ESPHome bus, hal_ is what the drivers use.
+  Interface_t bus_hal_;
+  Interface_t hal_;
+#ifdef USE_ZMOD4510_I2C_STATS
+  I2CStats i2c_stats_;
+  uint32_t last_bus_time_us_{0};
+  esphome::sensor::Sensor *i2c_transactions_sensor_{nullptr};
+  esphome::sensor::Sensor *i2c_errors_sensor_{nullptr};
+  esphome::sensor::Sensor *i2c_bus_time_sensor_{nullptr};
+#endif
+#ifdef USE_ZMOD4510_I2C_TRACE
+  // Statistics (if enabled) sit below the trace so it records bus traffic only.
+  Interface_t trace_inner_hal_;
+  I2CTraceRecorder i2c_trace_;
+  std::unique_ptr<uint8_t[]> i2c_trace_buffer_;
+  uint32_t i2c_trace_size_{4096};
+#endif
 
   // Renesas device structure and algorithm state.
   zmod4xxx_dev_t dev_;
   no2_o3_handle_t algo_handle_;
 
-  // Buffers for configuration and ADC measurement data.
-  uint8_t config_[6];
+  // Buffers for production and ADC measurement data.
   uint8_t prod_data_[ZMOD4510_PROD_DATA_LEN];  // From config header.
   uint8_t adc_buffer_[32];                     // Based on ADC data length.
+
+  // Measurements run back to back on the algorithm's fixed sample time; update()
+  // only publishes the latest results.
+  SampleScheduler scheduler_{ZMOD4510_NO2_O3_SAMPLE_TIME};
+  bool measuring_{false};
+  BringUpState bring_up_{BRING_UP_INIT};
+  uint32_t bring_up_started_ms_{0};
+  uint32_t bring_up_next_ms_{0};
+  uint32_t bring_up_polls_{0};
+  uint32_t bring_up_step_ms_{0};
+#ifdef USE_ZMOD4510_BUS_SCHEDULER
+  BusScheduler *bus_scheduler_{nullptr};
+#endif
+  no2_o3_results_t results_;
+  bool results_valid_{false};
+
+#ifdef USE_ZMOD4510_PIPELINE_TRACE
+  PipelineTrace trace_;
+  uint32_t measurement_start_us_{0};
+  uint32_t results_ready_us_{0};
+  bool results_published_{true};
+#endif
+
+#ifdef USE_ZMOD4510_HISTORY
+  SampleHistory history_;
+  uint32_t history_raw_ms_{600000};
+  uint16_t history_minutes_{60};
+  uint16_t history_hours_{48};
+  uint16_t history_days_{14};
+#endif
+#ifdef USE_ZMOD4510_COMPRESSED_HISTORY
+  static const size_t COMPRESSED_BLOCK_SIZE = 1024;
+  CompressedHistory compressed_history_;
+  uint16_t compressed_blocks_{16};
+  uint8_t compressed_mantissa_bits_{23};
+#endif
+#ifdef USE_ZMOD4510_SAMPLE_RECORDS
+  uint32_t clock_offset_s_{0};
+  uint32_t last_millis_{0};
+  uint32_t millis_wraps_{0};
+#endif
+#ifdef USE_ZMOD4510_HISTORY_EXPORT
+  // Guards history_ against exports running on another task.
+  esphome::Mutex history_lock_;
+#endif
+#ifdef USE_ZMOD4510_EXPORT_WEB
+  esphome::web_server_base::WebServerBase *web_server_base_{nullptr};
+#endif
+#ifdef USE_ZMOD4510_EXPORT_UART
+  esphome::uart::UARTComponent *export_uart_{nullptr};
+  std::unique_ptr<HistoryExport> uart_export_;
+  char command_[48];
+  uint8_t command_len_{0};
+#endif
+#ifdef USE_ZMOD4510_JOURNAL
+  static const uint8_t MAX_JOURNAL_BATCH = FlashJournal::MAX_BATCH / sizeof(SeriesRecord);
+  const char *journal_partition_{"zmod4510"};
+  const char *journal_path_{"zmod4510_journal.bin"};
+  uint32_t journal_size_{65536};
+  std::unique_ptr<JournalStorage> journal_storage_;
+  std::unique_ptr<FlashJournal> journal_;
+  SeriesRecord journal_batch_[MAX_JOURNAL_BATCH];
+  uint8_t journal_batch_size_{10};
+  uint8_t journal_pending_{0};
+#endif
+
+#ifdef USE_ZMOD4510_HSXXXX
+  // Optional HS3xxx/HS4xxx ambient sensor. It is sampled several times per
+  // measurement window and the average feeds the algorithm.
+  HSxxxx_t hs_;
+  HSxxxx_t *ht_sensor_{nullptr};
+  bool ht_converting_{false};
+  uint32_t ht_started_ms_{0};
+  uint32_t ht_next_ms_{0};
+  float ht_temperature_sum_{0.0f};
+  float ht_humidity_sum_{0.0f};
+  uint8_t ht_count_{0};
+#endif
+  // -300 °C makes the algorithm use the on-chip temperature measurement.
+  float temperature_{-300.0f};
+  float humidity_{50.0f};  // Default: 50% RH
+
+  // Ambient values from other ESPHome sensors take precedence while fresh.
+  esphome::sensor::Sensor *temperature_source_{nullptr};
+  esphome::sensor::Sensor *humidity_source_{nullptr};
+  uint32_t temperature_updated_ms_{0};
+  uint32_t humidity_updated_ms_{0};
+  uint32_t source_timeout_ms_{60000};
+
+  // Recovery bookkeeping.
+  uint32_t reset_recoveries_{0};
+  uint32_t access_conflicts_{0};
+  uint32_t last_recovery_ms_{0};
+  uint32_t recovery_started_ms_{0};
+  // A failed recovery is retried at the next measurement deadline.
+  bool recovery_pending_{false};
+
+#ifdef USE_ZMOD4510_RECORDING
+  // Per-sample details that only the recording needs.
+  uint8_t sample_status_{0};
+  uint8_t sample_retries_{0};
+  bool sample_after_reset_{false};
+  RecordingWriter recording_;
+  std::unique_ptr<RecordingSink> recording_sink_;
+  uint16_t recording_block_rows_{16};
+#ifdef USE_ZMOD4510_RECORDING_UART
+  esphome::uart::UARTComponent *recording_uart_{nullptr};
+#endif
+#ifdef USE_ZMOD4510_RECORDING_TCP
+  uint16_t recording_port_{0};
+#endif
+#endif
 };
 
 }  // namespace zmod4510
@@ -49,6 +49,48 @@ zmod4xxx_err zmod4xxx_check_error_event(zmod4xxx_dev_t *dev)
     return ZMOD4XXX_OK;
 }
 
+zmod4xxx_err zmod4xxx_wait_sequencer(zmod4xxx_dev_t *dev, uint32_t expected_ms,
+                                     uint32_t timeout_ms)
+{
+    zmod4xxx_err api_ret;
+    uint8_t status;
+    uint32_t step = expected_ms;
+    uint32_t waited = 0;
+
+    dev->poll.requested_wait_ms = 0;
+    dev->poll.polls = 0;
+
+    for (;;) {
+        if (step > timeout_ms - waited) {
+            step = timeout_ms - waited;
+        }
+        if (step) {
+            dev->delay_ms(step);
+            waited += step;
+        }
+        api_ret = zmod4xxx_read_status(dev, &status);
+        dev->poll.requested_wait_ms = waited;
+        dev->poll.polls++;
+        if (api_ret) {
+            return api_ret;
+        }
+        if (0 == (status & STATUS_SEQUENCER_RUNNING_MASK)) {
+            return ZMOD4XXX_OK;
+        }
+        if (waited >= timeout_ms) {
+            return ERROR_GAS_TIMEOUT;
+        }
+        if (1 == dev->poll.polls) {
+            step = ZMOD4XXX_POLL_MIN_STEP_MS;
+        } else if (step < ZMOD4XXX_POLL_MAX_STEP_MS) {
+            step *= 2;
+            if (step > ZMOD4XXX_POLL_MAX_STEP_MS) {
+                step = ZMOD4XXX_POLL_MAX_STEP_MS;
+            }
+        }
+    }
+}
+
 zmod4xxx_err zmod4xxx_null_ptr_check(zmod4xxx_dev_t *dev)
 {
     zmod4xxx_err ret;
@@ -62,37 +104,29 @@ zmod4xxx_err zmod4xxx_null_ptr_check(zmod4xxx_dev_t *dev)
     return ret;
 }
 
-zmod4xxx_err zmod4xxx_read_sensor_info(zmod4xxx_dev_t *dev)
+zmod4xxx_err zmod4xxx_read_sensor_info_start(zmod4xxx_dev_t *dev)
 {
     int8_t i2c_ret;
     zmod4xxx_err api_ret;
-    uint8_t status = 0;
-    uint8_t data_buf[ZMOD4XXX_LEN_PID];
-    uint16_t product_id;
     uint8_t cmd = 0;
-    uint16_t i = 0;
 
     api_ret = zmod4xxx_null_ptr_check(dev);
     if (api_ret) {
         return api_ret;
     }
 
-    do {
-        i2c_ret = dev->write(dev->i2c_addr, ZMOD4XXX_ADDR_CMD, &cmd, 1);
-        if (i2c_ret) {
-            return ERROR_I2C;
-        }
-        api_ret = zmod4xxx_read_status(dev, &status);
-        if (api_ret) {
-            return api_ret;
-        }
-        i++;
-        dev->delay_ms(200);
-    } while ((0x00 != (status & 0x80)) && (i < 1000));
-
-    if (1000 <= i) {
-        return ERROR_GAS_TIMEOUT;
+    i2c_ret = dev->write(dev->i2c_addr, ZMOD4XXX_ADDR_CMD, &cmd, 1);
+    if (i2c_ret) {
+        return ERROR_I2C;
     }
+    return ZMOD4XXX_OK;
+}
+
+zmod4xxx_err zmod4xxx_read_sensor_info_finish(zmod4xxx_dev_t *dev)
+{
+    int8_t i2c_ret;
+    uint8_t data_buf[ZMOD4XXX_LEN_PID];
+    uint16_t product_id;
 
     i2c_ret =
         dev->read(dev->i2c_addr, ZMOD4XXX_ADDR_PID, data_buf, ZMOD4XXX_LEN_PID);
@@ -119,6 +153,21 @@ zmod4xxx_err zmod4xxx_read_sensor_info(zmod4xxx_dev_t *dev)
     return ZMOD4XXX_OK;
 }
 
+zmod4xxx_err zmod4xxx_read_sensor_info(zmod4xxx_dev_t *dev)
+{
+    zmod4xxx_err api_ret;
+
+    api_ret = zmod4xxx_read_sensor_info_start(dev);
+    if (api_ret) {
+        return api_ret;
+    }
+    api_ret = zmod4xxx_wait_sequencer(dev, 0, ZMOD4XXX_STOP_TIMEOUT_MS);
+    if (api_ret) {
+        return api_ret;
+    }
+    return zmod4xxx_read_sensor_info_finish(dev);
+}
+
 zmod4xxx_err zmod4xxx_read_tracking_number(zmod4xxx_dev_t *dev,
                                            uint8_t *track_num)
 {
@@ -153,13 +202,12 @@ zmod4xxx_err zmod4xxx_calc_factor(zmod4xxx_conf *conf, uint8_t *hsp,
     return ZMOD4XXX_OK;
 }
 
-zmod4xxx_err zmod4xxx_init_sensor(zmod4xxx_dev_t *dev)
+zmod4xxx_err zmod4xxx_init_sensor_start(zmod4xxx_dev_t *dev)
 {
     int8_t i2c_ret;
     zmod4xxx_err api_ret;
     uint8_t hsp[HSP_MAX * 2];
     uint8_t data_r[RSLT_MAX];
-    uint8_t zmod4xxx_status;
 
     i2c_ret = dev->read(dev->i2c_addr, 0xB7, data_r, 1);
     if (i2c_ret) {
@@ -197,13 +245,13 @@ zmod4xxx_err zmod4xxx_init_sensor(zmod4xxx_dev_t *dev)
     if (i2c_ret) {
         return ERROR_I2C;
     }
-    do {
-        api_ret = zmod4xxx_read_status(dev, &zmod4xxx_status);
-        if (api_ret) {
-            return api_ret;
-        }
-        dev->delay_ms(50);
-    } while (zmod4xxx_status & STATUS_SEQUENCER_RUNNING_MASK);
+    return ZMOD4XXX_OK;
+}
+
+zmod4xxx_err zmod4xxx_init_sensor_finish(zmod4xxx_dev_t *dev)
+{
+    int8_t i2c_ret;
+    uint8_t data_r[RSLT_MAX];
 
     i2c_ret = dev->read(dev->i2c_addr, dev->init_conf->r.addr, data_r,
                         dev->init_conf->r.len);
@@ -216,6 +264,22 @@ zmod4xxx_err zmod4xxx_init_sensor(zmod4xxx_dev_t *dev)
     return ZMOD4XXX_OK;
 }
 
+zmod4xxx_err zmod4xxx_init_sensor(zmod4xxx_dev_t *dev)
+{
+    zmod4xxx_err api_ret;
+
+    api_ret = zmod4xxx_init_sensor_start(dev);
+    if (api_ret) {
+        return api_ret;
+    }
+    api_ret = zmod4xxx_wait_sequencer(dev, ZMOD4XXX_INIT_SEQ_TIME_MS,
+                                      ZMOD4XXX_INIT_TIMEOUT_MS);
+    if (api_ret) {
+        return api_ret;
+    }
+    return zmod4xxx_init_sensor_finish(dev);
+}
+
 zmod4xxx_err zmod4xxx_init_measurement(zmod4xxx_dev_t *dev)
 {
     int8_t i2c_ret;
@@ -0,0 +1,86 @@
+#include "zmod4xxx_async.h"
+#include "esphome/core/defines.h"
+#ifdef USE_ZMOD4510_ASYNC_HAL
+
+extern "C" {
+  #include "zmod4xxx.h"
+}
+
+namespace zmod4510 {
+
+int AsyncSequencerWait::start(AsyncInterface *hal, uint8_t i2c_addr, uint32_t expected_ms, uint32_t timeout_ms,
+                              AsyncCallback done, void *context) {
+  this->hal_ = hal;
+  this->i2c_addr_ = i2c_addr;
+  this->timeout_ms_ = timeout_ms;
+  this->done_ = done;
+  this->context_ = context;
+  this->step_ms_ = expected_ms;
+  this->waited_ms_ = 0;
+  this->polls_ = 0;
+  int ret = this->next_();
+  this->running_ = ret == ecSuccess;
+  return ret;
+}
+
+int AsyncSequencerWait::next_() {
+  if (this->step_ms_ > this->timeout_ms_ - this->waited_ms_) {
+    this->step_ms_ = this->timeout_ms_ - this->waited_ms_;
+  }
+  if (this->step_ms_ != 0) {
+    this->waited_ms_ += this->step_ms_;
+    return this->hal_->schedule(this->hal_->handle, this->step_ms_, on_wakeup_, this);
+  }
+  return this->read_status_();
+}
+
+int AsyncSequencerWait::read_status_() {
+  this->reg_ = ZMOD4XXX_ADDR_STATUS;
+  return this->hal_->submit_read(this->hal_->handle, this->i2c_addr_, &this->reg_, 1, &this->status_, 1, on_status_,
+                                 this);
+}
+
+void AsyncSequencerWait::on_wakeup_(void *context, int result) {
+  auto *self = static_cast<AsyncSequencerWait *>(context);
+  if (self->read_status_() != ecSuccess) {
+    self->finish_(ERROR_I2C);
+  }
+}
+
+void AsyncSequencerWait::on_status_(void *context, int result) {
+  auto *self = static_cast<AsyncSequencerWait *>(context);
+  self->polls_++;
+  if (result != ecSuccess) {
+    self->finish_(ERROR_I2C);
+    return;
+  }
+  if ((self->status_ & STATUS_SEQUENCER_RUNNING_MASK) == 0) {
+    self->finish_(ZMOD4XXX_OK);
+    return;
+  }
+  if (self->waited_ms_ >= self->timeout_ms_) {
+    self->finish_(ERROR_GAS_TIMEOUT);
+    return;
+  }
+  // Back-off of zmod4xxx_wait_sequencer().
+  if (self->polls_ == 1) {
+    self->step_ms_ = ZMOD4XXX_POLL_MIN_STEP_MS;
+  } else if (self->step_ms_ < ZMOD4XXX_POLL_MAX_STEP_MS) {
+    self->step_ms_ *= 2;
+    if (self->step_ms_ > ZMOD4XXX_POLL_MAX_STEP_MS) {
+      self->step_ms_ = ZMOD4XXX_POLL_MAX_STEP_MS;
+    }
+  }
+  if (self->next_() != ecSuccess) {
+    self->finish_(ERROR_I2C);
+  }
+}
+
+void AsyncSequencerWait::finish_(int result) {
+  this->running_ = false;
+  this->done_(this->context_, result);
+}
+
+}  // namespace zmod4510
+
+#endif  // USE_ZMOD4510_ASYNC_HAL
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include "async_hal.h"
+
+namespace zmod4510 {
+
+// Event-driven zmod4xxx_wait_sequencer(): the same waits and status reads
+// with the same back-off, each one an operation on an AsyncInterface, so the
+// loop keeps running while the sequencer works.
+class AsyncSequencerWait {
+ public:
+  // Wait for the sequencer of the ZMOD4xxx at `i2c_addr`. `done` receives
+  // ZMOD4XXX_OK, ERROR_GAS_TIMEOUT or ERROR_I2C. Returns the error of the
+  // first submission; `done` is then not called.
+  int start(AsyncInterface *hal, uint8_t i2c_addr, uint32_t expected_ms, uint32_t timeout_ms, AsyncCallback done,
+            void *context);
+
+  bool is_running() const { return this->running_; }
+  // Like zmod4xxx_dev_t::poll for the last wait: the sum of the requested
+  // wakeups, not the time that passed.
+  uint32_t get_requested_wait_ms() const { return this->waited_ms_; }
+  uint16_t get_polls() const { return this->polls_; }
+
+ protected:
+  static void on_wakeup_(void *context, int result);
+  static void on_status_(void *context, int result);
+
+  // Sleep for the next step, or read the status right away if it is zero.
+  int next_();
+  int read_status_();
+  void finish_(int result);
+
+  AsyncInterface *hal_{nullptr};
+  AsyncCallback done_{nullptr};
+  void *context_{nullptr};
+  uint32_t timeout_ms_{0};
+  uint32_t step_ms_{0};
+  uint32_t waited_ms_{0};
+  uint16_t polls_{0};
+  uint8_t i2c_addr_{0};
+  uint8_t reg_{0};
+  uint8_t status_{0};
+  bool running_{false};
+};
+
+}  // namespace zmod4510
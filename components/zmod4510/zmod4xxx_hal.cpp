@@ -20,56 +20,178 @@
 #include "zmod4xxx_hal.h"
 #include "zmod4xxx_types.h"
 
-static Interface_t* _hal;
+/* The legacy ZMOD4xxx API calls its I2C functions without a device or
+ *  interface argument. So that sensors on different interfaces can be used
+ *  side by side, each connected device is bound to a slot with its own pair
+ *  of wrapper functions. */
+#define ZMOD4XXX_HAL_SLOTS  32
+
+typedef struct {
+  zmod4xxx_dev_t*  dev;
+  Interface_t*     hal;
+} _Slot_t;
+
+static _Slot_t  _slots [ ZMOD4XXX_HAL_SLOTS ];
 
 /* wrapper function, mapping register read api to generic I2C API */
 static int8_t
-_i2c_read_reg ( uint8_t  slaveAddr, uint8_t  addr, uint8_t*  data, uint8_t  len ) {
-  return _hal -> i2cRead ( _hal -> handle, slaveAddr, &addr, 1, data, len );
+_i2c_read_reg ( int  slot, uint8_t  slaveAddr, uint8_t  addr, uint8_t*  data, uint8_t  len ) {
+  Interface_t*  hal = _slots [ slot ] . hal;
+  /* The HAL error codes (ecHALError = 0x100) do not fit into int8_t and
+   *  would read as success; the details stay with the slot's interface,
+   *  see HAL_GetInterfaceErrorInfo(). */
+  if ( HAL_I2CRead ( hal, slaveAddr, &addr, 1, data, len ) != ecSuccess )
+    return ERROR_I2C;
+  return ZMOD4XXX_OK;
 }
 
 
 /* wrapper function, mapping register write api to generic I2C API */
 static int8_t
-_i2c_write_reg ( uint8_t  slaveAddr, uint8_t  addr, uint8_t*  data, uint8_t  len ) {
-  return _hal -> i2cWrite ( _hal -> handle, slaveAddr, &addr, 1, data, len );
+_i2c_write_reg ( int  slot, uint8_t  slaveAddr, uint8_t  addr, uint8_t*  data, uint8_t  len ) {
+  Interface_t*  hal = _slots [ slot ] . hal;
+  if ( HAL_I2CWrite ( hal, slaveAddr, &addr, 1, data, len ) != ecSuccess )
+    return ERROR_I2C;
+  return ZMOD4XXX_OK;
+}
+
+
+#define _SLOT_FUNCTIONS( n )                                                    \
+  static int8_t                                                                 \
+  _i2c_read_reg_##n ( uint8_t  slaveAddr, uint8_t  addr, uint8_t*  data, uint8_t  len ) { \
+    return _i2c_read_reg ( n, slaveAddr, addr, data, len );                     \
+  }                                                                             \
+  static int8_t                                                                 \
+  _i2c_write_reg_##n ( uint8_t  slaveAddr, uint8_t  addr, uint8_t*  data, uint8_t  len ) { \
+    return _i2c_write_reg ( n, slaveAddr, addr, data, len );                    \
+  }
+
+_SLOT_FUNCTIONS ( 0 )  _SLOT_FUNCTIONS ( 1 )  _SLOT_FUNCTIONS ( 2 )  _SLOT_FUNCTIONS ( 3 )
+_SLOT_FUNCTIONS ( 4 )  _SLOT_FUNCTIONS ( 5 )  _SLOT_FUNCTIONS ( 6 )  _SLOT_FUNCTIONS ( 7 )
+_SLOT_FUNCTIONS ( 8 )  _SLOT_FUNCTIONS ( 9 )  _SLOT_FUNCTIONS ( 10 ) _SLOT_FUNCTIONS ( 11 )
+_SLOT_FUNCTIONS ( 12 ) _SLOT_FUNCTIONS ( 13 ) _SLOT_FUNCTIONS ( 14 ) _SLOT_FUNCTIONS ( 15 )
+_SLOT_FUNCTIONS ( 16 ) _SLOT_FUNCTIONS ( 17 ) _SLOT_FUNCTIONS ( 18 ) _SLOT_FUNCTIONS ( 19 )
+_SLOT_FUNCTIONS ( 20 ) _SLOT_FUNCTIONS ( 21 ) _SLOT_FUNCTIONS ( 22 ) _SLOT_FUNCTIONS ( 23 )
+_SLOT_FUNCTIONS ( 24 ) _SLOT_FUNCTIONS ( 25 ) _SLOT_FUNCTIONS ( 26 ) _SLOT_FUNCTIONS ( 27 )
+_SLOT_FUNCTIONS ( 28 ) _SLOT_FUNCTIONS ( 29 ) _SLOT_FUNCTIONS ( 30 ) _SLOT_FUNCTIONS ( 31 )
+
+#define _SLOT_READ( n )   _i2c_read_reg_##n
+#define _SLOT_WRITE( n )  _i2c_write_reg_##n
+
+static zmod4xxx_i2c_ptr_t const  _slot_read [ ZMOD4XXX_HAL_SLOTS ] = {
+  _SLOT_READ ( 0 ),  _SLOT_READ ( 1 ),  _SLOT_READ ( 2 ),  _SLOT_READ ( 3 ),
+  _SLOT_READ ( 4 ),  _SLOT_READ ( 5 ),  _SLOT_READ ( 6 ),  _SLOT_READ ( 7 ),
+  _SLOT_READ ( 8 ),  _SLOT_READ ( 9 ),  _SLOT_READ ( 10 ), _SLOT_READ ( 11 ),
+  _SLOT_READ ( 12 ), _SLOT_READ ( 13 ), _SLOT_READ ( 14 ), _SLOT_READ ( 15 ),
+  _SLOT_READ ( 16 ), _SLOT_READ ( 17 ), _SLOT_READ ( 18 ), _SLOT_READ ( 19 ),
+  _SLOT_READ ( 20 ), _SLOT_READ ( 21 ), _SLOT_READ ( 22 ), _SLOT_READ ( 23 ),
+  _SLOT_READ ( 24 ), _SLOT_READ ( 25 ), _SLOT_READ ( 26 ), _SLOT_READ ( 27 ),
+  _SLOT_READ ( 28 ), _SLOT_READ ( 29 ), _SLOT_READ ( 30 ), _SLOT_READ ( 31 )
+};
+
+static zmod4xxx_i2c_ptr_t const  _slot_write [ ZMOD4XXX_HAL_SLOTS ] = {
+  _SLOT_WRITE ( 0 ),  _SLOT_WRITE ( 1 ),  _SLOT_WRITE ( 2 ),  _SLOT_WRITE ( 3 ),
+  _SLOT_WRITE ( 4 ),  _SLOT_WRITE ( 5 ),  _SLOT_WRITE ( 6 ),  _SLOT_WRITE ( 7 ),
+  _SLOT_WRITE ( 8 ),  _SLOT_WRITE ( 9 ),  _SLOT_WRITE ( 10 ), _SLOT_WRITE ( 11 ),
+  _SLOT_WRITE ( 12 ), _SLOT_WRITE ( 13 ), _SLOT_WRITE ( 14 ), _SLOT_WRITE ( 15 ),
+  _SLOT_WRITE ( 16 ), _SLOT_WRITE ( 17 ), _SLOT_WRITE ( 18 ), _SLOT_WRITE ( 19 ),
+  _SLOT_WRITE ( 20 ), _SLOT_WRITE ( 21 ), _SLOT_WRITE ( 22 ), _SLOT_WRITE ( 23 ),
+  _SLOT_WRITE ( 24 ), _SLOT_WRITE ( 25 ), _SLOT_WRITE ( 26 ), _SLOT_WRITE ( 27 ),
+  _SLOT_WRITE ( 28 ), _SLOT_WRITE ( 29 ), _SLOT_WRITE ( 30 ), _SLOT_WRITE ( 31 )
+};
+
+
+/* find the slot of dev, or claim a free one; returns -1 if all are taken */
+static int
+_bind_slot ( zmod4xxx_dev_t*  dev, Interface_t*  hal ) {
+  int  i;
+
+  /* a device that is connected again keeps its slot */
+  for ( i = 0; i < ZMOD4XXX_HAL_SLOTS; i++ ) {
+    if ( __atomic_load_n ( &_slots [ i ] . dev, __ATOMIC_ACQUIRE ) == dev ) {
+      _slots [ i ] . hal = hal;
+      return i;
+    }
+  }
+
+  /* devices may be connected from several tasks at once, so free slots are
+   *  claimed atomically */
+  for ( i = 0; i < ZMOD4XXX_HAL_SLOTS; i++ ) {
+    zmod4xxx_dev_t*  expected = NULL;
+    if ( __atomic_compare_exchange_n ( &_slots [ i ] . dev, &expected, dev, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE ) ) {
+      _slots [ i ] . hal = hal;
+      return i;
+    }
+  }
+  return -1;
 }
 
 
 int
-zmod4xxx_init ( zmod4xxx_dev_t*  dev, Interface_t*  hal ) {
+zmod4xxx_connect ( zmod4xxx_dev_t*  dev, Interface_t*  hal ) {
   uint8_t  dummy [ 1 ];
+  int      slot;
 
   /* verify we have all functions required for the ZMOD4xxx API */
   if ( !hal -> i2cRead ) {
-    HAL_SetError ( heI2CReadMissing, esHAL, HAL_GetErrorString );
+    HAL_SetInterfaceError ( hal, heI2CReadMissing, esHAL, HAL_GetErrorString );
     return ERROR_NULL_PTR;
   }
   
   if ( !hal -> i2cWrite ) {
-    HAL_SetError ( heI2CWriteMissing, esHAL, HAL_GetErrorString );
+    HAL_SetInterfaceError ( hal, heI2CWriteMissing, esHAL, HAL_GetErrorString );
     return ERROR_NULL_PTR;
   }
   
   if ( !hal -> msSleep ) {
-    HAL_SetError ( heSleepMissing, esHAL, HAL_GetErrorString );
+    HAL_SetInterfaceError ( hal, heSleepMissing, esHAL, HAL_GetErrorString );
     return ERROR_NULL_PTR;
   }
 
   
+  slot = _bind_slot ( dev, hal );
+  if ( slot < 0 ) {
+    HAL_SetInterfaceError ( hal, heNoDeviceSlot, esHAL, HAL_GetErrorString );
+    return ERROR_NULL_PTR;
+  }
+
   /* populate function pointers in legacy ZMOD4xxx API */
-  dev -> write    = _i2c_write_reg;
-  dev -> read     = _i2c_read_reg;
+  dev -> write    = _slot_write [ slot ];
+  dev -> read     = _slot_read [ slot ];
   dev -> delay_ms = hal -> msSleep;
-  
-  dev -> delay_ms ( 200 );
-  
-  _hal = hal;
 
   /* verify there is a sensor connected */
-  if ( hal -> i2cWrite ( hal -> handle, dev ->i2c_addr, dummy, 0, NULL, 0 ) ) {
+  if ( HAL_I2CWrite ( hal, dev ->i2c_addr, dummy, 0, NULL, 0 ) ) {
     return ERROR_I2C;
   }
 
   return ZMOD4XXX_OK;
 }
+
+
+int
+zmod4xxx_init ( zmod4xxx_dev_t*  dev, Interface_t*  hal ) {
+  /* give the sensor time to power up */
+  if ( hal -> msSleep ) {
+    hal -> msSleep ( ZMOD4XXX_POWER_ON_TIME_MS );
+  }
+
+  return zmod4xxx_connect ( dev, hal );
+}
+
+
+int
+zmod4xxx_deinit ( zmod4xxx_dev_t*  dev ) {
+  int  i;
+
+  for ( i = 0; i < ZMOD4XXX_HAL_SLOTS; i++ ) {
+    if ( __atomic_load_n ( &_slots [ i ] . dev, __ATOMIC_ACQUIRE ) == dev ) {
+      _slots [ i ] . hal = NULL;
+      __atomic_store_n ( &_slots [ i ] . dev, NULL, __ATOMIC_RELEASE );
+    }
+  }
+  dev -> read  = NULL;
+  dev -> write = NULL;
+  return ZMOD4XXX_OK;
+}
@@ -28,6 +28,9 @@
 #include "zmod4xxx_types.h"
 #include "hal.h"
 
+/** time the sensor needs after power on before it can be accessed, in ms */
+#define ZMOD4XXX_POWER_ON_TIME_MS  200
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -39,6 +42,10 @@ extern "C" {
  *  re-implemented. The function must assign the zmod4xxx_dev_t#read, 
  *  zmod4xxx_dev_t#write and zmod4xxx_dev_t#delay_ms members of \a dev.
  *
+ * Every device is bound to its own \a hal, so sensors on different
+ *  interfaces can be driven side by side, also from different tasks. Up to
+ *  32 devices can be connected at a time; see zmod4xxx_deinit().
+ *
  * \param    [in] dev   pointer to the sensor object
  * \param    [in] hal   pointer to the hal interface object
  * \return   error code
@@ -47,6 +54,33 @@ extern "C" {
  */
 int  zmod4xxx_init ( zmod4xxx_dev_t*  dev, Interface_t*  hal );
 
+/**
+ * Like zmod4xxx_init(), without waiting for the sensor to power up
+ *
+ * The caller must make sure at least ::ZMOD4XXX_POWER_ON_TIME_MS have passed
+ *  since the sensor was powered. With several sensors powered together one
+ *  wait covers all of them.
+ *
+ * \param    [in] dev   pointer to the sensor object
+ * \param    [in] hal   pointer to the hal interface object
+ * \return   error code
+ * \retval   0 on success
+ * \retval   !=0 hardware specific error code
+ */
+int  zmod4xxx_connect ( zmod4xxx_dev_t*  dev, Interface_t*  hal );
+
+/**
+ * Release the binding of a sensor object to its hal interface
+ *
+ * Call this before \a dev goes out of scope, so its slot can be used by
+ *  another device.
+ *
+ * \param    [in] dev   pointer to the sensor object
+ * \return   error code
+ * \retval   0 on success
+ */
+int  zmod4xxx_deinit ( zmod4xxx_dev_t*  dev );
+
 #ifdef __cplusplus
 }
 #endif
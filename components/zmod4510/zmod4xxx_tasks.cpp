@@ -0,0 +1,119 @@
+#include "zmod4xxx_tasks.h"
+#include "esphome/core/defines.h"
+
+#if defined(USE_ZMOD4510_ASYNC_HAL) && defined(__cpp_impl_coroutine)
+
+extern "C" {
+  #include "zmod4xxx_hal.h"
+}
+
+namespace zmod4510 {
+namespace sequence {
+
+// Settling time between the init sequence and the measurement configuration,
+// as in zmod4xxx_prepare_sensor().
+static const uint32_t PREPARE_SETTLE_MS = 50;
+
+Task<int> wait_sequencer(Executor &executor, zmod4xxx_dev_t *dev, uint32_t expected_ms, uint32_t timeout_ms) {
+  uint8_t reg = ZMOD4XXX_ADDR_STATUS;
+  uint8_t status;
+  uint32_t step = expected_ms;
+  uint32_t waited = 0;
+
+  dev->poll.requested_wait_ms = 0;
+  dev->poll.polls = 0;
+  for (;;) {
+    if (step > timeout_ms - waited) {
+      step = timeout_ms - waited;
+    }
+    if (step != 0) {
+      co_await executor.sleep(step);
+      waited += step;
+    }
+    int ret = co_await executor.read(dev->i2c_addr, &reg, 1, &status, 1);
+    dev->poll.requested_wait_ms = waited;
+    dev->poll.polls++;
+    if (ret != ecSuccess) {
+      co_return ERROR_I2C;
+    }
+    if ((status & STATUS_SEQUENCER_RUNNING_MASK) == 0) {
+      co_return ZMOD4XXX_OK;
+    }
+    if (waited >= timeout_ms) {
+      co_return ERROR_GAS_TIMEOUT;
+    }
+    if (dev->poll.polls == 1) {
+      step = ZMOD4XXX_POLL_MIN_STEP_MS;
+    } else if (step < ZMOD4XXX_POLL_MAX_STEP_MS) {
+      step *= 2;
+      if (step > ZMOD4XXX_POLL_MAX_STEP_MS) {
+        step = ZMOD4XXX_POLL_MAX_STEP_MS;
+      }
+    }
+  }
+}
+
+Task<int> bring_up(Executor &executor, zmod4xxx_dev_t *dev, Interface_t *hal) {
+  co_await executor.sleep(ZMOD4XXX_POWER_ON_TIME_MS);
+  int ret = zmod4xxx_connect(dev, hal);
+  if (ret != 0) {
+    co_return ret;
+  }
+  ret = zmod4xxx_read_sensor_info_start(dev);
+  if (ret != ZMOD4XXX_OK) {
+    co_return ret;
+  }
+  ret = co_await wait_sequencer(executor, dev, 0, ZMOD4XXX_STOP_TIMEOUT_MS);
+  if (ret != ZMOD4XXX_OK) {
+    co_return ret;
+  }
+  co_return zmod4xxx_read_sensor_info_finish(dev);
+}
+
+Task<int> prepare(Executor &executor, zmod4xxx_dev_t *dev) {
+  int ret = zmod4xxx_init_sensor_start(dev);
+  if (ret != ZMOD4XXX_OK) {
+    co_return ret;
+  }
+  ret = co_await wait_sequencer(executor, dev, ZMOD4XXX_INIT_SEQ_TIME_MS, ZMOD4XXX_INIT_TIMEOUT_MS);
+  if (ret != ZMOD4XXX_OK) {
+    co_return ret;
+  }
+  ret = zmod4xxx_init_sensor_finish(dev);
+  if (ret != ZMOD4XXX_OK) {
+    co_return ret;
+  }
+  co_await executor.sleep(PREPARE_SETTLE_MS);
+  co_return zmod4xxx_init_measurement(dev);
+}
+
+Task<int> measure(Executor &executor, zmod4xxx_dev_t *dev, uint8_t *adc_result, uint32_t expected_ms,
+                  uint32_t timeout_ms) {
+  int ret = zmod4xxx_start_measurement(dev);
+  if (ret != ZMOD4XXX_OK) {
+    co_return ret;
+  }
+  ret = co_await wait_sequencer(executor, dev, expected_ms, timeout_ms);
+  if (ret != ZMOD4XXX_OK) {
+    co_return ret;
+  }
+  ret = zmod4xxx_read_adc_result(dev, adc_result);
+  if (ret != ZMOD4XXX_OK) {
+    co_return ret;
+  }
+  co_return zmod4xxx_check_error_event(dev);
+}
+
+Task<int> read_ambient(Executor &executor, HSxxxx_t *sensor, HSxxxx_Results_t *results) {
+  int ret = HSxxxx_MeasureStart(sensor);
+  if (ret != 0) {
+    co_return ret;
+  }
+  co_await executor.sleep(HSxxxx_MeasurementDuration(sensor));
+  co_return HSxxxx_MeasureRead(sensor, results);
+}
+
+}  // namespace sequence
+}  // namespace zmod4510
+
+#endif  // USE_ZMOD4510_ASYNC_HAL && __cpp_impl_coroutine
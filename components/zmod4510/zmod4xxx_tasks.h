@@ -0,0 +1,63 @@
+#pragma once
+
+// Sensor sequences as coroutines; see coroutine.h for when they are compiled.
+#ifdef __cpp_impl_coroutine
+
+#include "coroutine.h"
+
+extern "C" {
+  #include "hsxxxx.h"
+  #include "zmod4xxx.h"
+}
+
+namespace zmod4510 {
+
+// The blocking flows of zmod4xxx.cpp and the HS drivers, with every wait
+// awaited on an Executor: sleeps are timer wakeups and the sequencer status
+// is polled through the executor's AsyncInterface. The short transfers around
+// the waits still go through the drivers, so `dev` and the HS sensor must be
+// bound to an Interface_t on the same bus; with a BlockingAdapter on the
+// executor's AsyncInterface all traffic shares one transport.
+//
+// Each task returns the code of the driver function it replaces, so a flow
+// reads like the blocking example:
+//
+//   int ret = co_await sequence::bring_up(executor, &dev, &hal);
+//   if (ret == ZMOD4XXX_OK)
+//     ret = co_await sequence::prepare(executor, &dev);
+//   while (ret == ZMOD4XXX_OK) {
+//     ret = co_await sequence::measure(executor, &dev, adc_result, sample_ms, timeout_ms);
+//     ...
+//   }
+//
+// There is no task for zmod4xxx_cleaning_run(): lib_zmod4xxx_cleaning waits
+// for its minute of sequencer time inside the blocking calls of `dev`, so it
+// cannot be suspended. Call it between bring_up and prepare, as the
+// component's setup() does, knowing that it blocks the loop meanwhile.
+namespace sequence {
+
+// zmod4xxx_wait_sequencer() with the same back-off.
+Task<int> wait_sequencer(Executor &executor, zmod4xxx_dev_t *dev, uint32_t expected_ms, uint32_t timeout_ms);
+
+// zmod4xxx_init() and zmod4xxx_read_sensor_info(): waits for the sensor to
+// power up, binds `dev` to `hal`, stops any running sequence and reads the
+// sensor information. Sensors brought up side by side share the waits.
+Task<int> bring_up(Executor &executor, zmod4xxx_dev_t *dev, Interface_t *hal);
+
+// zmod4xxx_prepare_sensor(): the init sequence, then the measurement
+// configuration.
+Task<int> prepare(Executor &executor, zmod4xxx_dev_t *dev);
+
+// One measurement cycle: starts the sequence, waits for it and reads the ADC
+// result, which is then checked for a reset or access conflict like the
+// example's read_and_verify().
+Task<int> measure(Executor &executor, zmod4xxx_dev_t *dev, uint8_t *adc_result, uint32_t expected_ms,
+                  uint32_t timeout_ms);
+
+// HSxxxx_Measure(): starts a conversion and reads it once it is done.
+Task<int> read_ambient(Executor &executor, HSxxxx_t *sensor, HSxxxx_Results_t *results);
+
+}  // namespace sequence
+}  // namespace zmod4510
+
+#endif  // __cpp_impl_coroutine
@@ -22,6 +22,10 @@
 
 static char const*
 _GetErrorString ( int  error, int  scope, char*  str, int  strLen ) {
+#ifdef HAL_NO_ERROR_STRINGS
+  snprintf ( str, strLen, "Arduino Wire Error: %d", error );
+  return str;
+#else
   char  buf [ 30 ];
   char const*  err;
   switch ( error ) {
@@ -46,6 +50,7 @@ _GetErrorString ( int  error, int  scope, char*  str, int  strLen ) {
   }
   snprintf ( str, strLen, "Arduino Wire Error: %s", err );
   return str;
+#endif
 }
 
 static void
@@ -55,22 +60,22 @@ _Delay ( uint32_t ms ) {
 
 static int
 _I2CRead ( void*  ifce, uint8_t  slAddr, uint8_t*  wrData, int  wrSize, uint8_t*  rdData, int  rdSize ) {
-  ( void) ifce;
-  Wire . beginTransmission( slAddr );
+  TwoWire&  wire = *( TwoWire* ) ifce;
+  wire . beginTransmission( slAddr );
   if ( wrSize ) {
-    Wire . write( wrData, wrSize );
-    Wire . endTransmission ( false );
+    wire . write( wrData, wrSize );
+    wire . endTransmission ( false );
     delay ( 10 );
   }
-  Wire . requestFrom ( slAddr, rdSize );
+  wire . requestFrom ( slAddr, rdSize );
 
   int i = 0;
-  while ( Wire . available ( ) && i < rdSize ) { // slave may send less than requested
+  while ( wire . available ( ) && i < rdSize ) { // slave may send less than requested
     //for ( int i = 0; i < rdSize; i++ ) {
-    rdData [ i++ ] = Wire . read ( );
+    rdData [ i++ ] = wire . read ( );
     //}
   }
-  int  errorCode = Wire . endTransmission ( );
+  int  errorCode = wire . endTransmission ( );
   if ( errorCode )
     return HAL_SetError ( errorCode, aesArduino, _GetErrorString );
   return ecSuccess;
@@ -79,13 +84,13 @@ _I2CRead ( void*  ifce, uint8_t  slAddr, uint8_t*  wrData, int  wrSize, uint8_t*
 
 static int
 _I2CWrite( void*  ifce, uint8_t  slAddr, uint8_t*  wrData1, int  wrSize1, uint8_t*  wrData2, int  wrSize2 ) {
-  ( void) ifce;
-  Wire . beginTransmission ( slAddr );
+  TwoWire&  wire = *( TwoWire* ) ifce;
+  wire . beginTransmission ( slAddr );
   if ( wrSize1 )
-    Wire . write ( wrData1, wrSize1 );
+    wire . write ( wrData1, wrSize1 );
   if ( wrSize2 )
-    Wire . write ( wrData2, wrSize2 );
-  int  errorCode = Wire . endTransmission ( );
+    wire . write ( wrData2, wrSize2 );
+  int  errorCode = wire . endTransmission ( );
   if ( errorCode )
     return HAL_SetError ( errorCode, aesArduino, _GetErrorString );
   return ecSuccess;
@@ -94,12 +99,20 @@ _I2CWrite( void*  ifce, uint8_t  slAddr, uint8_t*  wrData1, int  wrSize1, uint8_
 
 
 int
-HAL_Init ( Interface_t*  hal ) {
-  Wire . begin ( );
+HAL_InitWire ( Interface_t*  hal, TwoWire*  wire ) {
+  hal -> handle      = wire;
   hal -> i2cRead     = _I2CRead;
   hal -> i2cWrite    = _I2CWrite;
   hal -> msSleep     = _Delay;
   hal -> reset       = NULL;
+  hal -> lastError   = HALErrorInfo_t { };
+  return ecSuccess;
+}
+
+int
+HAL_Init ( Interface_t*  hal ) {
+  Wire . begin ( );
+  HAL_InitWire ( hal, &Wire );
   // Allow UART interface to settle - otherwise startup information 
   //  will not be received by Arduino IDE
   _Delay ( 2500 );
@@ -17,8 +17,26 @@
 #ifndef ARDUINO_H
 #define ARDUINO_H
 
+#include "hal/hal.h"
+
 typedef enum {
   aesArduino = 0x4000
 } ArduinoErrorDefs_t;
 
+class TwoWire;
+
+/**
+ * @brief Populate an ::Interface_t object for one I2C controller
+ * HAL_Init() uses the default `Wire` instance; other controllers (e.g.
+ *  `Wire1`) get an interface object of their own through this function.
+ *  The controller must already be started with `begin()`. Each interface
+ *  accesses only its own controller, so sensors on different controllers
+ *  can be driven from separate tasks.
+ * @param hal   pointer to ::Interface_t object to be initialized
+ * @param wire  the I2C controller
+ * @return      error code
+ * @retval  0   on success
+ */
+int  HAL_InitWire ( Interface_t*  hal, TwoWire*  wire );
+
 #endif
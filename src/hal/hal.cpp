@@ -19,17 +19,21 @@
 #include <stdio.h>
 #include "hal/hal.h"
 
-static struct {
-  int                     error;
-  int                     scope;
-  ErrorStringGenerator_t  errStrFn;
-} lastError;
+/* Errors are kept with the interface they were raised through. The
+ *  HAL functions learn that interface from HAL_I2CRead() and HAL_I2CWrite(),
+ *  which name it for the calling thread while the call runs; HAL_SetError()
+ *  has no interface argument. Errors raised outside of such a call go to
+ *  _sharedError. */
+static HALErrorInfo_t  _sharedError;
+static thread_local HALErrorInfo_t*  _current = NULL;          /* interface being called */
+static thread_local HALErrorInfo_t*  _last    = &_sharedError;  /* read by HAL_GetErrorInfo() */
 
-int
-HAL_SetError ( int  error, int  scope, ErrorStringGenerator_t  fn ) {
-  lastError . error    = error;
-  lastError . scope    = scope;
-  lastError . errStrFn = fn;
+static int
+_SetError ( HALErrorInfo_t*  info, int  error, int  scope, ErrorStringGenerator_t  fn ) {
+  info -> error    = error;
+  info -> scope    = scope;
+  info -> errStrFn = fn;
+  _last = info;
 
   if ( scope == esSensor )
     return error;
@@ -37,13 +41,51 @@ HAL_SetError ( int  error, int  scope, ErrorStringGenerator_t  fn ) {
     return ecHALError;
 }
 
-char const*
-HAL_GetErrorInfo ( int*  error, int*  scope, char*  str, int  bufLen ) {
-  *error = lastError . error;
-  *scope = lastError . scope;
+int
+HAL_SetError ( int  error, int  scope, ErrorStringGenerator_t  fn ) {
+  return _SetError ( _current ? _current : &_sharedError, error, scope, fn );
+}
+
+int
+HAL_SetInterfaceError ( Interface_t*  hal, int  error, int  scope, ErrorStringGenerator_t  fn ) {
+  return _SetError ( &hal -> lastError, error, scope, fn );
+}
+
+/* Errors of an interface called by a wrapping interface are reported by
+ *  the wrapper as well. */
+static int
+_Leave ( Interface_t*  hal, HALErrorInfo_t*  outer, int  ret ) {
+  _current = outer;
+  if ( ret != ecSuccess && outer ) {
+    *outer = hal -> lastError;
+    _last = outer;
+  }
+  return ret;
+}
+
+int
+HAL_I2CRead ( Interface_t*  hal, uint8_t  slAddr, uint8_t*  wrData, int  wrSize,
+              uint8_t*  rdData, int  rdSize ) {
+  HALErrorInfo_t*  outer = _current;
+  _current = &hal -> lastError;
+  return _Leave ( hal, outer, hal -> i2cRead ( hal -> handle, slAddr, wrData, wrSize, rdData, rdSize ) );
+}
+
+int
+HAL_I2CWrite ( Interface_t*  hal, uint8_t  slAddr, uint8_t*  wrData1, int  wrSize1,
+               uint8_t*  wrData2, int  wrSize2 ) {
+  HALErrorInfo_t*  outer = _current;
+  _current = &hal -> lastError;
+  return _Leave ( hal, outer, hal -> i2cWrite ( hal -> handle, slAddr, wrData1, wrSize1, wrData2, wrSize2 ) );
+}
+
+static char const*
+_GetErrorInfo ( HALErrorInfo_t const*  info, int*  error, int*  scope, char*  str, int  bufLen ) {
+  *error = info -> error;
+  *scope = info -> scope;
   if ( str && bufLen ) {
-    if ( lastError . errStrFn )
-      lastError . errStrFn ( lastError . error, lastError . scope, str, bufLen );
+    if ( info -> errStrFn )
+      info -> errStrFn ( info -> error, info -> scope, str, bufLen );
     else
       snprintf ( str, bufLen, "No additional error information available" );
     return str;
@@ -52,9 +94,23 @@ HAL_GetErrorInfo ( int*  error, int*  scope, char*  str, int  bufLen ) {
     return NULL;
 }
 
+char const*
+HAL_GetErrorInfo ( int*  error, int*  scope, char*  str, int  bufLen ) {
+  return _GetErrorInfo ( _last, error, scope, str, bufLen );
+}
+
+char const*
+HAL_GetInterfaceErrorInfo ( Interface_t const*  hal, int*  error, int*  scope, char*  str, int  bufLen ) {
+  return _GetErrorInfo ( &hal -> lastError, error, scope, str, bufLen );
+}
 
 char const*
 HAL_GetErrorString ( int  error, int scope, char*  str, int  bufLen ) {
+#ifdef HAL_NO_ERROR_STRINGS
+  /* message tables are left out to save flash */
+  snprintf ( str, bufLen, "HAL Error: %d", error );
+  return str;
+#else
   char buf [ 100 ];
   char const*  msg;
   switch ( error ) {
@@ -76,10 +132,17 @@ HAL_GetErrorString ( int  error, int scope, char*  str, int  bufLen ) {
   case  heResetMissing:
     msg = "reset function pointer not set in interface object.";
     break;
+  case  heNoDeviceSlot:
+    msg = "All device slots of the interface wrapper are in use.";
+    break;
+  case  heQueueFull:
+    msg = "Too many asynchronous operations pending.";
+    break;
   default:
     sprintf ( buf, "Unknown error %d", error );
     msg = buf;
   }
   snprintf ( str, bufLen, "HAL Error: %s", msg );
   return str;
+#endif
 }
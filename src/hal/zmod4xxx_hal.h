@@ -39,6 +39,10 @@ extern "C" {
  *  re-implemented. The function must assign the zmod4xxx_dev_t#read, 
  *  zmod4xxx_dev_t#write and zmod4xxx_dev_t#delay_ms members of \a dev.
  *
+ * Every device is bound to its own \a hal, so sensors on different
+ *  interfaces can be driven side by side, also from different tasks. Up to
+ *  32 devices can be connected at a time; see zmod4xxx_deinit().
+ *
  * \param    [in] dev   pointer to the sensor object
  * \param    [in] hal   pointer to the hal interface object
  * \return   error code
@@ -47,6 +51,18 @@ extern "C" {
  */
 int  zmod4xxx_init ( zmod4xxx_dev_t*  dev, Interface_t*  hal );
 
+/**
+ * Release the binding of a sensor object to its hal interface
+ *
+ * Call this before \a dev goes out of scope, so its slot can be used by
+ *  another device.
+ *
+ * \param    [in] dev   pointer to the sensor object
+ * \return   error code
+ * \retval   0 on success
+ */
+int  zmod4xxx_deinit ( zmod4xxx_dev_t*  dev );
+
 #ifdef __cplusplus
 }
 #endif
@@ -21,10 +21,14 @@
 
 static char const*
 _GetErrorString ( int  error, int  scope, char*  str, int  bufSize ) {
+#ifdef HAL_NO_ERROR_STRINGS
+  snprintf ( str, bufSize, "HS4xxx ERROR: %d", error );
+#else
   if ( error == hteHS4xxxCRCError )
     snprintf ( str, bufSize, "HS4xxx ERROR: Checksum verification failed" );
   else
     snprintf ( str, bufSize, "HS4xxx ERROR: Unkown error %d", error );
+#endif
 
   return str;
 }
@@ -57,13 +61,13 @@ HS4xxx_Init ( HSxxxx_t*  sensor, Interface_t*  hal ) {
   sensor -> i2cAddress = 0x54;
   sensor -> interface = NULL;
 
-  if ( !hal -> i2cRead )   return HAL_SetError ( heI2CReadMissing, 0x54, HAL_GetErrorString );
-  if ( !hal -> i2cWrite )   return HAL_SetError ( heI2CWriteMissing, 0x54, HAL_GetErrorString );
+  if ( !hal -> i2cRead )   return HAL_SetInterfaceError ( hal, heI2CReadMissing, 0x54, HAL_GetErrorString );
+  if ( !hal -> i2cWrite )   return HAL_SetInterfaceError ( hal, heI2CWriteMissing, 0x54, HAL_GetErrorString );
 
   sensor -> interface = hal;
-  err = sensor -> interface -> i2cWrite ( sensor -> interface -> handle, 
-                                          sensor -> i2cAddress,
-                                          dummy, 0, dummy, 0 );
+  err = HAL_I2CWrite ( sensor -> interface, 
+                       sensor -> i2cAddress,
+                       dummy, 0, dummy, 0 );
   if ( err )
     sensor -> interface = NULL;
 
@@ -75,9 +79,9 @@ int
 HS4xxx_ReadID ( HSxxxx_t*  sensor, uint32_t*  id ) {
   uint8_t  buf [ 4 ] = { 0xd7, };
 
-  int errorCode = sensor -> interface -> i2cRead ( sensor -> interface -> handle, 
-                                                   sensor -> i2cAddress,
-                                                   buf, 1, buf, 4 );
+  int errorCode = HAL_I2CRead ( sensor -> interface, 
+                                sensor -> i2cAddress,
+                                buf, 1, buf, 4 );
   if ( errorCode )
     return errorCode;
 
@@ -91,10 +95,10 @@ HS4xxx_ReadID ( HSxxxx_t*  sensor, uint32_t*  id ) {
 
 
 static inline int
-_ProcessRawResult ( uint8_t*  raw, HSxxxx_Results_t*  results ) {
+_ProcessRawResult ( HSxxxx_t*  sensor, uint8_t*  raw, HSxxxx_Results_t*  results ) {
 
   if ( _ComputeCRC ( raw, 4 ) != raw [ 4 ] )
-    return HAL_SetError ( hteHS4xxxCRCError, esSensor, _GetErrorString );
+    return HAL_SetInterfaceError ( sensor -> interface, hteHS4xxxCRCError, esSensor, _GetErrorString );
 
   float  humidity    = ( ( raw [ 0 ] & 0x3f ) << 8 ) | raw [ 1 ];
   float  temperature = ( ( raw [ 2 ] & 0x3f ) << 8 ) | raw [ 3 ];
@@ -112,8 +116,8 @@ HS4xxx_Measure ( HSxxxx_t*          sensor,
 
   /* this function requires the msSleep function of the HAL */
   if ( ! sensor -> interface -> msSleep )
-    return HAL_SetError ( heSleepMissing, sensor -> i2cAddress,
-                          HAL_GetErrorString );
+    return HAL_SetInterfaceError ( sensor -> interface, heSleepMissing, sensor -> i2cAddress,
+                                   HAL_GetErrorString );
 
   int errorCode = HS4xxx_MeasureStart ( sensor );
   if ( errorCode )
@@ -132,12 +136,12 @@ HS4xxx_MeasureStart ( HSxxxx_t*  sensor ) {
 
   /* this function requires the i2cWrite function of the HAL */
   if ( ! sensor -> interface -> i2cWrite )
-    return HAL_SetError ( heI2CWriteMissing, sensor -> i2cAddress, 
-                          HAL_GetErrorString );
+    return HAL_SetInterfaceError ( sensor -> interface, heI2CWriteMissing, sensor -> i2cAddress, 
+                                   HAL_GetErrorString );
 
-  return sensor -> interface -> i2cWrite ( sensor -> interface -> handle,
-                                           sensor -> i2cAddress,
-                                           &cmd, 1, NULL, 0 );
+  return HAL_I2CWrite ( sensor -> interface,
+                        sensor -> i2cAddress,
+                        &cmd, 1, NULL, 0 );
 }
 
 
@@ -147,13 +151,13 @@ HS4xxx_MeasureRead ( HSxxxx_t*          sensor,
   uint8_t  buf [ 5 ];
 
   int errorCode = 
-    sensor -> interface -> i2cRead ( sensor -> interface -> handle,
-                                     sensor -> i2cAddress,
-                                     buf, 0, buf, 5 );
+    HAL_I2CRead ( sensor -> interface,
+                  sensor -> i2cAddress,
+                  buf, 0, buf, 5 );
   if ( errorCode )
     return errorCode;
 
-  return _ProcessRawResult ( buf, results );
+  return _ProcessRawResult ( sensor, buf, results );
 }
 
 
@@ -163,11 +167,11 @@ HS4xxx_MeasureHold ( HSxxxx_t*          sensor,
   uint8_t  buf [ 5 ] = { 0xe5, };
 
   int errorCode = 
-    sensor -> interface -> i2cRead ( sensor -> interface -> handle,
-                                     sensor -> i2cAddress,
-                                     buf, 1, buf, 5 );
+    HAL_I2CRead ( sensor -> interface,
+                  sensor -> i2cAddress,
+                  buf, 1, buf, 5 );
   if ( errorCode )
     return errorCode;
 
-  return _ProcessRawResult ( buf, results );
+  return _ProcessRawResult ( sensor, buf, results );
 }
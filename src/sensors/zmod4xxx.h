@@ -35,6 +35,12 @@
 #define HSP_MAX  (8)
 #define RSLT_MAX (32)
 
+#define ZMOD4XXX_INIT_SEQ_TIME_MS   (50)    /**< expected duration of the init sequence */
+#define ZMOD4XXX_INIT_TIMEOUT_MS    (1000)  /**< deadline for the init sequence */
+#define ZMOD4XXX_STOP_TIMEOUT_MS    (10000) /**< deadline for stopping a running sequence */
+#define ZMOD4XXX_POLL_MIN_STEP_MS   (5)     /**< first back-off step after the expected time */
+#define ZMOD4XXX_POLL_MAX_STEP_MS   (200)   /**< upper bound of a single back-off step */
+
 #define STATUS_SEQUENCER_RUNNING_MASK   (0x80) /**< Sequencer is running */
 #define STATUS_SLEEP_TIMER_ENABLED_MASK (0x40) /**< SleepTimer_enabled */
 #define STATUS_ALARM_MASK               (0x20) /**< Alarm */
@@ -92,6 +98,26 @@ zmod4xxx_err zmod4xxx_calc_rmox(zmod4xxx_dev_t *dev, uint8_t *adc_result,
  */
 zmod4xxx_err zmod4xxx_check_error_event(zmod4xxx_dev_t *dev);
 
+/**
+ * @brief   Wait until the sequencer of the device has stopped.
+ * @details The first wait equals the expected sequence duration. If the
+ *          sequencer is still running afterwards, the wait time starts at
+ *          ZMOD4XXX_POLL_MIN_STEP_MS and doubles with every poll, bounded by
+ *          ZMOD4XXX_POLL_MAX_STEP_MS and the remaining time to the deadline.
+ *          The sum of the requested waits and the number of polls are
+ *          stored in dev->poll; the driver has no clock, so the time that
+ *          actually passed is up to the caller to measure.
+ * @param   [in] dev pointer to the device
+ * @param   [in] expected_ms expected duration of the running sequence
+ * @param   [in] timeout_ms hard deadline for the sequencer to stop
+ * @return  error code
+ * @retval  0 success
+ * @retval  ERROR_GAS_TIMEOUT sequencer still running after timeout_ms
+ * @retval  "!= 0" other error
+ */
+zmod4xxx_err zmod4xxx_wait_sequencer(zmod4xxx_dev_t *dev, uint32_t expected_ms,
+                                     uint32_t timeout_ms);
+
 /**
  * @brief   Initialize the sensor for corresponding measurement.
  * @param   [in] dev pointer to the device
@@ -94,6 +94,15 @@ typedef struct {
     uint8_t prod_data_len;
 } zmod4xxx_conf;
 
+/**
+ * @brief Statistics of the last sequencer status poll
+ */
+typedef struct {
+    uint32_t requested_wait_ms; /**< sum of the delays requested from delay_ms();
+                                     the time that passed can be longer */
+    uint16_t polls; /**< number of status register reads */
+} zmod4xxx_poll_stats_t;
+
 /**
  * @brief Device structure ZMOD4xxx
  */
@@ -109,6 +118,7 @@ typedef struct {
     zmod4xxx_delay_ptr_p delay_ms; /**< function pointer to delay function */
     zmod4xxx_conf *init_conf; /**< pointer to the init configuration */
     zmod4xxx_conf *meas_conf; /**< pointer to the measurement configuration */
+    zmod4xxx_poll_stats_t poll; /**< statistics of the last status poll */
 } zmod4xxx_dev_t;
 
 /** @} */
@@ -0,0 +1,187 @@
+// Replay of ZMOD4510 I2C traces (see i2c_trace.h) on a host.
+//
+// The component's driver sequence runs against I2CTraceReplay instead of a
+// bus: the trace answers every read, checks every write, and sleeps return
+// immediately, so hours of device time replay in milliseconds. The first call
+// that differs from the recording is reported, which makes driver changes
+// that alter the bus traffic visible without hardware.
+//
+//   zmod4510_i2c_replay [-a address] [-v] trace
+//
+// The trace is either the raw buffer or the log output of dump_i2c_trace()
+// ("TRACE <offset> <hex>" lines). Captures that include the one-time cleaning
+// procedure are not supported, as the cleaning library is target-only.
+//
+// Build from the repository root:
+//   g++ -O2 -std=c++17 -DUSE_ZMOD4510_I2C_TRACE -Itools/sim/shim -Icomponents/zmod4510
+//       tools/i2c_replay/zmod4510_i2c_replay.cpp components/zmod4510/i2c_trace.cpp
+//       components/zmod4510/hal.cpp components/zmod4510/zmod4xxx.cpp
+//       components/zmod4510/zmod4xxx_hal.cpp components/zmod4510/zmod4510_config_no2_o3.cpp
+//       -o zmod4510_i2c_replay
+// The simulator shim supplies the esphome/core/defines.h the component sources
+// include, and the define enables i2c_trace.cpp.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "i2c_trace.h"
+
+extern "C" {
+#include "zmod4xxx.h"
+#include "zmod4xxx_hal.h"
+#include "zmod4510_config_no2_o3.h"
+}
+
+using namespace zmod4510;
+
+static const uint8_t MAX_READ_RETRIES = 3;
+
+// Load a raw trace, or the hex payload of "TRACE <offset> <hex>" log lines.
+static bool load_trace(const char *path, std::vector<uint8_t> &trace) {
+  FILE *f = fopen(path, "rb");
+  if (f == nullptr) {
+    perror(path);
+    return false;
+  }
+  std::vector<uint8_t> data;
+  uint8_t chunk[4096];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+    data.insert(data.end(), chunk, chunk + n);
+  fclose(f);
+
+  std::string text(data.begin(), data.end());
+  if (text.find("TRACE ") == std::string::npos) {
+    trace = data;
+    return true;
+  }
+  size_t pos = 0;
+  while ((pos = text.find("TRACE ", pos)) != std::string::npos) {
+    unsigned offset;
+    char hex[80];
+    if (sscanf(text.c_str() + pos, "TRACE %x %79[0-9A-Fa-f]", &offset, hex) == 2) {
+      if (offset != trace.size()) {
+        fprintf(stderr, "%s: trace line at offset 0x%X is missing or duplicated\n", path, offset);
+        return false;
+      }
+      for (size_t i = 0; hex[i] != '\0' && hex[i + 1] != '\0'; i += 2) {
+        char byte[3] = {hex[i], hex[i + 1], '\0'};
+        trace.push_back(uint8_t(strtoul(byte, nullptr, 16)));
+      }
+    }
+    pos += 6;
+  }
+  return true;
+}
+
+// Same ADC read as ZMOD4510::read_adc_result_(), including access conflict retries.
+static int read_adc_result(zmod4xxx_dev_t *dev, uint8_t *adc_result) {
+  uint8_t status;
+  int ret = zmod4xxx_read_status(dev, &status);
+  if (ret != ZMOD4XXX_OK)
+    return ret;
+  if (status & STATUS_SEQUENCER_RUNNING_MASK) {
+    ret = zmod4xxx_check_error_event(dev);
+    if (ret != ZMOD4XXX_OK)
+      return ret;
+  }
+  for (uint8_t attempt = 0;; attempt++) {
+    ret = zmod4xxx_read_adc_result(dev, adc_result);
+    if (ret != ZMOD4XXX_OK)
+      return ret;
+    ret = zmod4xxx_check_error_event(dev);
+    if (ret != ERROR_ACCESS_CONFLICT || attempt >= MAX_READ_RETRIES)
+      return ret;
+  }
+}
+
+static void usage() {
+  fprintf(stderr, "usage: zmod4510_i2c_replay [-a address] [-v] trace\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  uint8_t address = 0x33;
+  bool verbose = false;
+  int opt;
+  while ((opt = getopt(argc, argv, "a:v")) != -1) {
+    switch (opt) {
+      case 'a':
+        address = uint8_t(strtoul(optarg, nullptr, 0));
+        break;
+      case 'v':
+        verbose = true;
+        break;
+      default:
+        usage();
+    }
+  }
+  if (optind + 1 != argc)
+    usage();
+
+  std::vector<uint8_t> trace;
+  if (!load_trace(argv[optind], trace))
+    return 1;
+
+  Interface_t hal;
+  I2CTraceReplay replay;
+  replay.init(&hal, trace.data(), trace.size());
+  // The HS humidity sensors share the bus in most setups.
+  replay.set_slave_filter(address);
+
+  uint8_t prod_data[ZMOD4510_PROD_DATA_LEN];
+  zmod4xxx_dev_t dev = {};
+  dev.i2c_addr = address;
+  dev.pid = ZMOD4510_PID;
+  dev.prod_data = prod_data;
+  dev.init_conf = &zmod_no2_o3_sensor_cfg[INIT];
+  dev.meas_conf = &zmod_no2_o3_sensor_cfg[MEASUREMENT];
+
+  auto start = std::chrono::steady_clock::now();
+  int ret = zmod4xxx_init(&dev, &hal);
+  if (ret == ZMOD4XXX_OK)
+    ret = zmod4xxx_read_sensor_info(&dev);
+  if (ret == ZMOD4XXX_OK)
+    ret = zmod4xxx_init_sensor(&dev);
+  if (ret == ZMOD4XXX_OK)
+    ret = zmod4xxx_init_measurement(&dev);
+  if (ret == ZMOD4XXX_OK)
+    ret = zmod4xxx_prepare_sensor(&dev);
+  if (ret != ZMOD4XXX_OK && !replay.has_diverged() && !replay.is_done()) {
+    fprintf(stderr, "setup failed with code %d\n", ret);
+    return 1;
+  }
+
+  uint32_t cycles = 0, errors = 0;
+  uint8_t adc_result[ZMOD4510_ADC_DATA_LEN];
+  float rmox[ZMOD4510_ADC_DATA_LEN / 2];
+  while (!replay.has_diverged() && !replay.is_done()) {
+    ret = zmod4xxx_start_measurement(&dev);
+    if (ret == ZMOD4XXX_OK)
+      ret = read_adc_result(&dev, adc_result);
+    if (replay.has_diverged() || replay.is_done())
+      break;
+    cycles++;
+    if (ret != ZMOD4XXX_OK) {
+      errors++;
+      continue;
+    }
+    zmod4xxx_calc_rmox(&dev, adc_result, rmox);
+    if (verbose)
+      printf("%u: Rmox %.4g %.4g %.4g %.4g\n", cycles, rmox[0], rmox[1], rmox[2], rmox[3]);
+  }
+  double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  printf("%u events, %u measurement cycles, %u with errors\n", replay.get_events(), cycles, errors);
+  printf("%.1f s recorded, replayed in %.2f ms\n", replay.get_recorded_us() / 1e6, wall_ms);
+  if (replay.has_diverged()) {
+    printf("diverged at event %u: %s\n", replay.get_divergence_event(), replay.get_divergence());
+    return 1;
+  }
+  return 0;
+}
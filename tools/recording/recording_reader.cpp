@@ -0,0 +1,99 @@
+#include "recording_reader.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace zmod4510 {
+namespace recording {
+
+bool Block::crc_ok() const {
+  const BlockHeader &h = this->header();
+  return crc32(this->base_ + sizeof(BlockHeader), h.size - sizeof(BlockHeader)) == h.crc;
+}
+
+Recording::~Recording() {
+  if (this->mapping_ != nullptr)
+    munmap(this->mapping_, this->size_);
+}
+
+bool Recording::open(const char *path) {
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0) {
+    this->error_ = std::string("cannot open ") + path;
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    this->error_ = std::string("empty file ") + path;
+    return false;
+  }
+  void *mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    this->error_ = std::string("cannot map ") + path;
+    return false;
+  }
+  this->mapping_ = mapping;
+  this->data_ = static_cast<const uint8_t *>(mapping);
+  this->size_ = st.st_size;
+  return this->index_();
+}
+
+bool Recording::open(const uint8_t *data, size_t size) {
+  this->data_ = data;
+  this->size_ = size;
+  return this->index_();
+}
+
+bool Recording::index_() {
+  const ColumnDesc *columns = nullptr;
+  size_t num_columns = 0;
+  size_t pos = 0;
+  while (pos + sizeof(BlockHeader) <= this->size_) {
+    const uint8_t *p = this->data_ + pos;
+    if (pos + sizeof(FileHeader) <= this->size_ && memcmp(p, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0) {
+      const FileHeader *header = reinterpret_cast<const FileHeader *>(p);
+      size_t directory = header->num_columns * sizeof(ColumnDesc);
+      if (header->version == FORMAT_VERSION && pos + sizeof(FileHeader) + directory <= this->size_) {
+        if (this->header_ == nullptr)
+          this->header_ = header;
+        columns = reinterpret_cast<const ColumnDesc *>(p + sizeof(FileHeader));
+        num_columns = header->num_columns;
+        pos += sizeof(FileHeader) + directory;
+        continue;
+      }
+    }
+    uint32_t magic;
+    memcpy(&magic, p, sizeof(magic));
+    if (magic == BLOCK_MAGIC && columns != nullptr) {
+      const BlockHeader *header = reinterpret_cast<const BlockHeader *>(p);
+      if (header->size == column_offset(columns, num_columns, header->capacity) && header->rows <= header->capacity) {
+        if (pos + header->size > this->size_) {
+          this->bad_blocks_++;  // Truncated capture.
+          break;
+        }
+        Block block(p, columns, num_columns);
+        if (block.crc_ok()) {
+          this->blocks_.push_back(block);
+          this->rows_ += header->rows;
+          pos += header->size;
+          continue;
+        }
+        this->bad_blocks_++;
+      }
+    }
+    // Not at a structure boundary: resynchronize on the next byte.
+    pos++;
+  }
+  if (this->header_ == nullptr) {
+    this->error_ = "no recording header found";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace recording
+}  // namespace zmod4510
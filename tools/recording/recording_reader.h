@@ -0,0 +1,100 @@
+#pragma once
+
+// Host-side reader for ZMOD4510 recordings (see recording_format.h). The file
+// is memory-mapped and columns are returned as pointers into the mapping, so
+// analysis code reads them without copying or parsing rows.
+//
+// Captures may contain several streams back to back (e.g. a UART capture
+// across device reboots) and junk between them; the reader resynchronizes on
+// the next file or block magic.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../../components/zmod4510/recording_format.h"
+
+namespace zmod4510 {
+namespace recording {
+
+// Contiguous values of one column inside a block.
+template<typename T> struct Column {
+  const T *data{nullptr};
+  size_t rows{0};
+  size_t count{0};  // Elements per row
+
+  bool empty() const { return this->data == nullptr; }
+  const T *row(size_t r) const { return this->data + r * this->count; }
+  T operator()(size_t r, size_t i = 0) const { return this->data[r * this->count + i]; }
+};
+
+class Block {
+ public:
+  Block(const uint8_t *base, const ColumnDesc *columns, size_t num_columns)
+      : base_(base), columns_(columns), num_columns_(num_columns) {}
+
+  const BlockHeader &header() const { return *reinterpret_cast<const BlockHeader *>(this->base_); }
+  size_t rows() const { return this->header().rows; }
+  bool crc_ok() const;
+
+  // Zero-copy view of column `id`; empty if the column is missing or its
+  // element size does not match T.
+  template<typename T> Column<T> column(uint16_t id) const {
+    Column<T> result;
+    for (size_t i = 0; i < this->num_columns_; i++) {
+      if (this->columns_[i].id != id)
+        continue;
+      if (type_size(this->columns_[i].type) != sizeof(T))
+        return result;
+      size_t offset = column_offset(this->columns_, i, this->header().capacity);
+      result.data = reinterpret_cast<const T *>(this->base_ + offset);
+      result.rows = this->rows();
+      result.count = this->columns_[i].count;
+      return result;
+    }
+    return result;
+  }
+
+ protected:
+  const uint8_t *base_;
+  const ColumnDesc *columns_;
+  size_t num_columns_;
+};
+
+class Recording {
+ public:
+  Recording() = default;
+  Recording(const Recording &) = delete;
+  Recording &operator=(const Recording &) = delete;
+  ~Recording();
+
+  // Map `path` and index its blocks. Returns false with error() set if the
+  // file cannot be read or holds no recording.
+  bool open(const char *path);
+  // Index a recording that is already in memory; `data` must outlive this.
+  bool open(const uint8_t *data, size_t size);
+
+  const std::string &error() const { return this->error_; }
+  size_t num_blocks() const { return this->blocks_.size(); }
+  const Block &block(size_t index) const { return this->blocks_[index]; }
+  size_t num_rows() const { return this->rows_; }
+  // Header of the first stream in the file.
+  const FileHeader &header() const { return *this->header_; }
+  // Blocks dropped because of a bad CRC or a truncated end.
+  size_t num_bad_blocks() const { return this->bad_blocks_; }
+
+ protected:
+  bool index_();
+
+  const uint8_t *data_{nullptr};
+  size_t size_{0};
+  void *mapping_{nullptr};
+  const FileHeader *header_{nullptr};
+  std::vector<Block> blocks_;
+  size_t rows_{0};
+  size_t bad_blocks_{0};
+  std::string error_;
+};
+
+}  // namespace recording
+}  // namespace zmod4510
@@ -0,0 +1,91 @@
+#include "algorithm_backend.h"
+#include <cmath>
+#include <cstring>
+
+#ifdef REPLAY_HAVE_NO2_O3
+extern "C" {
+#include "no2_o3.h"
+}
+#endif
+
+namespace zmod4510 {
+namespace replay {
+
+// Rmox only; for checking driver changes without the algorithm library.
+class RmoxStream : public AlgorithmStream {
+ public:
+  void process(zmod4xxx_dev_t *dev, uint8_t *adc_result, float humidity, float temperature,
+               AlgorithmOutput &output) override {
+    output = AlgorithmOutput{NAN, NAN, 0, 0, 0};
+  }
+};
+
+class RmoxBackend : public AlgorithmBackend {
+ public:
+  const char *get_name() const override { return "rmox"; }
+  bool has_gas_outputs() const override { return false; }
+  std::unique_ptr<AlgorithmStream> create_stream() const override {
+    return std::unique_ptr<AlgorithmStream>(new RmoxStream());
+  }
+};
+
+#ifdef REPLAY_HAVE_NO2_O3
+// Renesas NO2/O3 algorithm; needs a host build of lib_no2_o3.
+class NO2O3Stream : public AlgorithmStream {
+ public:
+  NO2O3Stream() { init_no2_o3(&this->handle_); }
+  void process(zmod4xxx_dev_t *dev, uint8_t *adc_result, float humidity, float temperature,
+               AlgorithmOutput &output) override {
+    no2_o3_inputs_t inputs{adc_result, humidity, temperature};
+    no2_o3_results_t results;
+    output.status = calc_no2_o3(&this->handle_, dev, &inputs, &results);
+    output.no2 = results.NO2_conc_ppb;
+    output.o3 = results.O3_conc_ppb;
+    output.fast_aqi = results.FAST_AQI;
+    output.epa_aqi = results.EPA_AQI;
+  }
+
+ protected:
+  no2_o3_handle_t handle_;
+};
+
+class NO2O3Backend : public AlgorithmBackend {
+ public:
+  const char *get_name() const override { return "no2_o3"; }
+  bool has_gas_outputs() const override { return true; }
+  std::unique_ptr<AlgorithmStream> create_stream() const override {
+    return std::unique_ptr<AlgorithmStream>(new NO2O3Stream());
+  }
+};
+#endif
+
+static const RmoxBackend RMOX_BACKEND;
+#ifdef REPLAY_HAVE_NO2_O3
+static const NO2O3Backend NO2_O3_BACKEND;
+#endif
+
+static const AlgorithmBackend *const BACKENDS[] = {
+#ifdef REPLAY_HAVE_NO2_O3
+    &NO2_O3_BACKEND,
+#endif
+    &RMOX_BACKEND,
+};
+
+const AlgorithmBackend *find_backend(const char *name) {
+  for (const AlgorithmBackend *backend : BACKENDS) {
+    if (strcmp(backend->get_name(), name) == 0)
+      return backend;
+  }
+  return nullptr;
+}
+
+const char *get_backend_names() {
+#ifdef REPLAY_HAVE_NO2_O3
+  return "no2_o3 rmox";
+#else
+  return "rmox";
+#endif
+}
+
+}  // namespace replay
+}  // namespace zmod4510
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+extern "C" {
+#include "zmod4xxx_types.h"
+}
+
+namespace zmod4510 {
+namespace replay {
+
+struct AlgorithmOutput {
+  float no2;
+  float o3;
+  uint16_t fast_aqi;
+  uint16_t epa_aqi;
+  int status;
+};
+
+// Algorithm state of one sensor stream. Instances are never shared between
+// streams, so backends need no locking.
+class AlgorithmStream {
+ public:
+  virtual ~AlgorithmStream() = default;
+  // Feed one measurement; `dev` holds the stream's calibration.
+  virtual void process(zmod4xxx_dev_t *dev, uint8_t *adc_result, float humidity, float temperature,
+                       AlgorithmOutput &output) = 0;
+};
+
+class AlgorithmBackend {
+ public:
+  virtual ~AlgorithmBackend() = default;
+  virtual const char *get_name() const = 0;
+  // False if the backend's outputs are not comparable with the recorded ones.
+  virtual bool has_gas_outputs() const = 0;
+  virtual std::unique_ptr<AlgorithmStream> create_stream() const = 0;
+};
+
+// Look up a backend by name; nullptr if unknown.
+const AlgorithmBackend *find_backend(const char *name);
+// Space-separated list of the compiled-in backends.
+const char *get_backend_names();
+
+}  // namespace replay
+}  // namespace zmod4510
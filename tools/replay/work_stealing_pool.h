@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace zmod4510 {
+namespace replay {
+
+// Fixed-size thread pool with one task queue per worker. Workers take tasks
+// from the back of their own queue and steal from the front of the others
+// when it runs dry, so a few long streams do not leave cores idle.
+class WorkStealingPool {
+ public:
+  explicit WorkStealingPool(unsigned threads) {
+    if (threads == 0)
+      threads = 1;
+    for (unsigned i = 0; i < threads; i++)
+      this->queues_.emplace_back(new Queue());
+    for (unsigned i = 0; i < threads; i++)
+      this->threads_.emplace_back([this, i] { this->run_(i); });
+  }
+
+  ~WorkStealingPool() {
+    {
+      std::lock_guard<std::mutex> guard(this->lock_);
+      this->stop_ = true;
+    }
+    this->work_cv_.notify_all();
+    for (auto &thread : this->threads_)
+      thread.join();
+  }
+
+  unsigned size() const { return this->threads_.size(); }
+
+  void submit(std::function<void()> task) {
+    unsigned index = this->next_queue_++ % this->queues_.size();
+    // Count the task before it becomes visible: a worker may take it, and
+    // decrement both counters, as soon as it is in the queue.
+    {
+      std::lock_guard<std::mutex> guard(this->lock_);
+      this->pending_++;
+      this->queued_++;
+    }
+    {
+      std::lock_guard<std::mutex> guard(this->queues_[index]->lock);
+      this->queues_[index]->tasks.push_back(std::move(task));
+    }
+    this->work_cv_.notify_one();
+  }
+
+  // Block until every submitted task has finished.
+  void wait() {
+    std::unique_lock<std::mutex> guard(this->lock_);
+    this->done_cv_.wait(guard, [this] { return this->pending_ == 0; });
+  }
+
+ protected:
+  struct Queue {
+    std::mutex lock;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  bool take_(unsigned self, std::function<void()> &task) {
+    {
+      Queue &own = *this->queues_[self];
+      std::lock_guard<std::mutex> guard(own.lock);
+      if (!own.tasks.empty()) {
+        task = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        return true;
+      }
+    }
+    for (size_t i = 1; i < this->queues_.size(); i++) {
+      Queue &victim = *this->queues_[(self + i) % this->queues_.size()];
+      std::lock_guard<std::mutex> guard(victim.lock);
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void run_(unsigned self) {
+    for (;;) {
+      std::function<void()> task;
+      if (this->take_(self, task)) {
+        {
+          std::lock_guard<std::mutex> guard(this->lock_);
+          this->queued_--;
+        }
+        task();
+        std::lock_guard<std::mutex> guard(this->lock_);
+        if (--this->pending_ == 0)
+          this->done_cv_.notify_all();
+        continue;
+      }
+      std::unique_lock<std::mutex> guard(this->lock_);
+      this->work_cv_.wait(guard, [this] { return this->stop_ || this->queued_ > 0; });
+      if (this->stop_)
+        return;
+    }
+  }
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> threads_;
+  std::atomic<unsigned> next_queue_{0};
+  std::mutex lock_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  size_t pending_{0};  // Submitted and not finished
+  size_t queued_{0};   // Submitted and not taken by a worker
+  bool stop_{false};
+};
+
+}  // namespace replay
+}  // namespace zmod4510
@@ -0,0 +1,220 @@
+// Offline replay of ZMOD4510 recordings (see recording_format.h).
+//
+// Every recording is one sensor stream. The raw ADC frames are run through
+// zmod4xxx_calc_rmox() and an algorithm backend with the stream's own
+// calibration and state, and the results are compared with what the device
+// reported. Streams are spread over all cores by a work-stealing pool.
+//
+//   zmod4510_replay [-b backend] [-j threads] [-o output_dir] recording...
+//
+// Build from the repository root:
+//   g++ -O2 -std=c++17 -pthread -Icomponents/zmod4510 tools/replay/*.cpp
+//       tools/recording/recording_reader.cpp components/zmod4510/zmod4xxx.cpp
+//       components/zmod4510/zmod4510_config_no2_o3.cpp -o zmod4510_replay
+// Add -DREPLAY_HAVE_NO2_O3 and a host build of lib_no2_o3 for the "no2_o3"
+// backend.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "../recording/recording_reader.h"
+#include "algorithm_backend.h"
+#include "work_stealing_pool.h"
+
+extern "C" {
+#include "zmod4xxx.h"
+#include "zmod4510_config_no2_o3.h"
+}
+
+using namespace zmod4510;
+using namespace zmod4510::recording;
+using namespace zmod4510::replay;
+
+static const size_t NUM_RMOX = 16;  // measurement config reads 32 ADC bytes
+
+struct StreamResult {
+  std::string path;
+  std::string error;
+  size_t size{0};
+  size_t rows{0};
+  size_t blocks{0};
+  size_t bad_blocks{0};
+  size_t stabilizing{0};
+  size_t status_mismatches{0};
+  float max_no2_diff{0.0f};
+  float max_o3_diff{0.0f};
+};
+
+static void replay_stream(const AlgorithmBackend *backend, const char *output_dir, StreamResult &result) {
+  Recording rec;
+  if (!rec.open(result.path.c_str())) {
+    result.error = rec.error();
+    return;
+  }
+  const FileHeader &header = rec.header();
+  result.blocks = rec.num_blocks();
+  result.bad_blocks = rec.num_bad_blocks();
+
+  // Per-stream device state, built from the calibration in the header.
+  uint8_t prod_data[sizeof(header.prod_data)];
+  memcpy(prod_data, header.prod_data, sizeof(prod_data));
+  zmod4xxx_dev_t dev;
+  memset(&dev, 0, sizeof(dev));
+  dev.pid = header.pid;
+  dev.mox_lr = header.mox_lr;
+  dev.mox_er = header.mox_er;
+  memcpy(dev.config, header.config, sizeof(dev.config));
+  dev.prod_data = prod_data;
+  dev.init_conf = &zmod_no2_o3_sensor_cfg[INIT];
+  dev.meas_conf = &zmod_no2_o3_sensor_cfg[MEASUREMENT];
+  std::unique_ptr<AlgorithmStream> stream = backend->create_stream();
+
+  FILE *out = nullptr;
+  if (output_dir != nullptr) {
+    std::string name = result.path.substr(result.path.find_last_of('/') + 1);
+    std::string out_path = std::string(output_dir) + "/" + name + ".csv";
+    out = fopen(out_path.c_str(), "w");
+    if (out == nullptr) {
+      result.error = "cannot write " + out_path;
+      return;
+    }
+    fprintf(out, "timestamp_ms");
+    for (size_t i = 0; i < NUM_RMOX; i++)
+      fprintf(out, ",rmox_%zu", i);
+    fprintf(out, ",status,no2,o3,fast_aqi,epa_aqi,recorded_status,recorded_no2,recorded_o3\n");
+  }
+
+  for (size_t b = 0; b < rec.num_blocks(); b++) {
+    const Block &block = rec.block(b);
+    Column<uint32_t> timestamp = block.column<uint32_t>(COLUMN_TIMESTAMP_MS);
+    Column<uint8_t> adc = block.column<uint8_t>(COLUMN_ADC_RESULT);
+    Column<float> humidity = block.column<float>(COLUMN_HUMIDITY);
+    Column<float> temperature = block.column<float>(COLUMN_TEMPERATURE);
+    Column<float> no2 = block.column<float>(COLUMN_NO2);
+    Column<float> o3 = block.column<float>(COLUMN_O3);
+    Column<int8_t> status = block.column<int8_t>(COLUMN_ALGO_STATUS);
+    if (adc.empty() || adc.count != ZMOD4510_ADC_DATA_LEN || humidity.empty() || temperature.empty()) {
+      result.error = "recording lacks ADC frames or inputs";
+      break;
+    }
+    for (size_t r = 0; r < block.rows(); r++) {
+      uint8_t frame[ZMOD4510_ADC_DATA_LEN];
+      memcpy(frame, adc.row(r), sizeof(frame));
+      float rmox[NUM_RMOX];
+      zmod4xxx_calc_rmox(&dev, frame, rmox);
+      AlgorithmOutput output;
+      stream->process(&dev, frame, humidity(r), temperature(r), output);
+
+      result.rows++;
+      if (output.status == 1)
+        result.stabilizing++;
+      if (backend->has_gas_outputs() && !status.empty()) {
+        if (output.status != status(r)) {
+          result.status_mismatches++;
+        } else if (output.status == 0 && !no2.empty() && !o3.empty()) {
+          result.max_no2_diff = std::max(result.max_no2_diff, std::fabs(output.no2 - no2(r)));
+          result.max_o3_diff = std::max(result.max_o3_diff, std::fabs(output.o3 - o3(r)));
+        }
+      }
+      if (out != nullptr) {
+        fprintf(out, "%u", timestamp.empty() ? 0u : timestamp(r));
+        for (float value : rmox)
+          fprintf(out, ",%.6g", value);
+        fprintf(out, ",%d,%.3f,%.3f,%u,%u,%d,%.3f,%.3f\n", output.status, output.no2, output.o3, output.fast_aqi,
+                output.epa_aqi, status.empty() ? 0 : status(r), no2.empty() ? NAN : no2(r), o3.empty() ? NAN : o3(r));
+      }
+    }
+  }
+  if (out != nullptr)
+    fclose(out);
+}
+
+static void usage(const char *name) {
+  fprintf(stderr, "usage: %s [-b backend] [-j threads] [-o output_dir] recording...\n", name);
+  fprintf(stderr, "backends: %s\n", get_backend_names());
+}
+
+int main(int argc, char **argv) {
+  const char *backend_name = "rmox";
+  const char *output_dir = nullptr;
+  unsigned threads = std::thread::hardware_concurrency();
+  int opt;
+  while ((opt = getopt(argc, argv, "b:j:o:h")) != -1) {
+    switch (opt) {
+      case 'b':
+        backend_name = optarg;
+        break;
+      case 'j':
+        threads = strtoul(optarg, nullptr, 10);
+        break;
+      case 'o':
+        output_dir = optarg;
+        break;
+      default:
+        usage(argv[0]);
+        return 2;
+    }
+  }
+  if (optind >= argc) {
+    usage(argv[0]);
+    return 2;
+  }
+  const AlgorithmBackend *backend = find_backend(backend_name);
+  if (backend == nullptr) {
+    fprintf(stderr, "unknown backend '%s'\n", backend_name);
+    usage(argv[0]);
+    return 2;
+  }
+
+  std::vector<StreamResult> results(argc - optind);
+  std::vector<size_t> order(results.size());
+  for (size_t i = 0; i < results.size(); i++) {
+    results[i].path = argv[optind + i];
+    struct stat st;
+    results[i].size = stat(argv[optind + i], &st) == 0 ? st.st_size : 0;
+    order[i] = i;
+  }
+  // Longest streams first keeps the tail of the run short.
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return results[a].size > results[b].size; });
+
+  auto start = std::chrono::steady_clock::now();
+  {
+    WorkStealingPool pool(threads);
+    for (size_t i : order) {
+      StreamResult *result = &results[i];
+      pool.submit([backend, output_dir, result] { replay_stream(backend, output_dir, *result); });
+    }
+    pool.wait();
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  size_t rows = 0;
+  int failed = 0;
+  for (const StreamResult &result : results) {
+    if (!result.error.empty()) {
+      printf("%s: error: %s\n", result.path.c_str(), result.error.c_str());
+      failed++;
+      continue;
+    }
+    rows += result.rows;
+    printf("%s: %zu rows in %zu blocks (%zu bad), %zu stabilizing", result.path.c_str(), result.rows, result.blocks,
+           result.bad_blocks, result.stabilizing);
+    if (backend->has_gas_outputs()) {
+      printf(", %zu status mismatches, max |dNO2| %.3f ppb, max |dO3| %.3f ppb", result.status_mismatches,
+             result.max_no2_diff, result.max_o3_diff);
+    }
+    printf("\n");
+  }
+  printf("%zu streams, %zu rows, %s backend, %u threads: %.3f s (%.0f rows/s)\n", results.size(), rows,
+         backend->get_name(), threads, seconds, rows / (seconds > 0 ? seconds : 1));
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,243 @@
+#include "async_hal_test.h"
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "async_hal.h"
+#include "esphome/core/hal.h"
+#include "esphome_hal.h"
+#include "simulated_async_bus.h"
+#include "simulated_bus.h"
+#include "virtual_clock.h"
+#include "zmod4510_simulator.h"
+#include "zmod4xxx_async.h"
+
+extern "C" {
+#include "zmod4xxx.h"
+#include "zmod4xxx_hal.h"
+#include "zmod4510_config_no2_o3.h"
+}
+
+namespace zmod4510 {
+namespace sim {
+
+#ifdef USE_ZMOD4510_ASYNC_HAL
+
+static const uint8_t FIRST_ADDRESS = 0x10;
+// Duration of the simulated measurement sequence, and the deadline for it.
+static const uint32_t MEASUREMENT_MS = 4000;
+static const uint32_t MEASUREMENT_TIMEOUT_MS = 2 * MEASUREMENT_MS;
+
+struct Sensor {
+  explicit Sensor(uint8_t address) : device(address) {}
+
+  ZMOD4510Simulator device;
+  zmod4xxx_dev_t dev{};
+  uint8_t prod_data[ZMOD4510_PROD_DATA_LEN];
+  uint8_t adc_result[ZMOD4510_ADC_DATA_LEN];
+  AsyncSequencerWait wait;
+  uint32_t cycles{0};
+  uint32_t failures{0};
+  uint32_t polls{0};
+  bool ready{false};
+  int result{0};
+};
+
+struct RunResult {
+  uint64_t elapsed_us{0};
+  uint64_t blocked_us{0};
+  uint32_t cycles{0};
+  uint32_t failures{0};
+  uint32_t polls{0};
+  uint32_t measurements{0};
+};
+
+static std::vector<std::unique_ptr<Sensor>> make_sensors(const AsyncHalOptions &options, SimulatedBus &bus) {
+  std::vector<std::unique_ptr<Sensor>> sensors;
+  for (uint8_t i = 0; i < options.sensors; i++) {
+    sensors.emplace_back(new Sensor(FIRST_ADDRESS + i));
+    Sensor &sensor = *sensors.back();
+    sensor.device.set_measurement_ms(MEASUREMENT_MS);
+    bus.add_device(FIRST_ADDRESS + i, &sensor.device);
+    sensor.dev.i2c_addr = FIRST_ADDRESS + i;
+    sensor.dev.pid = ZMOD4510_PID;
+    sensor.dev.prod_data = sensor.prod_data;
+    sensor.dev.init_conf = &zmod_no2_o3_sensor_cfg[INIT];
+    sensor.dev.meas_conf = &zmod_no2_o3_sensor_cfg[MEASUREMENT];
+  }
+  return sensors;
+}
+
+static bool bring_up(Sensor &sensor, Interface_t *hal) {
+  int ret = zmod4xxx_init(&sensor.dev, hal);
+  if (ret == ZMOD4XXX_OK)
+    ret = zmod4xxx_read_sensor_info(&sensor.dev);
+  if (ret == ZMOD4XXX_OK)
+    ret = zmod4xxx_prepare_sensor(&sensor.dev);
+  return ret == ZMOD4XXX_OK;
+}
+
+static void finish(std::vector<std::unique_ptr<Sensor>> &sensors, RunResult &result) {
+  for (auto &sensor : sensors) {
+    result.cycles += sensor->cycles;
+    result.failures += sensor->failures;
+    result.polls += sensor->polls;
+    result.measurements += sensor->device.get_measurements();
+    zmod4xxx_deinit(&sensor->dev);
+  }
+}
+
+// A chain of blocking calls: one sensor after the other.
+static RunResult run_blocking(const AsyncHalOptions &options) {
+  RunResult result;
+  SimulatedBus bus;
+  bus.set_frequency(options.hz);
+  auto sensors = make_sensors(options, bus);
+  Interface_t hal;
+  esphome_hal_init(&hal, &bus);
+  for (auto &sensor : sensors) {
+    if (!bring_up(*sensor, &hal))
+      sensor->failures++;
+  }
+
+  uint64_t start_us = virtual_clock().now_us();
+  for (uint32_t cycle = 0; cycle < options.cycles; cycle++) {
+    for (auto &sensor : sensors) {
+      int ret = zmod4xxx_start_measurement(&sensor->dev);
+      if (ret == ZMOD4XXX_OK) {
+        ret = zmod4xxx_wait_sequencer(&sensor->dev, MEASUREMENT_MS, MEASUREMENT_TIMEOUT_MS);
+        sensor->polls += sensor->dev.poll.polls;
+      }
+      if (ret == ZMOD4XXX_OK)
+        ret = zmod4xxx_read_adc_result(&sensor->dev, sensor->adc_result);
+      if (ret != ZMOD4XXX_OK)
+        sensor->failures++;
+      sensor->cycles++;
+    }
+  }
+  // Every driver call holds the CPU until it returns.
+  result.elapsed_us = virtual_clock().now_us() - start_us;
+  result.blocked_us = result.elapsed_us;
+  finish(sensors, result);
+  return result;
+}
+
+static void sequencer_done(void *context, int result) {
+  auto *sensor = static_cast<Sensor *>(context);
+  sensor->result = result;
+  sensor->ready = true;
+}
+
+static void start_cycle(Sensor &sensor, AsyncInterface *async_hal) {
+  if (zmod4xxx_start_measurement(&sensor.dev) != ZMOD4XXX_OK ||
+      sensor.wait.start(async_hal, sensor.dev.i2c_addr, MEASUREMENT_MS, MEASUREMENT_TIMEOUT_MS, sequencer_done,
+                        &sensor) != ecSuccess) {
+    sensor.failures++;
+    sensor.result = ERROR_I2C;
+    sensor.ready = true;
+  }
+}
+
+// Each sensor runs its own cycles; the loop idles whenever nothing is due.
+// With `dma` the AsyncInterface is the DMA-like backend and the drivers'
+// own calls go through the BlockingAdapter; otherwise it is the AsyncAdapter
+// on the blocking ESPHome HAL, which the drivers use directly.
+static RunResult run_async(const AsyncHalOptions &options, bool dma) {
+  RunResult result;
+  SimulatedBus bus;
+  if (!dma)
+    bus.set_frequency(options.hz);
+  auto sensors = make_sensors(options, bus);
+  SimulatedAsyncBus async_bus(&bus, options.hz);
+  BlockingAdapter blocking;
+  AsyncAdapter adapter;
+  AsyncInterface async_hal;
+  Interface_t hal;
+  if (dma) {
+    async_bus.init(&async_hal);
+    blocking.wrap(&async_hal, &hal);
+  } else {
+    esphome_hal_init(&hal, &bus);
+    adapter.wrap(&hal, &async_hal, esphome::millis);
+  }
+  // Blocking transfers hold the CPU for their wire time.
+  auto blocked_us = [&]() { return dma ? async_bus.get_waited_us() : bus.get_busy_us(); };
+  for (auto &sensor : sensors) {
+    if (!bring_up(*sensor, &hal))
+      sensor->failures++;
+  }
+
+  uint64_t start_us = virtual_clock().now_us();
+  uint64_t blocked_start_us = blocked_us();
+  for (auto &sensor : sensors)
+    start_cycle(*sensor, &async_hal);
+  uint8_t running = options.sensors;
+  while (running != 0) {
+    async_hal.poll(async_hal.handle);
+    bool served = false;
+    for (auto &sensor : sensors) {
+      if (!sensor->ready)
+        continue;
+      sensor->ready = false;
+      served = true;
+      sensor->polls += sensor->wait.get_polls();
+      int ret = sensor->result;
+      if (ret == ZMOD4XXX_OK)
+        ret = zmod4xxx_read_adc_result(&sensor->dev, sensor->adc_result);
+      if (ret != ZMOD4XXX_OK)
+        sensor->failures++;
+      if (++sensor->cycles < options.cycles)
+        start_cycle(*sensor, &async_hal);
+      else
+        running--;
+    }
+    // Idle until the next completion: free time for the rest of the loop.
+    if (served)
+      continue;
+    if (!dma)
+      virtual_clock().advance_ms(1);
+    else if (async_bus.get_next_due_us() != UINT64_MAX)
+      virtual_clock().advance_to_us(async_bus.get_next_due_us());
+  }
+  result.elapsed_us = virtual_clock().now_us() - start_us;
+  result.blocked_us = blocked_us() - blocked_start_us;
+  finish(sensors, result);
+  return result;
+}
+
+static bool report(const char *name, const RunResult &result, const AsyncHalOptions &options) {
+  printf("%-14s %8u %8u %9.1f %11.3f %8.3f%% %9.2f\n", name, result.cycles, result.failures, result.elapsed_us / 1e6,
+         result.blocked_us / 1e6, 100.0 * result.blocked_us / result.elapsed_us,
+         result.cycles ? double(result.polls) / result.cycles : 0.0);
+  uint32_t expected = uint32_t(options.sensors) * options.cycles;
+  return result.cycles == expected && result.measurements == expected && result.failures == 0;
+}
+
+int run_async_hal_test(const AsyncHalOptions &options) {
+  if (options.sensors == 0 || options.sensors > 32) {
+    printf("async HAL test needs 1 to 32 sensors\n");
+    return 2;
+  }
+  printf("async HAL: %u ZMOD4510 on one %u kHz bus, %u cycles each, %u ms measurement sequence\n", options.sensors,
+         options.hz / 1000, options.cycles, MEASUREMENT_MS);
+  printf("%-14s %8s %8s %9s %11s %9s %9s\n", "HAL", "cycles", "failures", "time [s]", "blocked [s]", "blocked",
+         "polls");
+  bool ok = report("blocking", run_blocking(options), options);
+  ok &= report("async adapter", run_async(options, false), options);
+  ok &= report("async DMA", run_async(options, true), options);
+  printf("(blocked: time the CPU spent inside HAL calls; polls: status reads per cycle)\n");
+  return ok ? 0 : 1;
+}
+
+#else
+
+int run_async_hal_test(const AsyncHalOptions &options) {
+  printf("the async HAL test needs a build with -DUSE_ZMOD4510_ASYNC_HAL\n");
+  return 2;
+}
+
+#endif
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zmod4510 {
+namespace sim {
+
+struct AsyncHalOptions {
+  uint8_t sensors{4};
+  uint32_t cycles{100};
+  uint32_t hz{400000};
+};
+
+// Runs measurement cycles of several ZMOD4510s on one bus three times: as a
+// chain of blocking driver calls, and event-driven with AsyncSequencerWait
+// on two AsyncInterface backends: the AsyncAdapter on the blocking ESPHome
+// HAL, and a model of a DMA controller that completes transfers after their
+// wire time, with the remaining driver calls through the BlockingAdapter.
+// Prints how much of each run the CPU was blocked in HAL calls; returns 0 if
+// every run completed every cycle.
+int run_async_hal_test(const AsyncHalOptions &options);
+
+}  // namespace sim
+}  // namespace zmod4510
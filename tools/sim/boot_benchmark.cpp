@@ -0,0 +1,299 @@
+#include "boot_benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include "simulated_bus.h"
+#include "virtual_clock.h"
+#include "zmod4510_component.h"
+#include "zmod4510_simulator.h"
+
+namespace zmod4510 {
+namespace sim {
+
+using WallClock = std::chrono::steady_clock;
+
+static const uint32_t ARDUINO_HAL_INIT_MS = 2500;
+static const uint32_t ARDUINO_READ_DELAY_MS = 10;
+
+// Bus timing of the Arduino HAL (hal/arduino/arduino.cpp) around the simulator.
+class ArduinoWireTiming : public esphome::i2c::I2CBus {
+ public:
+  explicit ArduinoWireTiming(esphome::i2c::I2CBus *bus) : bus_(bus) {}
+
+  esphome::i2c::ErrorCode read(uint8_t address, uint8_t *buffer, size_t len) override {
+    return this->bus_->read(address, buffer, len);
+  }
+  esphome::i2c::ErrorCode write(uint8_t address, const uint8_t *buffer, size_t len, bool stop) override {
+    esphome::i2c::ErrorCode err = this->bus_->write(address, buffer, len, stop);
+    if (!stop)
+      esphome::delay(ARDUINO_READ_DELAY_MS);
+    return err;
+  }
+
+ protected:
+  esphome::i2c::I2CBus *bus_;
+};
+
+// The component with a note of when its first valid result was ready.
+class ProbedZMOD4510 : public ZMOD4510 {
+ public:
+  void loop() override {
+    ZMOD4510::loop();
+    if (this->results_valid_ && !this->valid_) {
+      this->valid_ = true;
+      this->on_valid();
+    }
+  }
+
+  std::function<void()> on_valid;
+
+ protected:
+  bool valid_{false};
+};
+
+enum Mark : uint8_t {
+  MARK_BOOT,
+  MARK_SETUP,
+  MARK_PROBE,
+  MARK_SENSOR_INFO,
+  MARK_CLEANING,
+  MARK_INIT_SEQUENCE,
+  MARK_MEASURING,
+  MARK_VALID,
+  MARK_PUBLISH,
+  NUM_MARKS,
+};
+
+struct BootTimes {
+  bool seen[NUM_MARKS]{};
+  uint64_t virtual_us[NUM_MARKS]{};
+  WallClock::time_point wall[NUM_MARKS];
+
+  void mark(Mark m) {
+    if (this->seen[m])
+      return;
+    this->seen[m] = true;
+    this->virtual_us[m] = virtual_clock().now_us();
+    this->wall[m] = WallClock::now();
+  }
+};
+
+// Boot the node once and run it until the first valid publish or `limit_s`.
+static void boot(esphome::i2c::I2CBus *bus, ZMOD4510Simulator &device, const BootBenchmarkOptions &options,
+                 BootTimes &times, uint32_t limit_s) {
+  virtual_clock().reboot();
+  esphome::App.reset();
+  esphome::App.set_loop_interval(options.loop_ms);
+  times.mark(MARK_BOOT);
+
+  device.set_event_callback([&times](ZMOD4510Simulator::Event event) {
+    switch (event) {
+      case ZMOD4510Simulator::EVENT_PROBE:
+        times.mark(MARK_PROBE);
+        break;
+      case ZMOD4510Simulator::EVENT_SENSOR_INFO:
+        times.mark(MARK_SENSOR_INFO);
+        break;
+      case ZMOD4510Simulator::EVENT_CLEANING:
+        times.mark(MARK_CLEANING);
+        break;
+      case ZMOD4510Simulator::EVENT_INIT_SEQUENCE:
+        times.mark(MARK_INIT_SEQUENCE);
+        break;
+      case ZMOD4510Simulator::EVENT_MEASUREMENT:
+        times.mark(MARK_MEASURING);
+        break;
+      default:
+        break;
+    }
+  });
+
+  ProbedZMOD4510 component;
+  esphome::sensor::Sensor no2("NO2");
+  component.set_i2c_bus(bus);
+  component.set_i2c_address(ZMOD4510Simulator::ADDRESS);
+  component.set_update_interval(options.update_s * 1000);
+  component.set_no2_sensor(&no2);
+  component.on_valid = [&times]() { times.mark(MARK_VALID); };
+  no2.add_on_state_callback([&times](float) { times.mark(MARK_PUBLISH); });
+  esphome::App.register_component(&component);
+
+  if (options.arduino_hal)
+    esphome::delay(ARDUINO_HAL_INIT_MS);
+  times.mark(MARK_SETUP);
+  esphome::App.setup();
+  uint64_t limit_ms = uint64_t(limit_s) * 1000;
+  while (!times.seen[MARK_PUBLISH] && virtual_clock().uptime_us() / 1000 < limit_ms)
+    esphome::App.loop();
+  esphome::App.shutdown();
+  esphome::App.reset();
+  device.set_event_callback(nullptr);
+}
+
+struct Stage {
+  const char *name;
+  Mark from;
+  Mark to;
+};
+
+// Span of a stage; a stage that did not happen ends where it started. The
+// cleaning stage runs from the cleaning check to the init sequence, so the
+// sensor info stage ends at whichever of the two comes first.
+static bool stage_span(const BootTimes &times, const Stage &stage, uint64_t &us, double &wall_ms) {
+  Mark from = stage.from;
+  Mark to = stage.to;
+  if (to == MARK_CLEANING && !times.seen[MARK_CLEANING])
+    to = MARK_INIT_SEQUENCE;
+  if (from == MARK_CLEANING && !times.seen[MARK_CLEANING])
+    from = MARK_INIT_SEQUENCE;
+  if (!times.seen[from] || !times.seen[to])
+    return false;
+  us = times.virtual_us[to] - times.virtual_us[from];
+  wall_ms = std::chrono::duration<double, std::milli>(times.wall[to] - times.wall[from]).count();
+  return true;
+}
+
+static void print_cell(const BootTimes &times, const Stage &stage) {
+  uint64_t us;
+  double wall_ms;
+  if (stage_span(times, stage, us, wall_ms)) {
+    printf(" %10.3f %9.3f", us / 1e6, wall_ms);
+  } else {
+    printf(" %10s %9s", "-", "-");
+  }
+}
+
+int run_boot_benchmark(const BootBenchmarkOptions &options) {
+  static const Stage STAGES[] = {
+      {"HAL init", MARK_BOOT, MARK_SETUP},
+      {"zmod4xxx_init", MARK_SETUP, MARK_PROBE},
+      {"sensor info", MARK_PROBE, MARK_CLEANING},
+      {"cleaning", MARK_CLEANING, MARK_INIT_SEQUENCE},
+      {"init sequence", MARK_INIT_SEQUENCE, MARK_MEASURING},
+      {"stabilization", MARK_MEASURING, MARK_VALID},
+      {"publish wait", MARK_VALID, MARK_PUBLISH},
+      {"total", MARK_BOOT, MARK_PUBLISH},
+  };
+  // Generous bound on a bring-up: cleaning, stabilization and a few updates.
+  const uint32_t limit_s = 3600;
+
+  ZMOD4510Simulator device;
+  ArduinoWireTiming arduino(&device);
+  esphome::i2c::I2CBus *bus = options.arduino_hal ? static_cast<esphome::i2c::I2CBus *>(&arduino) : &device;
+
+  BootTimes cold, warm;
+  boot(bus, device, options, cold, limit_s);
+  // Stay up for a while, then restart the MCU; the sensor keeps power.
+  virtual_clock().advance_ms(uint64_t(options.uptime_s) * 1000);
+  boot(bus, device, options, warm, limit_s);
+
+  printf("time to first valid reading (%s HAL, %u s update interval)\n", options.arduino_hal ? "Arduino" : "ESPHome",
+         options.update_s);
+#ifndef USE_ZMOD4510_CLEANING
+  // Cleaning is what a warm reboot skips; without it both boots are the same.
+  printf("note: built without -DUSE_ZMOD4510_CLEANING, so cold and warm boots do not differ\n");
+#endif
+  printf("%-14s %10s %9s %10s %9s\n", "stage", "cold [s]", "wall [ms]", "warm [s]", "wall [ms]");
+  for (const Stage &stage : STAGES) {
+    printf("%-14s", stage.name);
+    print_cell(cold, stage);
+    print_cell(warm, stage);
+    printf("\n");
+  }
+  return cold.seen[MARK_PUBLISH] && warm.seen[MARK_PUBLISH] ? 0 : 1;
+}
+
+// ZMOD4510s of the scaling run answer from FIRST_ADDRESS upwards.
+static const uint8_t FIRST_ADDRESS = 0x10;
+static const uint32_t SCALING_BUS_HZ = 100000;
+
+// Cold boot of `sensors` ZMOD4510s on one bus. Returns the virtual time from
+// boot until every sensor has started its first measurement, 0 if one did not
+// within `limit_s`.
+static uint64_t bring_up(uint8_t sensors, const BootBenchmarkOptions &options, uint32_t limit_s, double &wall_ms) {
+  virtual_clock().reboot();
+  esphome::App.reset();
+  esphome::App.set_loop_interval(options.loop_ms);
+  WallClock::time_point wall_start = WallClock::now();
+  uint64_t boot_us = virtual_clock().now_us();
+
+  SimulatedBus bus;
+  bus.set_frequency(SCALING_BUS_HZ);
+  ArduinoWireTiming arduino(&bus);
+  esphome::i2c::I2CBus *driver_bus = options.arduino_hal ? static_cast<esphome::i2c::I2CBus *>(&arduino) : &bus;
+  std::vector<std::unique_ptr<ZMOD4510Simulator>> devices;
+  std::vector<std::unique_ptr<ZMOD4510>> components;
+  std::vector<bool> measuring(sensors, false);
+  uint8_t started = 0;
+  // Fixed ambient sources keep the components from probing for HS sensors.
+  esphome::sensor::Sensor temperature("temperature"), humidity("humidity");
+  for (uint8_t i = 0; i < sensors; i++) {
+    devices.emplace_back(new ZMOD4510Simulator(FIRST_ADDRESS + i));
+    bus.add_device(FIRST_ADDRESS + i, devices.back().get());
+    devices.back()->set_event_callback([&measuring, &started, i](ZMOD4510Simulator::Event event) {
+      if (event == ZMOD4510Simulator::EVENT_MEASUREMENT && !measuring[i]) {
+        measuring[i] = true;
+        started++;
+      }
+    });
+    components.emplace_back(new ZMOD4510());
+    components.back()->set_i2c_bus(driver_bus);
+    components.back()->set_i2c_address(FIRST_ADDRESS + i);
+    components.back()->set_temperature_source(&temperature);
+    components.back()->set_humidity_source(&humidity);
+    esphome::App.register_component(components.back().get());
+  }
+
+  if (options.arduino_hal)
+    esphome::delay(ARDUINO_HAL_INIT_MS);
+  esphome::App.setup();
+  uint64_t limit_ms = uint64_t(limit_s) * 1000;
+  while (started < sensors && virtual_clock().uptime_us() / 1000 < limit_ms)
+    esphome::App.loop();
+  uint64_t elapsed_us = virtual_clock().now_us() - boot_us;
+  wall_ms = std::chrono::duration<double, std::milli>(WallClock::now() - wall_start).count();
+  esphome::App.shutdown();
+  esphome::App.reset();
+  return started == sensors ? elapsed_us : 0;
+}
+
+int run_bring_up_scaling(const BootBenchmarkOptions &options, uint8_t max_sensors) {
+  const uint32_t limit_s = 600;
+  printf("bring-up of N sensors on one %u kHz bus (%s HAL): boot to every first measurement\n",
+         SCALING_BUS_HZ / 1000, options.arduino_hal ? "Arduino" : "ESPHome");
+  printf("%7s %12s %14s %10s %9s\n", "sensors", "total [ms]", "per sensor", "vs. one", "wall [ms]");
+  uint64_t one_us = 0;
+  bool ok = true;
+  // Keep the table readable; -v brings the component log back.
+  int log_level = esphome::log_level;
+  esphome::log_level = log_level - ESPHOME_LOG_LEVEL_INFO;
+  uint32_t sensors = 1;
+  for (;;) {
+    double wall_ms;
+    uint64_t us = bring_up(uint8_t(sensors), options, limit_s, wall_ms);
+    if (us == 0) {
+      printf("%7u %12s\n", sensors, "failed");
+      ok = false;
+    } else {
+      if (sensors == 1)
+        one_us = us;
+      printf("%7u %12.1f %14.1f %9.2fx %9.2f\n", sensors, us / 1e3, us / 1e3 / sensors, double(us) / one_us,
+             wall_ms);
+    }
+    if (sensors >= max_sensors)
+      break;
+    sensors = std::min<uint32_t>(sensors * 2, max_sensors);
+  }
+  esphome::log_level = log_level;
+  return ok ? 0 : 1;
+}
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zmod4510 {
+namespace sim {
+
+struct BootBenchmarkOptions {
+  uint32_t loop_ms{16};
+  uint32_t update_s{60};
+  // Time the node stays up between the cold boot and the warm reboot.
+  uint32_t uptime_s{600};
+  // Model the library's Arduino HAL instead of the ESPHome one: HAL_Init()
+  // waits 2500 ms and every register read waits 10 ms after the address.
+  bool arduino_hal{false};
+};
+
+// Time from boot to the first valid (non-stabilization) publish, broken down
+// by bring-up stage, for a cold boot (fresh sensor) and a warm reboot (MCU
+// restart with the sensor powered and already cleaned). Prints a table and
+// returns 0 if both boots produced a valid publish. The boots only differ in
+// a build with -DUSE_ZMOD4510_CLEANING; otherwise the table says so.
+int run_boot_benchmark(const BootBenchmarkOptions &options);
+
+// Cold boot of 1, 2, 4, ... up to `max_sensors` ZMOD4510s on one bus: time
+// until every sensor has started measuring, against the time for one sensor.
+// Returns 0 if every sensor came up.
+int run_bring_up_scaling(const BootBenchmarkOptions &options, uint8_t max_sensors);
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,203 @@
+#include "bus_cost.h"
+
+#include <cstdio>
+#include <functional>
+
+#include "bus_counter.h"
+#include "esphome/core/application.h"
+#include "esphome_hal.h"
+#include "hs_simulator.h"
+#include "simulated_bus.h"
+#include "virtual_clock.h"
+#include "zmod4510_component.h"
+#include "zmod4510_simulator.h"
+
+extern "C" {
+#include "hsxxxx.h"
+#include "hs3xxx.h"
+#include "hs4xxx.h"
+#include "zmod4xxx.h"
+#include "zmod4xxx_hal.h"
+#include "zmod4510_config_no2_o3.h"
+}
+
+namespace zmod4510 {
+namespace sim {
+
+// Upper bounds per sequence. The counts are deterministic, so the budgets are
+// the current figures: any extra transaction or byte is flagged and either
+// fixed or accepted by raising the budget here.
+struct Budget {
+  const char *name;
+  uint32_t transactions;
+  uint32_t bytes;
+};
+
+static const Budget BUDGETS[] = {
+    {"boot", 30, 223},
+    {"NO2/O3 cycle", 4, 46},
+    {"HS probe", 2, 2},
+    {"HS3xxx read", 2, 6},
+    {"HS4xxx read", 2, 8},
+};
+
+static const uint32_t CLOCKS_HZ[] = {100000, 400000};
+// Bring-up normally ends within 3 s of boot.
+static const uint64_t BOOT_LIMIT_US = 30000000;
+
+// The component with its bring-up in view.
+class BootingZMOD4510 : public ZMOD4510 {
+ public:
+  bool is_brought_up() const { return this->bring_up_ == BRING_UP_DONE; }
+};
+
+// ZMOD4510::setup() and the rest of the bring-up that loop() polls, up to the
+// first measurement, counted on the component's own bus. Sleeps are the
+// delay() calls in between.
+static bool count_boot(BusCounts &counts) {
+  ZMOD4510Simulator zmod;
+  SimulatedBus bus;
+  bus.add_device(ZMOD4510Simulator::ADDRESS, &zmod);
+  CountingBus counter(&bus, ZMOD4510Simulator::ADDRESS);
+  virtual_clock().reboot();
+  esphome::App.reset();
+  BootingZMOD4510 component;
+  component.set_i2c_bus(&counter);
+  component.set_i2c_address(ZMOD4510Simulator::ADDRESS);
+  esphome::App.register_component(&component);
+
+  uint64_t delayed_us = virtual_clock().get_delayed_us();
+  esphome::App.setup();
+  while (!component.is_brought_up() && !component.is_failed() && virtual_clock().uptime_us() < BOOT_LIMIT_US)
+    esphome::App.loop();
+  bool ok = component.is_brought_up();
+  esphome::App.shutdown();
+  esphome::App.reset();
+  counts = counter.get_counts();
+  counts.sleep_ms = uint32_t((virtual_clock().get_delayed_us() - delayed_us) / 1000);
+  return ok;
+}
+
+static bool report(const Budget &budget, const BusCounts &counts) {
+  bool ok = counts.transactions <= budget.transactions && counts.bytes <= budget.bytes && counts.errors == 0;
+  printf("%-13s %6u/%-4u %6u/%-4u %10.1f %10.1f %9u  %s\n", budget.name, counts.transactions, budget.transactions,
+         counts.bytes, budget.bytes, counts.bus_time_us(CLOCKS_HZ[0]), counts.bus_time_us(CLOCKS_HZ[1]),
+         counts.sleep_ms, ok ? "ok" : counts.errors ? "ERRORS" : "OVER BUDGET");
+  return ok;
+}
+
+int run_bus_cost_benchmark() {
+  ZMOD4510Simulator zmod;
+  HSxxxxSimulator hs3xxx(HSxxxxSimulator::HS3XXX_ADDRESS);
+  HSxxxxSimulator hs4xxx(HSxxxxSimulator::HS4XXX_ADDRESS);
+  // The usual board: a ZMOD4510 next to an HS3xxx. The HS4xxx sits alone.
+  SimulatedBus bus;
+  bus.add_device(ZMOD4510Simulator::ADDRESS, &zmod);
+  bus.add_device(HSxxxxSimulator::HS3XXX_ADDRESS, &hs3xxx);
+  SimulatedBus hs4xxx_bus;
+  hs4xxx_bus.add_device(HSxxxxSimulator::HS4XXX_ADDRESS, &hs4xxx);
+
+  Interface_t bus_hal, hal, hs4xxx_bus_hal, hs4xxx_hal;
+  esphome_hal_init(&bus_hal, &bus);
+  esphome_hal_init(&hs4xxx_bus_hal, &hs4xxx_bus);
+  BusCounter counter, hs4xxx_counter;
+  hs4xxx_counter.wrap(&hs4xxx_bus_hal, &hs4xxx_hal);
+  counter.wrap(&bus_hal, &hal);
+
+  uint8_t prod_data[ZMOD4510_PROD_DATA_LEN];
+  zmod4xxx_dev_t dev = {};
+  dev.i2c_addr = ZMOD4510Simulator::ADDRESS;
+  dev.pid = ZMOD4510_PID;
+  dev.prod_data = prod_data;
+  dev.init_conf = &zmod_no2_o3_sensor_cfg[INIT];
+  dev.meas_conf = &zmod_no2_o3_sensor_cfg[MEASUREMENT];
+
+  BusCounts boot;
+  if (!count_boot(boot)) {
+    printf("component bring-up failed\n");
+    return 1;
+  }
+  printf("%-13s %11s %11s %10s %10s %9s\n", "sequence", "transact.", "bytes", "100k [us]", "400k [us]", "sleep[ms]");
+  bool ok = true;
+  ok &= report(BUDGETS[0], boot);
+
+  // The blocking driver bring-up, uncounted, for the sequences below.
+  int ret = zmod4xxx_init(&dev, &hal);
+  if (ret == ZMOD4XXX_OK)
+    ret = zmod4xxx_read_sensor_info(&dev);
+  if (ret == ZMOD4XXX_OK)
+    ret = zmod4xxx_init_sensor(&dev);
+  if (ret == ZMOD4XXX_OK)
+    ret = zmod4xxx_init_measurement(&dev);
+  if (ret == ZMOD4XXX_OK)
+    ret = zmod4xxx_prepare_sensor(&dev);
+  if (ret != ZMOD4XXX_OK) {
+    printf("bring-up failed with code %d\n", ret);
+    return 1;
+  }
+
+  // One cycle on the regular path of ZMOD4510::read_adc_result_(): the
+  // sequencer is done by the next deadline, so there is no early error check.
+  counter.reset();
+  uint8_t adc_result[ZMOD4510_ADC_DATA_LEN];
+  uint8_t status;
+  ret = zmod4xxx_start_measurement(&dev);
+  virtual_clock().advance_ms(ZMOD4510_NO2_O3_SAMPLE_TIME);
+  if (ret == ZMOD4XXX_OK)
+    ret = zmod4xxx_read_status(&dev, &status);
+  if (ret == ZMOD4XXX_OK)
+    ret = zmod4xxx_read_adc_result(&dev, adc_result);
+  if (ret == ZMOD4XXX_OK)
+    ret = zmod4xxx_check_error_event(&dev);
+  if (ret != ZMOD4XXX_OK || (status & STATUS_SEQUENCER_RUNNING_MASK)) {
+    printf("measurement cycle failed with code %d, status 0x%02X\n", ret, status);
+    return 1;
+  }
+  ok &= report(BUDGETS[1], counter.get_counts());
+
+  // HSxxxx_Init() next to an HS3xxx: the HS4xxx address is probed first, and
+  // its NACK is part of the cost, not an error.
+  counter.reset();
+  HSxxxx_t hs;
+  ret = HSxxxx_Init(&hs, &hal);
+  BusCounts probe = counter.get_counts();
+  probe.errors = 0;
+  if (ret != 0 || hs.i2cAddress != HSxxxxSimulator::HS3XXX_ADDRESS) {
+    printf("HS probe failed with code %d\n", ret);
+    return 1;
+  }
+  ok &= report(BUDGETS[2], probe);
+
+  HSxxxx_Results_t results;
+  counter.reset();
+  ret = HSxxxx_MeasureStart(&hs);
+  virtual_clock().advance_ms(HSxxxx_MeasurementDuration(&hs));
+  if (ret == 0)
+    ret = HSxxxx_MeasureRead(&hs, &results);
+  if (ret != 0) {
+    printf("HS3xxx read failed with code %d\n", ret);
+    return 1;
+  }
+  ok &= report(BUDGETS[3], counter.get_counts());
+
+  HSxxxx_t hs4;
+  if (HS4xxx_Init(&hs4, &hs4xxx_hal) != 0) {
+    printf("HS4xxx probe failed\n");
+    return 1;
+  }
+  hs4xxx_counter.reset();
+  ret = HSxxxx_MeasureStart(&hs4);
+  virtual_clock().advance_ms(HSxxxx_MeasurementDuration(&hs4));
+  if (ret == 0)
+    ret = HSxxxx_MeasureRead(&hs4, &results);
+  if (ret != 0) {
+    printf("HS4xxx read failed with code %d\n", ret);
+    return 1;
+  }
+  ok &= report(BUDGETS[4], hs4xxx_counter.get_counts());
+
+  return ok ? 0 : 1;
+}
+
+}  // namespace sim
+}  // namespace zmod4510
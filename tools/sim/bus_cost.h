@@ -0,0 +1,15 @@
+#pragma once
+
+namespace zmod4510 {
+namespace sim {
+
+// I2C transactions, bytes on the wire and bus time at 100 and 400 kHz of the
+// driver sequences the component runs: its bring-up through setup() and the
+// loop() polls, one NO2/O3 measurement cycle, the HS probe and one
+// HS3xxx/HS4xxx reading. The sleep column of the bring-up includes delay().
+// Each is compared with a budget; returns 0 if all are within budget, so it
+// can gate a release.
+int run_bus_cost_benchmark();
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,84 @@
+#include "bus_counter.h"
+
+namespace zmod4510 {
+namespace sim {
+
+BusCounter *BusCounter::active_ = nullptr;
+
+void BusCounter::wrap(Interface_t *inner, Interface_t *wrapped) {
+  this->inner_ = inner;
+  active_ = this;
+  wrapped->handle = this;
+  wrapped->i2cRead = inner->i2cRead ? i2c_read_ : nullptr;
+  wrapped->i2cWrite = inner->i2cWrite ? i2c_write_ : nullptr;
+  wrapped->msSleep = inner->msSleep ? ms_sleep_ : nullptr;
+  wrapped->reset = inner->reset ? reset_ : nullptr;
+  wrapped->lastError = HALErrorInfo_t{};
+}
+
+void BusCounter::count_(int segments, int data_bytes, int ret) {
+  uint32_t bytes = segments + data_bytes;
+  this->counts_.transactions++;
+  this->counts_.bytes += bytes;
+  // START or repeated START per segment, 8 bits and ACK per byte, STOP.
+  this->counts_.bits += segments + 9 * bytes + 1;
+  if (ret != 0)
+    this->counts_.errors++;
+}
+
+int BusCounter::i2c_read_(void *handle, uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data,
+                          int rd_size) {
+  auto *self = static_cast<BusCounter *>(handle);
+  int ret = HAL_I2CRead(self->inner_, sl_addr, wr_data, wr_size, rd_data, rd_size);
+  self->count_(wr_size ? 2 : 1, wr_size + rd_size, ret);
+  return ret;
+}
+
+int BusCounter::i2c_write_(void *handle, uint8_t sl_addr, uint8_t *wr_data1, int wr_size1, uint8_t *wr_data2,
+                           int wr_size2) {
+  auto *self = static_cast<BusCounter *>(handle);
+  int ret = HAL_I2CWrite(self->inner_, sl_addr, wr_data1, wr_size1, wr_data2, wr_size2);
+  self->count_(1, wr_size1 + wr_size2, ret);
+  return ret;
+}
+
+void BusCounter::ms_sleep_(uint32_t ms) {
+  active_->counts_.sleep_ms += ms;
+  active_->inner_->msSleep(ms);
+}
+
+int BusCounter::reset_(void *handle) {
+  auto *self = static_cast<BusCounter *>(handle);
+  return self->inner_->reset(self->inner_->handle);
+}
+
+esphome::i2c::ErrorCode CountingBus::read(uint8_t address, uint8_t *buffer, size_t len) {
+  esphome::i2c::ErrorCode err = this->bus_->read(address, buffer, len);
+  if (address == this->address_)
+    this->count_(len, true, err);
+  return err;
+}
+
+esphome::i2c::ErrorCode CountingBus::write(uint8_t address, const uint8_t *buffer, size_t len, bool stop) {
+  esphome::i2c::ErrorCode err = this->bus_->write(address, buffer, len, stop);
+  if (address == this->address_)
+    this->count_(len, stop, err);
+  return err;
+}
+
+void CountingBus::count_(size_t len, bool stop, esphome::i2c::ErrorCode err) {
+  uint32_t bytes = 1 + uint32_t(len);
+  this->counts_.bytes += bytes;
+  // START or repeated START, 8 bits and ACK per byte.
+  this->counts_.bits += 1 + 9 * bytes;
+  if (err != esphome::i2c::ERROR_OK)
+    this->counts_.errors++;
+  // STOP, which also ends a transaction cut short by an error.
+  if (stop || err != esphome::i2c::ERROR_OK) {
+    this->counts_.transactions++;
+    this->counts_.bits++;
+  }
+}
+
+}  // namespace sim
+}  // namespace zmod4510
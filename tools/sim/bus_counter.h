@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esphome/components/i2c/i2c.h"
+
+extern "C" {
+#include "hal.h"
+}
+
+namespace zmod4510 {
+namespace sim {
+
+// Wire-level I2C traffic of everything routed through an Interface_t.
+struct BusCounts {
+  uint32_t transactions{0};  // START to STOP
+  uint32_t bytes{0};         // address and data bytes on the wire
+  uint32_t bits{0};          // SCL cycles: 9 per byte plus START, repeated START and STOP
+  uint32_t errors{0};
+  uint32_t sleep_ms{0};      // requested through msSleep
+
+  // Bus time at an SCL frequency of `hz`.
+  double bus_time_us(uint32_t hz) const { return this->bits * 1e6 / hz; }
+};
+
+// Counting Interface_t decorator. Each call is one transaction: a register
+// read is a write of the register address, a repeated START and the read;
+// the data of a write call goes out in one frame.
+//
+// Interface_t::msSleep carries no handle, so sleeps are attributed to the
+// most recently wrapped counter.
+class BusCounter {
+ public:
+  // Route `wrapped` through `inner`.
+  void wrap(Interface_t *inner, Interface_t *wrapped);
+  void reset() { this->counts_ = BusCounts{}; }
+  const BusCounts &get_counts() const { return this->counts_; }
+
+ protected:
+  static int i2c_read_(void *handle, uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data, int rd_size);
+  static int i2c_write_(void *handle, uint8_t sl_addr, uint8_t *wr_data1, int wr_size1, uint8_t *wr_data2,
+                        int wr_size2);
+  static void ms_sleep_(uint32_t ms);
+  static int reset_(void *handle);
+
+  // Count one transaction made of `segments` address phases carrying `data_bytes`.
+  void count_(int segments, int data_bytes, int ret);
+
+  static BusCounter *active_;
+
+  Interface_t *inner_{nullptr};
+  BusCounts counts_;
+};
+
+// The same counts one level down, on the ESPHome I2C bus a component is
+// given, for code whose Interface_t is out of reach. Only traffic to
+// `address` is counted. A write without STOP and the read after it make one
+// transaction; a failed phase ends it. Sleeps are not seen here.
+class CountingBus : public esphome::i2c::I2CBus {
+ public:
+  CountingBus(esphome::i2c::I2CBus *bus, uint8_t address) : bus_(bus), address_(address) {}
+
+  esphome::i2c::ErrorCode read(uint8_t address, uint8_t *buffer, size_t len) override;
+  esphome::i2c::ErrorCode write(uint8_t address, const uint8_t *buffer, size_t len, bool stop = true) override;
+
+  void reset() { this->counts_ = BusCounts{}; }
+  const BusCounts &get_counts() const { return this->counts_; }
+
+ protected:
+  // Count one address phase of `len` data bytes.
+  void count_(size_t len, bool stop, esphome::i2c::ErrorCode err);
+
+  esphome::i2c::I2CBus *bus_;
+  uint8_t address_;
+  BusCounts counts_;
+};
+
+}  // namespace sim
+}  // namespace zmod4510
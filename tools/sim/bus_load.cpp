@@ -0,0 +1,244 @@
+#include "bus_load.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include "esphome_hal.h"
+#include "hs_simulator.h"
+#include "simulated_bus.h"
+#include "virtual_clock.h"
+#include "zmod4510_component.h"
+#include "zmod4510_simulator.h"
+
+extern "C" {
+#include "hs3xxx.h"
+#include "hs4xxx.h"
+}
+
+namespace zmod4510 {
+namespace sim {
+
+#ifdef USE_ZMOD4510_BUS_SCHEDULER
+
+// ZMOD4510s answer from FIRST_ADDRESS upwards, clear of the HS addresses.
+static const uint8_t FIRST_ADDRESS = 0x10;
+static const uint32_t PERIOD_MS = ZMOD4510_NO2_O3_SAMPLE_TIME;
+
+// Start commands of one device, plus how long each waited for the bus within
+// the loop pass that served it.
+struct Cadence {
+  std::vector<uint64_t> starts_us;
+  std::vector<uint32_t> delays_us;
+};
+
+// Runs first in every loop pass and notes when it began.
+class LoopMarker : public esphome::Component {
+ public:
+  void loop() override { this->pass_us = virtual_clock().now_us(); }
+  float get_setup_priority() const override { return esphome::setup_priority::BUS; }
+
+  uint64_t pass_us{0};
+};
+
+// An HS3xxx or HS4xxx sampled once per period: each cycle reads the previous
+// conversion and starts the next one, like the ZMOD4510 cycle.
+class AmbientDevice : public esphome::Component {
+ public:
+  AmbientDevice(Interface_t *hal, int (*init)(HSxxxx_t *, Interface_t *), BusScheduler *bus_scheduler,
+                const LoopMarker *marker, Cadence *cadence)
+      : hal_(hal), init_(init), bus_scheduler_(bus_scheduler), marker_(marker), cadence_(cadence) {}
+
+  void setup() override {
+    if (this->init_(&this->sensor_, this->hal_) != 0) {
+      this->mark_failed();
+      return;
+    }
+    if (this->bus_scheduler_ != nullptr &&
+        !this->bus_scheduler_->add_device(&this->scheduler_, [this]() { this->cycle_(); })) {
+      this->bus_scheduler_ = nullptr;
+    }
+    if (this->bus_scheduler_ == nullptr) {
+      this->scheduler_.start(esphome::millis());
+    }
+  }
+  void loop() override {
+    if (this->bus_scheduler_ != nullptr) {
+      this->bus_scheduler_->poll();
+    } else if (this->scheduler_.poll(esphome::millis())) {
+      this->cycle_();
+    }
+  }
+
+ protected:
+  void cycle_() {
+    if (this->converting_) {
+      HSxxxx_Results_t results;
+      HSxxxx_MeasureRead(&this->sensor_, &results);
+    }
+    this->converting_ = HSxxxx_MeasureStart(&this->sensor_) == 0;
+    uint64_t now = virtual_clock().now_us();
+    this->cadence_->starts_us.push_back(now);
+    this->cadence_->delays_us.push_back(uint32_t(now - this->marker_->pass_us));
+  }
+
+  Interface_t *hal_;
+  int (*init_)(HSxxxx_t *, Interface_t *);
+  BusScheduler *bus_scheduler_;
+  const LoopMarker *marker_;
+  Cadence *cadence_;
+  HSxxxx_t sensor_;
+  SampleScheduler scheduler_{PERIOD_MS};
+  bool converting_{false};
+};
+
+struct RunResult {
+  uint32_t cycles{0};
+  uint32_t missed{0};
+  uint32_t conflicts{0};  // ADC results read while the sequencer was running
+  std::vector<uint32_t> jitter_us;  // |interval - period| per cycle
+  std::vector<uint32_t> delays_us;
+  double utilization{0};
+};
+
+static uint32_t percentile(std::vector<uint32_t> &values, uint32_t percent) {
+  if (values.empty())
+    return 0;
+  std::sort(values.begin(), values.end());
+  return values[(values.size() - 1) * percent / 100];
+}
+
+static RunResult run(const BusLoadOptions &options, bool shared) {
+  virtual_clock().reboot();
+  esphome::App.reset();
+  esphome::App.set_loop_interval(options.loop_ms);
+
+  uint8_t zmods = options.devices - 2;
+  SimulatedBus bus;
+  bus.set_frequency(options.hz);
+  std::vector<std::unique_ptr<ZMOD4510Simulator>> simulators;
+  for (uint8_t i = 0; i < zmods; i++) {
+    simulators.emplace_back(new ZMOD4510Simulator(FIRST_ADDRESS + i));
+    bus.add_device(FIRST_ADDRESS + i, simulators.back().get());
+  }
+  HSxxxxSimulator hs3xxx(HSxxxxSimulator::HS3XXX_ADDRESS);
+  HSxxxxSimulator hs4xxx(HSxxxxSimulator::HS4XXX_ADDRESS);
+  bus.add_device(HSxxxxSimulator::HS3XXX_ADDRESS, &hs3xxx);
+  bus.add_device(HSxxxxSimulator::HS4XXX_ADDRESS, &hs4xxx);
+  Interface_t hal;
+  esphome_hal_init(&hal, &bus);
+
+  BusScheduler bus_scheduler(PERIOD_MS, esphome::millis);
+  BusScheduler *scheduler = shared ? &bus_scheduler : nullptr;
+  LoopMarker marker;
+  esphome::App.register_component(&marker);
+  std::vector<Cadence> cadences(options.devices);
+
+  // Only the ambient devices own the HS sensors; with fixed sources the
+  // components do not probe for them.
+  esphome::sensor::Sensor temperature("temperature"), humidity("humidity");
+  temperature.publish_state(22.0f);
+  humidity.publish_state(45.0f);
+  std::vector<std::unique_ptr<ZMOD4510>> components;
+  for (uint8_t i = 0; i < zmods; i++) {
+    Cadence *cadence = &cadences[i];
+    simulators[i]->set_event_callback([cadence, &marker](ZMOD4510Simulator::Event event) {
+      if (event != ZMOD4510Simulator::EVENT_MEASUREMENT)
+        return;
+      uint64_t now = virtual_clock().now_us();
+      cadence->starts_us.push_back(now);
+      cadence->delays_us.push_back(uint32_t(now - marker.pass_us));
+    });
+    components.emplace_back(new ZMOD4510());
+    ZMOD4510 *component = components.back().get();
+    component->set_i2c_bus(&bus);
+    component->set_i2c_address(FIRST_ADDRESS + i);
+    component->set_temperature_source(&temperature);
+    component->set_humidity_source(&humidity);
+    component->set_source_timeout(UINT32_MAX);
+    component->set_bus_scheduler(scheduler);
+    esphome::App.register_component(component);
+  }
+  AmbientDevice hs3xxx_device(&hal, HS3xxx_Init, scheduler, &marker, &cadences[zmods]);
+  AmbientDevice hs4xxx_device(&hal, HS4xxx_Init, scheduler, &marker, &cadences[zmods + 1]);
+  esphome::App.register_component(&hs3xxx_device);
+  esphome::App.register_component(&hs4xxx_device);
+
+  esphome::App.setup();
+  // Every device has started within a period of the end of setup; measure
+  // from the period after.
+  uint64_t window_us = virtual_clock().now_us() + 2 * uint64_t(PERIOD_MS) * 1000;
+  uint64_t end_ms = virtual_clock().uptime_us() / 1000 + uint64_t(options.minutes) * 60000;
+  uint64_t busy_us = 0;
+  while (virtual_clock().uptime_us() / 1000 < end_ms) {
+    if (busy_us == 0 && virtual_clock().now_us() >= window_us)
+      busy_us = bus.get_busy_us();
+    esphome::App.loop();
+  }
+  busy_us = bus.get_busy_us() - busy_us;
+  uint64_t elapsed_us = virtual_clock().now_us() - window_us;
+  esphome::App.shutdown();
+  esphome::App.reset();
+
+  RunResult result;
+  for (auto &simulator : simulators)
+    result.conflicts += simulator->get_access_conflicts();
+  for (Cadence &cadence : cadences) {
+    for (size_t i = 1; i < cadence.starts_us.size(); i++) {
+      if (cadence.starts_us[i - 1] < window_us)
+        continue;
+      int64_t interval = int64_t(cadence.starts_us[i] - cadence.starts_us[i - 1]);
+      int64_t deviation = interval - int64_t(PERIOD_MS) * 1000;
+      result.cycles++;
+      result.missed += uint32_t(deviation / (int64_t(PERIOD_MS) * 1000));
+      result.jitter_us.push_back(uint32_t(deviation < 0 ? -deviation : deviation));
+      result.delays_us.push_back(cadence.delays_us[i]);
+    }
+  }
+  result.utilization = 100.0 * busy_us / elapsed_us;
+  return result;
+}
+
+int run_bus_load_test(const BusLoadOptions &options) {
+  if (options.devices < 3 || options.devices > BusScheduler::MAX_DEVICES) {
+    printf("bus load test needs 3 to %u devices\n", BusScheduler::MAX_DEVICES);
+    return 2;
+  }
+  printf("bus load: %u devices (%u ZMOD4510, HS3xxx, HS4xxx) at %u kHz, %u ms loop, %u min\n", options.devices,
+         options.devices - 2, options.hz / 1000, options.loop_ms, options.minutes);
+  printf("%-12s %7s %7s %9s %10s %10s %10s %10s %10s %9s\n", "schedule", "cycles", "missed", "conflicts", "jit p99", "jit max",
+         "delay p50", "delay p99", "delay max", "bus util");
+  bool ok = true;
+  // Keep the table readable; -v brings the component log back.
+  int log_level = esphome::log_level;
+  esphome::log_level = log_level - ESPHOME_LOG_LEVEL_INFO;
+  for (bool shared : {false, true}) {
+    RunResult result = run(options, shared);
+    printf("%-12s %7u %7u %9u %10u %10u %10u %10u %10u %8.2f%%\n", shared ? "shared" : "independent", result.cycles,
+           result.missed, result.conflicts, percentile(result.jitter_us, 99), percentile(result.jitter_us, 100),
+           percentile(result.delays_us, 50), percentile(result.delays_us, 99), percentile(result.delays_us, 100),
+           result.utilization);
+    if (shared)
+      ok = result.missed == 0 && result.conflicts == 0 && result.cycles != 0;
+  }
+  esphome::log_level = log_level;
+  printf("(jitter: deviation of each interval from %u ms; delay: start command behind the loop pass; both us)\n",
+         PERIOD_MS);
+  return ok ? 0 : 1;
+}
+
+#else
+
+int run_bus_load_test(const BusLoadOptions &options) {
+  printf("the bus load test needs a build with -DUSE_ZMOD4510_BUS_SCHEDULER and bus_scheduler.cpp\n");
+  return 2;
+}
+
+#endif
+
+}  // namespace sim
+}  // namespace zmod4510
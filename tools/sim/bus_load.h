@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zmod4510 {
+namespace sim {
+
+struct BusLoadOptions {
+  // Devices on the bus: ZMOD4510s plus one HS3xxx and one HS4xxx.
+  uint8_t devices{16};
+  uint32_t minutes{60};
+  uint32_t loop_ms{16};
+  uint32_t hz{100000};
+};
+
+// Load test of many devices on one bus with transfers taking their wire time:
+// runs the ZMOD4510 components and the HS sensors once on independent
+// schedules and once on a shared BusScheduler, and prints the achieved
+// cadence jitter, the delay of start commands behind the loop pass that
+// served them, early ADC reads (access conflicts) and the bus utilization.
+// Returns 0 if the shared schedule neither missed a cycle nor read early.
+int run_bus_load_test(const BusLoadOptions &options);
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,42 @@
+// Stand-in for lib_zmod4xxx_cleaning on the host, used unless
+// SIM_HAVE_CLEANING is defined and a host build of the library is linked.
+// It keeps the timing of the real procedure: a check of the sensor's
+// cleaning state, then about a minute of sequencer run time once in the
+// sensor lifetime, and ERROR_CLEANING on every later call.
+
+#ifndef SIM_HAVE_CLEANING
+
+#include "zmod4510_simulator.h"
+
+extern "C" {
+#include "zmod4xxx.h"
+#include "zmod4xxx_cleaning.h"
+#include "zmod4510_config_no2_o3.h"
+}
+
+using zmod4510::sim::ZMOD4510Simulator;
+
+extern "C" int8_t zmod4xxx_cleaning_run(zmod4xxx_dev_t *dev) {
+  uint8_t state;
+  if (dev->read(dev->i2c_addr, ZMOD4510Simulator::ADDR_CLEANING_STATE, &state, 1))
+    return ERROR_I2C;
+  if (state != 0)
+    return ERROR_CLEANING;
+
+  uint8_t steps[ZMOD4510Simulator::CLEANING_STEPS_LEN] = {0x00, 0x00};
+  if (dev->write(dev->i2c_addr, ZMOD4XXX_S_ADDR, steps, sizeof(steps)))
+    return ERROR_I2C;
+  uint8_t start = 0x80;
+  if (dev->write(dev->i2c_addr, ZMOD4XXX_ADDR_CMD, &start, 1))
+    return ERROR_I2C;
+  int8_t ret = zmod4xxx_wait_sequencer(dev, ZMOD4510Simulator::CLEANING_SEQUENCE_MS,
+                                       ZMOD4510Simulator::CLEANING_SEQUENCE_MS + 10000);
+  if (ret)
+    return ret;
+  state = 1;
+  if (dev->write(dev->i2c_addr, ZMOD4510Simulator::ADDR_CLEANING_STATE, &state, 1))
+    return ERROR_I2C;
+  return ZMOD4XXX_OK;
+}
+
+#endif  // SIM_HAVE_CLEANING
@@ -0,0 +1,168 @@
+#include "clock_wrap_test.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "esphome/core/application.h"
+#include "virtual_clock.h"
+#include "zmod4510_component.h"
+#include "zmod4510_simulator.h"
+
+namespace zmod4510 {
+namespace sim {
+
+#if defined(USE_ZMOD4510_HISTORY) && defined(USE_ZMOD4510_JOURNAL)
+
+static const uint32_t PERIOD_S = ZMOD4510_NO2_O3_SAMPLE_TIME / 1000;
+static const uint64_t MILLIS_WRAP_MS = 1ULL << 32;
+// Holds both boots without dropping a segment.
+static const uint32_t JOURNAL_SIZE = 262144;
+
+struct Boot {
+  uint32_t measurements{0};
+  uint32_t entries{0};
+  // History entries that do not start after the one before them.
+  uint32_t unordered{0};
+  uint32_t first_timestamp{0};
+  uint32_t last_timestamp{0};
+};
+
+// Boot the node with the uptime `hours` / 2 short of the millis() wrap and
+// run it for `hours`; the journal in `path` carries over from the last boot.
+static Boot boot(ZMOD4510Simulator &device, const char *path, const ClockWrapOptions &options) {
+  Boot result;
+  uint64_t run_ms = uint64_t(options.hours * 3600 * 1000);
+  uint64_t start_ms = MILLIS_WRAP_MS - run_ms / 2;
+  virtual_clock().reboot(start_ms);
+  esphome::App.reset();
+  esphome::App.set_loop_interval(options.loop_ms);
+
+  ZMOD4510 component;
+  component.set_i2c_bus(&device);
+  component.set_i2c_address(ZMOD4510Simulator::ADDRESS);
+  component.set_journal_file(path, JOURNAL_SIZE);
+  // Keep every sample of both boots at every level.
+  uint32_t minutes = uint32_t(2 * options.hours * 60) + 2;
+  component.set_history_size(2 * run_ms + 60000, minutes, minutes / 60 + 2, 2);
+  esphome::App.register_component(&component);
+
+  uint32_t measurements = device.get_measurements();
+  esphome::App.setup();
+  esphome::App.run_until(start_ms + run_ms);
+  esphome::App.shutdown();
+  result.measurements = device.get_measurements() - measurements;
+
+  const SampleHistory &history = component.get_history();
+  for (uint8_t r = 0; r < SampleHistory::NUM_RESOLUTIONS; r++) {
+    bool first = true;
+    uint32_t last = 0;
+    history.for_each(SampleHistory::Resolution(r), 0, UINT32_MAX, [&](const HistoryBucket &bucket) {
+      if (!first && bucket.start <= last)
+        result.unordered++;
+      if (r == SampleHistory::RAW) {
+        if (first)
+          result.first_timestamp = bucket.start;
+        result.last_timestamp = bucket.start;
+      }
+      first = false;
+      last = bucket.start;
+      result.entries++;
+    });
+  }
+  esphome::App.reset();
+  return result;
+}
+
+struct JournalCheck {
+  bool mounted{false};
+  uint32_t records{0};
+  uint32_t unordered{0};
+  // Steps between records longer than two sample periods.
+  uint32_t gaps{0};
+  uint32_t max_gap_s{0};
+};
+
+static JournalCheck check_journal(const char *path) {
+  JournalCheck check;
+  FileStorage storage(path, JOURNAL_SIZE);
+  FlashJournal journal(&storage);
+  check.mounted = journal.mount();
+  if (!check.mounted)
+    return check;
+  uint32_t last = 0;
+  journal.for_each([&](const uint8_t *data, size_t len) {
+    const SeriesRecord *records = reinterpret_cast<const SeriesRecord *>(data);
+    for (size_t i = 0; i < len / sizeof(SeriesRecord); i++) {
+      uint32_t timestamp = records[i].timestamp;
+      if (check.records != 0) {
+        if (timestamp <= last) {
+          check.unordered++;
+        } else if (timestamp - last > 2 * PERIOD_S) {
+          check.gaps++;
+          check.max_gap_s = std::max(check.max_gap_s, timestamp - last);
+        }
+      }
+      last = timestamp;
+      check.records++;
+    }
+  });
+  return check;
+}
+
+int run_clock_wrap_test(const ClockWrapOptions &options) {
+  if (options.hours <= 0) {
+    printf("clock wrap test needs a positive run time\n");
+    return 2;
+  }
+  char path[] = "/tmp/zmod4510_wrap_XXXXXX";
+  int fd = mkstemp(path);
+  if (fd < 0) {
+    printf("cannot create a journal file in /tmp\n");
+    return 2;
+  }
+  close(fd);
+  unlink(path);
+
+  ZMOD4510Simulator device;
+  auto start = std::chrono::steady_clock::now();
+  Boot boots[2];
+  for (Boot &result : boots)
+    result = boot(device, path, options);
+  double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  JournalCheck journal = check_journal(path);
+  unlink(path);
+
+  printf("2 boots of %.1f h across the millis() wrap at %llu ms (%.2f s wall)\n", options.hours,
+         (unsigned long long) MILLIS_WRAP_MS, wall_s);
+  printf("%4s %8s %8s %9s %12s %12s\n", "boot", "measured", "history", "unordered", "first [s]", "last [s]");
+  bool ok = true;
+  for (uint8_t i = 0; i < 2; i++) {
+    const Boot &result = boots[i];
+    printf("%4u %8u %8u %9u %12u %12u\n", i + 1, result.measurements, result.entries, result.unordered,
+           result.first_timestamp, result.last_timestamp);
+    ok &= result.measurements != 0 && result.unordered == 0;
+  }
+  ok &= boots[1].first_timestamp == boots[0].first_timestamp && boots[1].last_timestamp > boots[0].last_timestamp;
+  printf("journal: %u records, %u unordered, %u gaps (longest %u s)\n", journal.records, journal.unordered,
+         journal.gaps, journal.max_gap_s);
+  printf("(history: entries of all levels after the boot, restored ones included; first, last: raw timestamps;\n"
+         " gaps: steps over two sample periods, one is the reboot)\n");
+  ok &= journal.mounted && journal.records != 0 && journal.unordered == 0 && journal.gaps <= 1;
+  return ok ? 0 : 1;
+}
+
+#else
+
+int run_clock_wrap_test(const ClockWrapOptions &options) {
+  printf("the clock wrap test needs a build with -DUSE_ZMOD4510_SAMPLE_RECORDS -DUSE_ZMOD4510_HISTORY\n"
+         "-DUSE_ZMOD4510_JOURNAL, sample_history.cpp and flash_journal.cpp\n");
+  return 2;
+}
+
+#endif
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zmod4510 {
+namespace sim {
+
+struct ClockWrapOptions {
+  // Length of each boot; it starts half of this short of the millis() wrap.
+  double hours{2};
+  uint32_t loop_ms{16};
+};
+
+// Runs the component with history and journal across the wrap of the 32-bit
+// millis() after 49.7 days of uptime: one boot from just short of the wrap
+// past it, then a reboot that restores the journal, again just short of the
+// wrap, as if the node had been up that long before the component was set
+// up. Checks that every history level and the journal stay ordered by time
+// and that the journal has no gaps but the one of the reboot. Returns 0 if
+// they do.
+int run_clock_wrap_test(const ClockWrapOptions &options);
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,183 @@
+#include "compression_bench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#include "../recording/recording_reader.h"
+#include "esphome/core/application.h"
+#include "virtual_clock.h"
+#include "zmod4510_component.h"
+#include "zmod4510_simulator.h"
+
+extern "C" {
+#include "no2_o3.h"
+}
+
+namespace zmod4510 {
+namespace sim {
+
+#ifdef USE_ZMOD4510_COMPRESSED_HISTORY
+
+using WallClock = std::chrono::steady_clock;
+
+// Settings of precision_bits to compare; 23 is lossless.
+static const uint8_t MANTISSA_BITS[] = {23, 16, 14, 12, 10, 8};
+static const char *const CHANNEL_NAMES[SeriesRecord::NUM_CHANNELS] = {"no2", "o3", "rmox0", "rmox1", "rmox2",
+                                                                      "rmox3"};
+
+// The component with its algorithm results in view.
+class ResultsZMOD4510 : public ZMOD4510 {
+ public:
+  static const size_t BLOCK_SIZE = COMPRESSED_BLOCK_SIZE;
+
+  bool get_record(uint32_t timestamp, SeriesRecord &record) const {
+    if (!this->results_valid_)
+      return false;
+    record = SeriesRecord{timestamp,
+                          {this->results_.NO2_conc_ppb, this->results_.O3_conc_ppb, this->results_.rmox[0],
+                           this->results_.rmox[1], this->results_.rmox[2], this->results_.rmox[3]}};
+    return true;
+  }
+};
+
+// Every valid result, read out when the next measurement starts.
+static std::vector<SeriesRecord> simulate_trace(double hours) {
+  std::vector<SeriesRecord> trace;
+  esphome::App.reset();
+  ZMOD4510Simulator device;
+  ResultsZMOD4510 component;
+  component.set_i2c_bus(&device);
+  component.set_i2c_address(ZMOD4510Simulator::ADDRESS);
+  esphome::App.register_component(&component);
+  device.set_event_callback([&](ZMOD4510Simulator::Event event) {
+    SeriesRecord record;
+    if (event == ZMOD4510Simulator::EVENT_MEASUREMENT &&
+        component.get_record(uint32_t(virtual_clock().uptime_us() / 1000000), record))
+      trace.push_back(record);
+  });
+  esphome::App.setup();
+  esphome::App.run_until(uint64_t(hours * 3600 * 1000));
+  esphome::App.shutdown();
+  device.set_event_callback(nullptr);
+  esphome::App.reset();
+  return trace;
+}
+
+static bool read_recording(const char *path, std::vector<SeriesRecord> &trace) {
+  using namespace recording;
+  Recording rec;
+  if (!rec.open(path)) {
+    printf("%s\n", rec.error().c_str());
+    return false;
+  }
+  for (size_t b = 0; b < rec.num_blocks(); b++) {
+    const Block &block = rec.block(b);
+    Column<uint32_t> timestamp = block.column<uint32_t>(COLUMN_TIMESTAMP_MS);
+    Column<float> no2 = block.column<float>(COLUMN_NO2);
+    Column<float> o3 = block.column<float>(COLUMN_O3);
+    Column<float> rmox = block.column<float>(COLUMN_RMOX);
+    Column<int8_t> status = block.column<int8_t>(COLUMN_ALGO_STATUS);
+    if (timestamp.empty() || no2.empty() || o3.empty() || rmox.empty() || rmox.count < 4) {
+      printf("%s: block %zu lacks the timestamp, no2, o3 or rmox column\n", path, b);
+      return false;
+    }
+    for (size_t r = 0; r < block.rows(); r++) {
+      if (!status.empty() && status(r) != NO2_O3_OK)
+        continue;
+      trace.push_back(
+          SeriesRecord{timestamp(r) / 1000, {no2(r), o3(r), rmox(r, 0), rmox(r, 1), rmox(r, 2), rmox(r, 3)}});
+    }
+  }
+  return true;
+}
+
+struct Result {
+  size_t bytes{0};
+  uint32_t decoded{0};
+  double encode_ns{0};
+  float max_error[SeriesRecord::NUM_CHANNELS]{};
+};
+
+static float relative_error(float value, float decoded) {
+  if (value == decoded)
+    return 0.0f;
+  return std::fabs(decoded - value) / std::max(std::fabs(value), 1e-6f);
+}
+
+static Result compress(const std::vector<SeriesRecord> &trace, uint8_t bits) {
+  Result result;
+  // Blocks as the component's, enough for the whole trace even if it does not
+  // compress at all.
+  size_t blocks = trace.size() / (ResultsZMOD4510::BLOCK_SIZE / 64) + 1;
+  CompressedHistory history;
+  history.init(ResultsZMOD4510::BLOCK_SIZE, blocks);
+  history.set_mantissa_bits(bits);
+  auto start = WallClock::now();
+  for (const SeriesRecord &record : trace)
+    history.add(record);
+  result.encode_ns = std::chrono::duration<double, std::nano>(WallClock::now() - start).count() / trace.size();
+  result.bytes = history.get_used_bytes();
+
+  history.for_each([&](const SeriesRecord &record) {
+    if (result.decoded < trace.size()) {
+      const SeriesRecord &original = trace[result.decoded];
+      for (uint8_t c = 0; c < SeriesRecord::NUM_CHANNELS; c++)
+        result.max_error[c] = std::max(result.max_error[c], relative_error(original.values[c], record.values[c]));
+    }
+    result.decoded++;
+  });
+  return result;
+}
+
+int run_compression_benchmark(const CompressionBenchOptions &options) {
+  std::vector<SeriesRecord> trace;
+  if (options.recordings.empty()) {
+    trace = simulate_trace(options.hours);
+    printf("compression: %zu records from %.1f h of the simulator\n", trace.size(), options.hours);
+  } else {
+    for (const char *path : options.recordings) {
+      if (!read_recording(path, trace))
+        return 2;
+    }
+    printf("compression: %zu records from %zu recordings\n", trace.size(), options.recordings.size());
+  }
+  if (trace.empty())
+    return 2;
+
+  size_t raw_bytes = trace.size() * sizeof(SeriesRecord);
+  printf("%5s %10s %8s %7s %10s", "bits", "bytes", "B/rec", "ratio", "ns/rec");
+  for (const char *name : CHANNEL_NAMES)
+    printf(" %9s", name);
+  printf("\n");
+  bool ok = true;
+  for (uint8_t bits : MANTISSA_BITS) {
+    Result result = compress(trace, bits);
+    printf("%5u %10zu %8.2f %6.2fx %10.1f", bits, result.bytes, double(result.bytes) / trace.size(),
+           double(raw_bytes) / result.bytes, result.encode_ns);
+    float max_error = 0.0f;
+    for (float error : result.max_error) {
+      printf(" %9.2e", error);
+      max_error = std::max(max_error, error);
+    }
+    printf("\n");
+    ok &= result.decoded == trace.size() && (bits != 23 || max_error == 0.0f);
+  }
+  printf("(ratio: against %zu byte records; per channel: largest relative error after decoding)\n",
+         sizeof(SeriesRecord));
+  return ok ? 0 : 1;
+}
+
+#else
+
+int run_compression_benchmark(const CompressionBenchOptions &options) {
+  printf("the compression benchmark needs a build with -DUSE_ZMOD4510_SAMPLE_RECORDS "
+         "-DUSE_ZMOD4510_COMPRESSED_HISTORY and compressed_series.cpp\n");
+  return 2;
+}
+
+#endif
+
+}  // namespace sim
+}  // namespace zmod4510
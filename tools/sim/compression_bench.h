@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace zmod4510 {
+namespace sim {
+
+struct CompressionBenchOptions {
+  // Length of the simulated trace, used when no recordings are given.
+  double hours{24};
+  // Recordings (see recording_format.h) to take the trace from instead; rows
+  // without a valid algorithm result are skipped.
+  std::vector<const char *> recordings;
+};
+
+// Compresses a trace of algorithm results (NO2, O3 and the four Rmox
+// channels, as the compressed history stores them) at several settings of
+// compressed_history's precision_bits and reports per setting the compression
+// ratio against the 28 byte records, the encoding speed and the largest
+// relative error after decoding. The trace is either the component running
+// against the simulator for `hours`, or the given recordings. Returns 0 if
+// every setting decoded every record and 23 bits decoded them exactly.
+int run_compression_benchmark(const CompressionBenchOptions &options);
+
+}  // namespace sim
+}  // namespace zmod4510
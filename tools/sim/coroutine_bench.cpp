@@ -0,0 +1,287 @@
+#include "coroutine_bench.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "coroutine.h"
+#include "hs_simulator.h"
+#include "simulated_async_bus.h"
+#include "simulated_bus.h"
+#include "virtual_clock.h"
+#include "zmod4510_simulator.h"
+#include "zmod4xxx_tasks.h"
+
+extern "C" {
+#include "hs3xxx.h"
+#include "zmod4510_config_no2_o3.h"
+#include "zmod4xxx_hal.h"
+}
+
+namespace zmod4510 {
+namespace sim {
+
+#if defined(USE_ZMOD4510_ASYNC_HAL) && defined(__cpp_impl_coroutine)
+
+using WallClock = std::chrono::steady_clock;
+
+static const uint8_t FIRST_ADDRESS = 0x10;
+static const uint32_t MEASUREMENT_MS = 4000;
+static const uint32_t MEASUREMENT_TIMEOUT_MS = 2 * MEASUREMENT_MS;
+
+static double ns_per(WallClock::time_point start, uint32_t count) {
+  return std::chrono::duration<double, std::nano>(WallClock::now() - start).count() / count;
+}
+
+// Parts of the layer on their own.
+
+static Task<int> leaf(int value) { co_return value + 1; }
+
+static Task<> call_leaves(uint32_t calls, int *sum) {
+  for (uint32_t i = 0; i < calls; i++)
+    *sum = co_await leaf(*sum);
+}
+
+static Task<> sleep_steps(Executor &executor, uint32_t steps, bool *done) {
+  for (uint32_t i = 0; i < steps; i++)
+    co_await executor.sleep(0);
+  *done = true;
+}
+
+struct CallbackChain {
+  AsyncInterface *hal;
+  uint32_t left;
+};
+
+static void callback_step(void *context, int result) {
+  auto *chain = static_cast<CallbackChain *>(context);
+  if (--chain->left != 0)
+    chain->hal->schedule(chain->hal->handle, 0, callback_step, chain);
+}
+
+// Wakeups of zero ms are due at once; the clock never has to move.
+static uint32_t still_clock() { return 0; }
+
+struct PartCosts {
+  double frame_ns;
+  double call_ns;
+  double resume_ns;
+  double callback_ns;
+};
+
+static PartCosts measure_parts(uint32_t iterations) {
+  PartCosts costs;
+  // The compiler cannot see through the Task, so every frame is allocated.
+  auto start = WallClock::now();
+  for (uint32_t i = 0; i < iterations; i++) {
+    Task<int> task = leaf(int(i));
+  }
+  costs.frame_ns = ns_per(start, iterations);
+
+  int sum = 0;
+  start = WallClock::now();
+  auto calls = call_leaves(iterations, &sum).release();
+  calls.resume();
+  calls.destroy();
+  costs.call_ns = ns_per(start, iterations);
+  if (sum != int(iterations))
+    costs.call_ns = -1;
+
+  Interface_t inner{};
+  AsyncAdapter adapter;
+  AsyncInterface hal;
+  adapter.wrap(&inner, &hal, still_clock);
+  Executor executor(&hal);
+  bool done = false;
+  start = WallClock::now();
+  executor.spawn(sleep_steps(executor, iterations, &done));
+  while (!done)
+    executor.poll();
+  costs.resume_ns = ns_per(start, iterations);
+
+  CallbackChain chain{&hal, iterations};
+  start = WallClock::now();
+  hal.schedule(hal.handle, 0, callback_step, &chain);
+  while (chain.left != 0)
+    hal.poll(hal.handle);
+  costs.callback_ns = ns_per(start, iterations);
+  return costs;
+}
+
+// The sequences side by side on one bus.
+
+struct FlowSensor {
+  explicit FlowSensor(uint8_t address) : device(address) {}
+
+  ZMOD4510Simulator device;
+  zmod4xxx_dev_t dev{};
+  uint8_t prod_data[ZMOD4510_PROD_DATA_LEN];
+  uint8_t adc_result[ZMOD4510_ADC_DATA_LEN];
+  uint32_t cycles{0};
+  uint32_t failures{0};
+};
+
+struct FlowStats {
+  uint32_t cycles{0};
+  uint32_t failures{0};
+  uint32_t frames{0};
+  uint32_t heap_allocations{0};
+  uint32_t resumes{0};
+  size_t largest_frame{0};
+};
+
+// Statistics start once every flow has finished its first cycle, so the
+// frames first allocated during bring-up and warm-up stay out of them.
+struct FlowState {
+  Executor *executor;
+  uint8_t warm{0};
+  uint8_t flows{0};
+  uint32_t resumes_start{0};
+};
+
+static void count_warm(FlowState &state) {
+  if (++state.warm == state.flows) {
+    FrameCache::reset_stats();
+    state.resumes_start = state.executor->get_resumes();
+  }
+}
+
+static Task<> sensor_flow(FlowState &state, FlowSensor &sensor, Interface_t *hal, uint32_t cycles) {
+  Executor &executor = *state.executor;
+  int ret = co_await sequence::bring_up(executor, &sensor.dev, hal);
+  if (ret == ZMOD4XXX_OK)
+    ret = co_await sequence::prepare(executor, &sensor.dev);
+  if (ret != ZMOD4XXX_OK) {
+    sensor.failures++;
+    count_warm(state);
+    co_return;
+  }
+  while (sensor.cycles < cycles) {
+    if (co_await sequence::measure(executor, &sensor.dev, sensor.adc_result, MEASUREMENT_MS,
+                                   MEASUREMENT_TIMEOUT_MS) != ZMOD4XXX_OK)
+      sensor.failures++;
+    if (++sensor.cycles == 1)
+      count_warm(state);
+  }
+}
+
+static Task<> ambient_flow(FlowState &state, HSxxxx_t *sensor, uint32_t cycles, uint32_t *failures) {
+  Executor &executor = *state.executor;
+  for (uint32_t cycle = 0; cycle < cycles; cycle++) {
+    HSxxxx_Results_t results;
+    if (co_await sequence::read_ambient(executor, sensor, &results) != 0)
+      (*failures)++;
+    if (cycle == 0)
+      count_warm(state);
+    co_await executor.sleep(MEASUREMENT_MS - HSxxxx_MeasurementDuration(sensor));
+  }
+}
+
+static FlowStats run_flows(const CoroutineBenchOptions &options) {
+  SimulatedBus bus;
+  std::vector<std::unique_ptr<FlowSensor>> sensors;
+  for (uint8_t i = 0; i < options.sensors; i++) {
+    sensors.emplace_back(new FlowSensor(FIRST_ADDRESS + i));
+    FlowSensor &sensor = *sensors.back();
+    sensor.device.set_measurement_ms(MEASUREMENT_MS);
+    bus.add_device(FIRST_ADDRESS + i, &sensor.device);
+    sensor.dev.pid = ZMOD4510_PID;
+    sensor.dev.prod_data = sensor.prod_data;
+    sensor.dev.init_conf = &zmod_no2_o3_sensor_cfg[INIT];
+    sensor.dev.meas_conf = &zmod_no2_o3_sensor_cfg[MEASUREMENT];
+    sensor.dev.i2c_addr = FIRST_ADDRESS + i;
+  }
+  HSxxxxSimulator hs3xxx(HSxxxxSimulator::HS3XXX_ADDRESS);
+  bus.add_device(HSxxxxSimulator::HS3XXX_ADDRESS, &hs3xxx);
+
+  // All traffic goes through the DMA-like controller: the awaited operations
+  // directly, the driver calls in between through the BlockingAdapter.
+  SimulatedAsyncBus async_bus(&bus, options.hz);
+  AsyncInterface async_hal;
+  async_bus.init(&async_hal);
+  BlockingAdapter blocking;
+  Interface_t hal;
+  blocking.wrap(&async_hal, &hal);
+
+  FlowStats stats;
+  uint32_t ambient_failures = 0;
+  HSxxxx_t ambient;
+  if (HS3xxx_Init(&ambient, &hal) != 0)
+    ambient_failures++;
+
+  FrameCache::reset_stats();
+  {
+    Executor executor(&async_hal);
+    FlowState state{&executor};
+    state.flows = options.sensors + 1;
+    for (auto &sensor : sensors)
+      executor.spawn(sensor_flow(state, *sensor, &hal, options.cycles));
+    executor.spawn(ambient_flow(state, &ambient, options.cycles, &ambient_failures));
+    while (executor.get_running() != 0) {
+      executor.poll();
+      uint64_t due_us = async_bus.get_next_due_us();
+      if (due_us == UINT64_MAX)
+        break;
+      virtual_clock().advance_to_us(due_us);
+    }
+    stats.resumes = executor.get_resumes() - state.resumes_start;
+    stats.failures += executor.get_running();
+  }
+  stats.frames = FrameCache::get_heap_allocations() + FrameCache::get_reuses();
+  stats.heap_allocations = FrameCache::get_heap_allocations();
+  stats.largest_frame = FrameCache::get_largest_frame();
+  stats.failures += ambient_failures;
+  for (auto &sensor : sensors) {
+    stats.cycles += sensor->cycles;
+    stats.failures += sensor->failures;
+    zmod4xxx_deinit(&sensor->dev);
+  }
+  FrameCache::clear();
+  return stats;
+}
+
+int run_coroutine_benchmark(const CoroutineBenchOptions &options) {
+  if (options.sensors == 0 || options.sensors >= Executor::MAX_TASKS) {
+    printf("coroutine benchmark needs 1 to %u sensors\n", Executor::MAX_TASKS - 1);
+    return 2;
+  }
+  printf("coroutines: %u iterations per part\n", options.iterations);
+  printf("%-12s %10s %10s %12s %12s\n", "frames", "frame [ns]", "call [ns]", "resume [ns]", "callback [ns]");
+  for (bool cached : {true, false}) {
+    FrameCache::set_enabled(cached);
+    PartCosts costs = measure_parts(options.iterations);
+    printf("%-12s %10.1f %10.1f %12.1f %12.1f\n", cached ? "cached" : "heap", costs.frame_ns, costs.call_ns,
+           costs.resume_ns, costs.callback_ns);
+  }
+  FrameCache::set_enabled(true);
+  FrameCache::reset_stats();
+  leaf(0);
+  printf("(frame: create and destroy a task of %zu bytes; call: co_await it; resume: co_await a wakeup through\n"
+         " the Executor; callback: the same wakeup as a callback chain)\n",
+         FrameCache::get_largest_frame());
+
+  FlowStats stats = run_flows(options);
+  printf("\n%u ZMOD4510 and an HS3xxx on one %u kHz bus, %u cycles each\n", options.sensors, options.hz / 1000,
+         options.cycles);
+  printf("%8s %8s %12s %12s %12s %14s\n", "cycles", "failures", "frames/cycle", "resumes/cycle", "heap allocs",
+         "largest frame");
+  double per_cycle = stats.cycles ? 1.0 / stats.cycles : 0.0;
+  printf("%8u %8u %12.2f %12.2f %12u %14zu\n", stats.cycles, stats.failures, stats.frames * per_cycle,
+         stats.resumes * per_cycle, stats.heap_allocations, stats.largest_frame);
+  printf("(counted from the second cycle on; heap allocs: frames not served by the FrameCache)\n");
+  uint32_t expected = uint32_t(options.sensors) * options.cycles;
+  return stats.cycles == expected && stats.failures == 0 && stats.heap_allocations == 0 ? 0 : 1;
+}
+
+#else
+
+int run_coroutine_benchmark(const CoroutineBenchOptions &options) {
+  printf("the coroutine benchmark needs a build with -std=gnu++20 and -DUSE_ZMOD4510_ASYNC_HAL\n");
+  return 2;
+}
+
+#endif
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zmod4510 {
+namespace sim {
+
+struct CoroutineBenchOptions {
+  uint8_t sensors{4};
+  uint32_t cycles{100};
+  uint32_t iterations{1000000};
+  uint32_t hz{400000};
+};
+
+// Benchmark of the coroutine layer (coroutine.h, zmod4xxx_tasks.h). First the
+// host cost of its parts: creating and destroying a frame, awaiting a nested
+// task, and one suspend and resume through the Executor next to the same step
+// as a plain callback, each with the FrameCache and with every frame from the
+// heap. Then several ZMOD4510s and an HS3xxx run the sequences side by side on
+// one simulated bus: bring-up and preparation, then measurement cycles.
+// Prints frames and resumes per cycle and the heap allocations once running;
+// returns 0 if every cycle completed without any.
+int run_coroutine_benchmark(const CoroutineBenchOptions &options);
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,170 @@
+#include "drift_test.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+#include "esphome/core/application.h"
+#include "virtual_clock.h"
+#include "zmod4510_component.h"
+#include "zmod4510_simulator.h"
+
+namespace zmod4510 {
+namespace sim {
+
+static const uint32_t PERIOD_MS = ZMOD4510_NO2_O3_SAMPLE_TIME;
+
+// The component with its scheduler in view.
+class ScheduledZMOD4510 : public ZMOD4510 {
+ public:
+  const SampleScheduler &get_scheduler() const { return this->scheduler_; }
+};
+
+// Runs first in every loop pass and takes a random share of it, like the
+// other components of a node would. The last periods of the run are free of
+// stalls, so the final start shows the cadence settled again.
+class JitterSource : public esphome::Component {
+ public:
+  explicit JitterSource(const DriftTestOptions &options)
+      : random_(options.seed), jitter_(0, options.jitter_ms * 1000), stall_(0, options.stall_ms * 1000) {
+    if (options.stalls_per_hour != 0)
+      this->stall_every_us_ = 3600000000ULL / options.stalls_per_hour;
+    this->next_stall_us_ = this->stall_every_us_;
+    this->stalls_end_us_ = uint64_t(options.hours * 3600e6) - 2ULL * (PERIOD_MS + options.stall_ms) * 1000;
+  }
+
+  float get_setup_priority() const override { return esphome::setup_priority::BUS; }
+  void loop() override {
+    uint64_t now = virtual_clock().uptime_us();
+    if (this->stall_every_us_ != 0 && now >= this->next_stall_us_ && now < this->stalls_end_us_) {
+      this->next_stall_us_ += this->stall_every_us_;
+      virtual_clock().advance_us(this->stall_(this->random_));
+      this->stalls_++;
+      return;
+    }
+    virtual_clock().advance_us(this->jitter_(this->random_));
+  }
+
+  uint32_t get_stalls() const { return this->stalls_; }
+
+ protected:
+  std::mt19937 random_;
+  std::uniform_int_distribution<uint32_t> jitter_;
+  std::uniform_int_distribution<uint32_t> stall_;
+  uint64_t stall_every_us_{0};
+  uint64_t next_stall_us_{0};
+  uint64_t stalls_end_us_{0};
+  uint32_t stalls_{0};
+};
+
+struct Cadence {
+  bool started{false};
+  uint32_t first_ms{0};
+  uint32_t starts{0};
+  // Offset of each start from the latest grid point before it.
+  uint32_t max_offset_ms{0};
+  uint32_t last_offset_ms{0};
+  uint32_t late_starts{0};
+};
+
+// What a schedule that sets each deadline one period after it was served
+// would do in the same loop: it falls behind the grid by every delay.
+class RelativeSchedule : public esphome::Component {
+ public:
+  explicit RelativeSchedule(const Cadence &cadence) : cadence_(cadence) {}
+
+  float get_setup_priority() const override { return esphome::setup_priority::LATE; }
+  void loop() override {
+    if (!this->cadence_.started)
+      return;
+    uint32_t now = uint32_t(virtual_clock().uptime_us() / 1000);
+    if (this->samples_ == 0) {
+      this->deadline_ms_ = this->cadence_.first_ms;
+    }
+    if (static_cast<int32_t>(now - this->deadline_ms_) < 0)
+      return;
+    this->samples_++;
+    this->deadline_ms_ = now + PERIOD_MS;
+  }
+
+  uint32_t get_samples() const { return this->samples_; }
+  // How far the next deadline lies behind the grid.
+  uint32_t get_drift_ms() const { return this->deadline_ms_ - this->cadence_.first_ms - this->samples_ * PERIOD_MS; }
+
+ protected:
+  const Cadence &cadence_;
+  uint32_t deadline_ms_{0};
+  uint32_t samples_{0};
+};
+
+int run_drift_test(const DriftTestOptions &options) {
+  // A deadline is served by the first loop pass after it: one loop interval
+  // and one pass of jitter late at most.
+  const uint32_t offset_limit_ms = options.loop_ms + options.jitter_ms + 1;
+
+  esphome::App.reset();
+  esphome::App.set_loop_interval(options.loop_ms);
+  ZMOD4510Simulator device;
+  ScheduledZMOD4510 component;
+  JitterSource jitter(options);
+  Cadence cadence;
+  RelativeSchedule relative(cadence);
+  component.set_i2c_bus(&device);
+  component.set_i2c_address(ZMOD4510Simulator::ADDRESS);
+  esphome::App.register_component(&jitter);
+  esphome::App.register_component(&component);
+  esphome::App.register_component(&relative);
+
+  device.set_event_callback([&](ZMOD4510Simulator::Event event) {
+    if (event != ZMOD4510Simulator::EVENT_MEASUREMENT)
+      return;
+    uint32_t now = uint32_t(virtual_clock().uptime_us() / 1000);
+    if (!cadence.started) {
+      cadence.started = true;
+      cadence.first_ms = component.get_scheduler().get_next_deadline() - PERIOD_MS;
+    }
+    cadence.starts++;
+    uint32_t offset = (now - cadence.first_ms) % PERIOD_MS;
+    cadence.last_offset_ms = offset;
+    cadence.max_offset_ms = std::max(cadence.max_offset_ms, offset);
+    if (offset > offset_limit_ms)
+      cadence.late_starts++;
+  });
+
+  auto start = std::chrono::steady_clock::now();
+  esphome::App.setup();
+  esphome::App.run_until(uint64_t(options.hours * 3600 * 1000));
+  esphome::App.shutdown();
+  double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  device.set_event_callback(nullptr);
+  esphome::App.reset();
+
+  const SampleScheduler &scheduler = component.get_scheduler();
+  // Deadlines handed out plus those skipped must add up to the grid exactly.
+  uint32_t periods = scheduler.get_samples() + scheduler.get_missed_samples();
+  int64_t grid_error_ms =
+      int64_t(scheduler.get_next_deadline()) - (int64_t(cadence.first_ms) + int64_t(periods) * PERIOD_MS);
+
+  printf("%.1f h with %u ms loop passes, up to %u ms jitter, %u stalls of up to %u ms (%.2f s wall)\n",
+         options.hours, options.loop_ms, options.jitter_ms, jitter.get_stalls(), options.stall_ms, wall_s);
+  printf("%8s %8s %8s %8s %12s %12s %12s\n", "starts", "samples", "missed", "late", "grid [ms]", "offset [ms]",
+         "max [ms]");
+  printf("%8u %8u %8u %8u %12lld %12u %12u\n", cadence.starts, scheduler.get_samples(),
+         scheduler.get_missed_samples(), cadence.late_starts, (long long) grid_error_ms, cadence.last_offset_ms,
+         cadence.max_offset_ms);
+  printf("(grid: last deadline minus its place on the grid of whole periods; offset: last start after its\n"
+         " deadline; late: starts more than %u ms after their deadline)\n",
+         offset_limit_ms);
+  printf("jitter p50 %u ms, p95 %u ms, p99 %u ms\n", scheduler.get_jitter_percentile(50),
+         scheduler.get_jitter_percentile(95), scheduler.get_jitter_percentile(99));
+  printf("deadlines one period after each served one instead: %u samples, %.1f s behind the grid\n",
+         relative.get_samples(), relative.get_drift_ms() / 1e3);
+
+  bool ok = cadence.starts != 0 && grid_error_ms == 0 && cadence.late_starts <= jitter.get_stalls() &&
+            cadence.last_offset_ms <= offset_limit_ms;
+  return ok ? 0 : 1;
+}
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zmod4510 {
+namespace sim {
+
+struct DriftTestOptions {
+  double hours{24};
+  uint32_t loop_ms{16};
+  // Every loop pass takes up to this much longer, uniformly distributed, as
+  // if other components were busy.
+  uint32_t jitter_ms{40};
+  // Now and then a pass stalls for up to stall_ms, as on a WiFi reconnect;
+  // long stalls miss whole sample periods.
+  uint32_t stalls_per_hour{2};
+  uint32_t stall_ms{15000};
+  uint32_t seed{1};
+};
+
+// Runs the component against the simulator for `hours` of virtual time with a
+// jittery main loop and checks the cadence of the SampleScheduler: every
+// deadline must lie on the grid of whole sample periods from the first one,
+// and every measurement must start within one loop pass and its jitter of
+// its deadline, except right after a stall. For comparison, it also tracks a
+// schedule that sets each deadline one period after the previous start, whose
+// drift accumulates. Returns 0 if the deadlines did not drift.
+int run_drift_test(const DriftTestOptions &options);
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,141 @@
+#include "esphome/core/application.h"
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include <Arduino.h>
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+
+#include "virtual_clock.h"
+
+using zmod4510::sim::virtual_clock;
+
+uint32_t millis() { return uint32_t(virtual_clock().uptime_us() / 1000); }
+uint32_t micros() { return uint32_t(virtual_clock().uptime_us()); }
+void delay(uint32_t ms) { virtual_clock().add_delay_ms(ms); }
+
+namespace esphome {
+
+Application App;
+int log_level = ESPHOME_LOG_LEVEL_INFO;
+
+uint32_t millis() { return ::millis(); }
+uint32_t micros() { return ::micros(); }
+void delay(uint32_t ms) { ::delay(ms); }
+
+void esp_log_printf_(int level, const char *tag, int line, const char *format, ...) {
+  if (level > log_level)
+    return;
+  static const char LETTERS[] = "?EWICDV";
+  uint64_t ms = virtual_clock().uptime_us() / 1000;
+  printf("[%02u:%02u:%02u.%03u][%c][%s:%d]: ", unsigned(ms / 3600000), unsigned(ms / 60000 % 60),
+         unsigned(ms / 1000 % 60), unsigned(ms % 1000), LETTERS[level], tag, line);
+  va_list args;
+  va_start(args, format);
+  vprintf(format, args);
+  va_end(args);
+  putchar('\n');
+}
+
+void Component::set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f) {
+  App.set_timer(this, name, timeout, 0, std::move(f));
+}
+
+void Component::set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f) {
+  App.set_timer(this, name, interval, interval, std::move(f));
+}
+
+bool Component::cancel_timeout(const std::string &name) { return App.cancel_timer(this, name); }
+bool Component::cancel_interval(const std::string &name) { return App.cancel_timer(this, name); }
+
+void PollingComponent::call_setup() {
+  this->setup();
+  if (this->update_interval_ != 0 && !this->is_failed())
+    this->set_interval("update", this->update_interval_, [this]() { this->update(); });
+}
+
+void Application::setup() {
+  std::stable_sort(this->components_.begin(), this->components_.end(), [](Component *a, Component *b) {
+    return a->get_setup_priority() > b->get_setup_priority();
+  });
+  for (Component *component : this->components_)
+    component->call_setup();
+}
+
+void Application::loop() {
+  for (Component *component : this->components_) {
+    if (!component->is_failed())
+      component->loop();
+  }
+  this->run_timers_();
+  this->loop_count_++;
+  virtual_clock().advance_ms(this->loop_interval_);
+}
+
+void Application::run_until(uint64_t ms) {
+  while (virtual_clock().uptime_us() / 1000 < ms)
+    this->loop();
+}
+
+void Application::reset() {
+  this->components_.clear();
+  this->timers_.clear();
+  this->loop_count_ = 0;
+}
+
+void Application::shutdown() {
+  for (Component *component : this->components_)
+    component->on_shutdown();
+}
+
+void Application::set_timer(Component *component, const std::string &name, uint32_t delay, uint32_t interval,
+                            std::function<void()> &&f) {
+  this->cancel_timer(component, name);
+  this->timers_.push_back(Timer{component, name, virtual_clock().uptime_us() / 1000 + delay, interval, std::move(f)});
+}
+
+bool Application::cancel_timer(Component *component, const std::string &name) {
+  for (auto it = this->timers_.begin(); it != this->timers_.end(); ++it) {
+    if (it->component == component && it->name == name) {
+      this->timers_.erase(it);
+      return true;
+    }
+  }
+  return false;
+}
+
+void Application::run_timers_() {
+  // Timers may add or cancel timers, so look the next due one up each time.
+  for (;;) {
+    uint64_t now = virtual_clock().uptime_us() / 1000;
+    auto due = this->timers_.end();
+    for (auto it = this->timers_.begin(); it != this->timers_.end(); ++it) {
+      if (it->due_ms <= now && (due == this->timers_.end() || it->due_ms < due->due_ms))
+        due = it;
+    }
+    if (due == this->timers_.end())
+      return;
+    std::function<void()> f = due->f;
+    if (due->interval != 0) {
+      due->due_ms += due->interval;
+    } else {
+      this->timers_.erase(due);
+    }
+    f();
+  }
+}
+
+}  // namespace esphome
+
+namespace zmod4510 {
+namespace sim {
+
+VirtualClock &virtual_clock() {
+  // One clock per thread, so threads of the HAL stress test keep their own time.
+  static thread_local VirtualClock instance;
+  return instance;
+}
+
+}  // namespace sim
+}  // namespace zmod4510
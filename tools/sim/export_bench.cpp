@@ -0,0 +1,160 @@
+#include "export_bench.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <malloc.h>
+#include <memory>
+#include <new>
+
+#include "history_export.h"
+#include "sample_history.h"
+
+extern "C" {
+#include "zmod4510_config_no2_o3.h"
+}
+
+#ifdef USE_ZMOD4510_HISTORY_EXPORT
+
+// Heap use while an export runs, counted by replacing the global allocator.
+// Outside of a measurement it only forwards to malloc.
+static bool heap_tracking = false;
+static size_t heap_live = 0;
+static size_t heap_peak = 0;
+
+void *operator new(size_t size) {
+  void *p = malloc(size ? size : 1);
+  if (p == nullptr)
+    abort();
+  if (heap_tracking) {
+    heap_live += malloc_usable_size(p);
+    heap_peak = std::max(heap_peak, heap_live);
+  }
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  if (p != nullptr && heap_tracking)
+    heap_live -= std::min(heap_live, malloc_usable_size(p));
+  free(p);
+}
+
+void operator delete(void *p, size_t) noexcept { operator delete(p); }
+
+namespace zmod4510 {
+namespace sim {
+
+using WallClock = std::chrono::steady_clock;
+
+static const uint32_t PERIOD_S = ZMOD4510_NO2_O3_SAMPLE_TIME / 1000;
+static const char *const RESOLUTION_NAMES[SampleHistory::NUM_RESOLUTIONS] = {"raw", "minute", "hour", "day"};
+static const char *const FORMAT_NAMES[] = {"csv", "bin"};
+// UART: one chunk per loop() (poll_export_uart_); web: a TCP segment.
+static const size_t CHUNK_SIZES[] = {64, 1460};
+static const size_t MAX_CHUNK = 1460;
+
+struct ExportRun {
+  uint32_t entries{0};
+  uint64_t bytes{0};
+  uint32_t chunks{0};
+  double seconds{0};
+  size_t heap_peak{0};
+};
+
+// One export from creating its state to the final empty read.
+static ExportRun export_once(const SampleHistory &history, HistoryExport::Format format,
+                             SampleHistory::Resolution resolution, size_t chunk, uint8_t *buffer) {
+  ExportRun run;
+  heap_live = 0;
+  heap_peak = 0;
+  heap_tracking = true;
+  auto start = WallClock::now();
+  {
+    std::shared_ptr<HistoryExport> state = std::make_shared<HistoryExport>(format, resolution, 0, UINT32_MAX);
+    size_t len;
+    while ((len = state->read(history, buffer, chunk)) != 0) {
+      run.bytes += len;
+      run.chunks++;
+    }
+    run.entries = state->get_entries();
+  }
+  run.seconds = std::chrono::duration<double>(WallClock::now() - start).count();
+  heap_tracking = false;
+  run.heap_peak = heap_peak;
+  return run;
+}
+
+// A sample too wide for a CSV line must be cut short, newline included,
+// within the line buffer.
+static bool check_wide_line() {
+  SampleHistory history;
+  history.init(1, 0, 0, 0);
+  const float values[HistoryBucket::NUM_CHANNELS] = {-3.0e38f, 3.0e38f};
+  history.add(PERIOD_S, values);
+  HistoryExport state(HistoryExport::FORMAT_CSV, SampleHistory::RAW, 0, UINT32_MAX);
+  char csv[1024];
+  size_t len = state.read(history, reinterpret_cast<uint8_t *>(csv), sizeof(csv));
+  const char *line = static_cast<const char *>(memchr(csv, '\n', len));
+  if (line == nullptr || state.get_entries() != 1 || csv[len - 1] != '\n')
+    return false;
+  size_t line_len = len - (line + 1 - csv);
+  printf("wide values: %zu byte line, %s\n", line_len, line_len <= 160 ? "cut short in bounds" : "too long");
+  return line_len <= 160;
+}
+
+int run_export_benchmark(const ExportBenchOptions &options) {
+  uint32_t samples = uint32_t(options.days * 86400 / PERIOD_S);
+  if (samples == 0) {
+    printf("export benchmark needs at least one sample\n");
+    return 2;
+  }
+  SampleHistory history;
+  history.init(samples, samples / 10 + 1, samples / 600 + 1, samples / 14400 + 1);
+  for (uint32_t i = 0; i < samples; i++) {
+    float t = float(i) / 600;
+    const float values[HistoryBucket::NUM_CHANNELS] = {12.0f + 8.0f * (t - int(t)), 35.0f - float(i % 97) / 10};
+    history.add((i + 1) * PERIOD_S, values);
+  }
+
+  printf("history export: %.1f days of samples, %zu byte export state\n", options.days, sizeof(HistoryExport));
+  printf("%-7s %-4s %6s %8s %10s %8s %10s %10s %10s %10s\n", "level", "fmt", "chunk", "entries", "bytes", "chunks",
+         "time [ms]", "MB/s", "ns/entry", "heap [B]");
+  std::unique_ptr<uint8_t[]> buffer(new uint8_t[MAX_CHUNK]);
+  bool ok = true;
+  for (uint8_t r = 0; r < SampleHistory::NUM_RESOLUTIONS; r++) {
+    auto resolution = SampleHistory::Resolution(r);
+    for (uint8_t f = 0; f < 2; f++) {
+      for (size_t chunk : CHUNK_SIZES) {
+        ExportRun run = export_once(history, HistoryExport::Format(f), resolution, chunk, buffer.get());
+        printf("%-7s %-4s %6zu %8u %10llu %8u %10.3f %10.1f %10.1f %10zu\n", RESOLUTION_NAMES[r], FORMAT_NAMES[f],
+               chunk, run.entries, (unsigned long long) run.bytes, run.chunks, run.seconds * 1e3,
+               run.bytes / run.seconds / 1e6, run.entries ? run.seconds * 1e9 / run.entries : 0.0, run.heap_peak);
+        ok &= run.entries == history.size(resolution);
+      }
+    }
+  }
+  printf("(heap: peak allocation from creating the export state to its last chunk; the chunk buffer belongs\n"
+         " to the caller)\n");
+  ok &= check_wide_line();
+  return ok ? 0 : 1;
+}
+
+}  // namespace sim
+}  // namespace zmod4510
+
+#else
+
+namespace zmod4510 {
+namespace sim {
+
+int run_export_benchmark(const ExportBenchOptions &options) {
+  printf("the export benchmark needs a build with -DUSE_ZMOD4510_HISTORY -DUSE_ZMOD4510_HISTORY_EXPORT,\n"
+         "sample_history.cpp and history_export.cpp\n");
+  return 2;
+}
+
+}  // namespace sim
+}  // namespace zmod4510
+
+#endif
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zmod4510 {
+namespace sim {
+
+struct ExportBenchOptions {
+  // Days of samples at the 6 s cadence in the history; every level is sized
+  // to hold all of them.
+  double days{1};
+};
+
+// Fills a SampleHistory and streams every resolution through HistoryExport as
+// CSV and binary, in the chunk sizes of the UART loop and of a web response.
+// Reports per export the entries, bytes, throughput, time per entry and the
+// peak heap use from creating the export state as the web handler does to
+// the last chunk. Then exports a bucket with values too wide for a CSV line
+// and checks that the line is cut short inside its buffer. Returns 0 if every
+// export delivered all entries and the wide line stayed in bounds.
+int run_export_benchmark(const ExportBenchOptions &options);
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,197 @@
+#include "fault_injection.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+
+#include "esphome/core/application.h"
+#include "virtual_clock.h"
+#include "zmod4510_component.h"
+#include "zmod4510_simulator.h"
+
+namespace zmod4510 {
+namespace sim {
+
+static const uint32_t PERIOD_MS = ZMOD4510_NO2_O3_SAMPLE_TIME;
+
+// The component with its bring-up state in view.
+class ObservedZMOD4510 : public ZMOD4510 {
+ public:
+  bool is_up() const { return this->bring_up_ == BRING_UP_DONE; }
+  bool is_recovering() const { return this->bring_up_ == BRING_UP_RECOVER; }
+};
+
+enum Fault : uint8_t {
+  FAULT_RESET,       // power-on reset in the middle of a measurement
+  FAULT_NACK,        // NACK burst in the middle of a measurement
+  FAULT_RESET_NACK,  // power-on reset, then NACKs while the recovery polls
+  NUM_FAULTS,
+};
+
+struct FaultStats {
+  uint32_t rounds{0};
+  uint32_t recovered{0};
+  uint32_t max_recovery_ms{0};
+  uint32_t max_outage_ms{0};
+  uint64_t blocked_us{0};
+  uint32_t nacks{0};
+};
+
+class FaultRun {
+ public:
+  FaultRun(ObservedZMOD4510 &component, ZMOD4510Simulator &device) : component_(component), device_(device) {
+    device.set_event_callback([this](ZMOD4510Simulator::Event event) {
+      if (event == ZMOD4510Simulator::EVENT_MEASUREMENT) {
+        this->starts_++;
+        this->last_start_us_ = virtual_clock().now_us();
+      }
+    });
+  }
+  ~FaultRun() { this->device_.set_event_callback(nullptr); }
+
+  // Run loop passes until `done` or for `limit_ms`; returns whether `done`.
+  bool run_until(const std::function<bool()> &done, uint64_t limit_ms) {
+    uint64_t end_us = virtual_clock().now_us() + limit_ms * 1000;
+    while (!done()) {
+      if (virtual_clock().now_us() >= end_us)
+        return false;
+      esphome::App.loop();
+    }
+    return true;
+  }
+
+  // Move to the middle of the next measurement.
+  bool mid_cycle() {
+    uint32_t starts = this->starts_;
+    if (!this->run_until([&]() { return this->starts_ != starts; }, 3 * PERIOD_MS))
+      return false;
+    uint64_t mid_us = this->last_start_us_ + PERIOD_MS * 500;
+    return this->run_until([&]() { return virtual_clock().now_us() >= mid_us; }, PERIOD_MS);
+  }
+
+  // Inject one fault and wait for measurements to resume. The outage runs from
+  // the fault to the next measurement start after it has been dealt with.
+  bool inject(Fault fault, uint32_t nack_ms, uint32_t outage_limit_ms, FaultStats &stats) {
+    if (!this->mid_cycle())
+      return false;
+    uint32_t recoveries = this->component_.get_reset_recoveries();
+    uint32_t failed = this->device_.get_failed_transfers();
+    uint64_t delayed_us = virtual_clock().get_delayed_us();
+    uint64_t fault_us = virtual_clock().now_us();
+    stats.rounds++;
+
+    if (fault == FAULT_NACK) {
+      this->device_.fail_transfers(nack_ms);
+    } else {
+      this->device_.power_on();
+    }
+    if (fault == FAULT_RESET_NACK) {
+      if (!this->run_until([&]() { return this->component_.is_recovering(); }, 2 * PERIOD_MS))
+        return false;
+      this->device_.fail_transfers(nack_ms);
+    }
+
+    bool ok;
+    if (fault == FAULT_NACK) {
+      uint64_t end_us = fault_us + uint64_t(nack_ms) * 1000;
+      ok = this->run_until([&]() { return virtual_clock().now_us() >= end_us; }, nack_ms);
+    } else {
+      ok = this->run_until([&]() { return this->component_.get_reset_recoveries() != recoveries; },
+                           outage_limit_ms);
+    }
+    uint32_t starts = this->starts_;
+    ok = ok && this->run_until([&]() { return this->starts_ != starts; }, outage_limit_ms);
+    if (!ok)
+      return false;
+
+    uint32_t outage_ms = uint32_t((this->last_start_us_ - fault_us) / 1000);
+    stats.max_outage_ms = std::max(stats.max_outage_ms, outage_ms);
+    if (fault != FAULT_NACK)
+      stats.max_recovery_ms = std::max(stats.max_recovery_ms, this->component_.get_last_recovery_ms());
+    stats.blocked_us += virtual_clock().get_delayed_us() - delayed_us;
+    stats.nacks += this->device_.get_failed_transfers() - failed;
+    // A NACK burst is no reset; it must not set off a recovery.
+    if (fault == FAULT_NACK && this->component_.get_reset_recoveries() != recoveries)
+      return false;
+    if (outage_ms > outage_limit_ms)
+      return false;
+    stats.recovered++;
+    return true;
+  }
+
+ protected:
+  ObservedZMOD4510 &component_;
+  ZMOD4510Simulator &device_;
+  uint32_t starts_{0};
+  uint64_t last_start_us_{0};
+};
+
+int run_fault_injection_test(const FaultInjectionOptions &options) {
+  static const char *const NAMES[NUM_FAULTS] = {"reset", "nack", "reset + nack"};
+  // Once detected, a reset costs an init sequence and the loop passes that
+  // poll it. It is detected at the next deadline, half a period after the
+  // fault, and measuring resumes at the deadline after the recovery. Transfers
+  // that fail are retried at the next deadline, so a NACK burst costs the
+  // deadlines it covers.
+  const uint32_t recovery_limit_ms = ZMOD4XXX_INIT_SEQ_TIME_MS + 2 * options.loop_ms;
+  const uint32_t nack_periods = (options.nack_ms + PERIOD_MS - 1) / PERIOD_MS;
+  const uint32_t recovery_limits_ms[NUM_FAULTS] = {
+      recovery_limit_ms,
+      0,
+      nack_periods * PERIOD_MS + recovery_limit_ms,
+  };
+  const uint32_t outage_limits_ms[NUM_FAULTS] = {
+      2 * PERIOD_MS + recovery_limit_ms,
+      options.nack_ms + PERIOD_MS,
+      (2 + nack_periods) * PERIOD_MS + recovery_limit_ms,
+  };
+
+  esphome::App.reset();
+  esphome::App.set_loop_interval(options.loop_ms);
+  ZMOD4510Simulator device;
+  ObservedZMOD4510 component;
+  component.set_i2c_bus(&device);
+  component.set_i2c_address(ZMOD4510Simulator::ADDRESS);
+  esphome::App.register_component(&component);
+  esphome::App.setup();
+
+  FaultStats stats[NUM_FAULTS];
+  bool ok = false;
+  {
+    FaultRun run(component, device);
+    ok = run.run_until([&]() { return component.is_up(); }, 60000);
+    for (uint32_t round = 0; ok && round < options.rounds; round++) {
+      for (uint8_t fault = 0; ok && fault < NUM_FAULTS; fault++) {
+        ok = run.inject(Fault(fault), options.nack_ms, outage_limits_ms[fault], stats[fault]);
+      }
+    }
+  }
+  esphome::App.shutdown();
+  esphome::App.reset();
+
+  printf("fault injection: %u rounds per fault, %u ms NACK bursts, %u ms loop\n", options.rounds, options.nack_ms,
+         options.loop_ms);
+  printf("%-13s %7s %10s %7s %14s %11s %12s %11s %13s\n", "fault", "rounds", "recovered", "NACKs", "recovery [ms]",
+         "limit [ms]", "outage [ms]", "limit [ms]", "blocked [ms]");
+  for (uint8_t fault = 0; fault < NUM_FAULTS; fault++) {
+    const FaultStats &s = stats[fault];
+    printf("%-13s %7u %10u %7u", NAMES[fault], s.rounds, s.recovered, s.nacks);
+    if (recovery_limits_ms[fault] != 0) {
+      printf(" %14u %11u", s.max_recovery_ms, recovery_limits_ms[fault]);
+    } else {
+      printf(" %14s %11s", "-", "-");
+    }
+    printf(" %12u %11u %13.1f\n", s.max_outage_ms, outage_limits_ms[fault], s.blocked_us / 1e3);
+    if (s.max_recovery_ms > recovery_limits_ms[fault] || s.blocked_us != 0)
+      ok = false;
+  }
+  printf("(recovery: reset detected to sensor ready, max; outage: fault to the next measurement started, max;\n"
+         " blocked: time loop() spent in delay() from the fault on)\n");
+  uint32_t expected = options.rounds;
+  for (const FaultStats &s : stats)
+    ok = ok && s.recovered == expected;
+  return ok ? 0 : 1;
+}
+
+}  // namespace sim
+}  // namespace zmod4510
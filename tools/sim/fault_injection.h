@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zmod4510 {
+namespace sim {
+
+struct FaultInjectionOptions {
+  uint32_t loop_ms{16};
+  // Rounds of each fault.
+  uint32_t rounds{8};
+  // Length of a NACK burst; the default covers the next deadline.
+  uint32_t nack_ms{4000};
+};
+
+// Runs the component against the simulator and injects faults in the middle
+// of measurement cycles: a power-on reset of the sensor, a burst of NACKs,
+// and a reset whose recovery runs into NACKs. Measures per fault how long the
+// recovery took (from detecting the reset to the sensor being ready), how long
+// the sensor went without starting a measurement, and how long loop() was
+// blocked in delay() meanwhile. Returns 0 if every fault was recovered from
+// within its bound without blocking the loop.
+int run_fault_injection_test(const FaultInjectionOptions &options);
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace zmod4510 {
+namespace sim {
+
+// Ambient conditions and the MOx response of the simulated sensor. The
+// response is made up for the simulation: it only has to be smooth, invertible
+// and shaped like a real deployment (a diurnal ozone cycle, NO2 rush hours and
+// a baseline that settles after power-on).
+struct GasModel {
+  static const uint8_t NUM_CHANNELS = 4;
+
+  // Baseline resistance per channel (ohm) and the relative change per ppb.
+  float baseline[NUM_CHANNELS]{2.0e5f, 4.0e5f, 8.0e5f, 1.6e6f};
+  float o3_gain[NUM_CHANNELS]{0.020f, 0.012f, 0.006f, 0.002f};
+  float no2_gain[NUM_CHANNELS]{0.002f, 0.010f, 0.020f, 0.030f};
+  // After power-on the baseline starts this much higher and settles with tau.
+  float warmup_excess{1.5f};
+  float warmup_tau_s{1800.0f};
+
+  // Ozone peaks in the afternoon, NO2 with the morning and evening traffic.
+  static float o3_ppb(double t_s) {
+    double h = std::fmod(t_s / 3600.0, 24.0);
+    return float(30.0 + 25.0 * std::cos((h - 15.0) * M_PI / 12.0));
+  }
+  static float no2_ppb(double t_s) {
+    double h = std::fmod(t_s / 3600.0, 24.0);
+    return float(12.0 + 25.0 * std::exp(-(h - 8.0) * (h - 8.0) / 2.0) + 20.0 * std::exp(-(h - 18.0) * (h - 18.0) / 3.0));
+  }
+
+  // Resistance of `channel` at `t_s` seconds of day, `on_s` seconds after power-on.
+  float rmox(uint8_t channel, double t_s, double on_s) const {
+    float settle = 1.0f + this->warmup_excess * float(std::exp(-on_s / this->warmup_tau_s));
+    return this->baseline[channel] * settle *
+           (1.0f + this->o3_gain[channel] * o3_ppb(t_s) + this->no2_gain[channel] * no2_ppb(t_s));
+  }
+};
+
+}  // namespace sim
+}  // namespace zmod4510
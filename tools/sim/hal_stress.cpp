@@ -0,0 +1,153 @@
+#include "hal_stress.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "esphome_hal.h"
+#include "simulated_bus.h"
+#include "virtual_clock.h"
+#include "zmod4510_simulator.h"
+
+extern "C" {
+#include "zmod4xxx.h"
+#include "zmod4xxx_hal.h"
+#include "zmod4510_config_no2_o3.h"
+}
+
+namespace zmod4510 {
+namespace sim {
+
+// The zmod4xxx_hal wrapper binds at most this many devices at a time.
+static const uint8_t MAX_THREADS = 32;
+static const uint32_t BUS_HZ = 400000;
+// Nothing answers here, so reads from it are not acknowledged.
+static const uint8_t ABSENT_ADDRESS = 0x7F;
+
+struct WorkerResult {
+  uint32_t cycles{0};
+  uint32_t failures{0};  // driver calls that returned an error
+  uint32_t measurements{0};  // measurements the thread's own sensor started
+  uint32_t conflicts{0};
+  uint32_t error_checks{0};
+  uint32_t foreign_errors{0};  // an interface read back an error it did not raise
+};
+
+static void worker(uint8_t index, const HalStressOptions &options, std::atomic<uint8_t> &ready,
+                   WorkerResult &result) {
+  ZMOD4510Simulator device;
+  SimulatedBus bus;
+  bus.set_frequency(BUS_HZ);
+  bus.add_device(ZMOD4510Simulator::ADDRESS, &device);
+  Interface_t hal;
+  esphome_hal_init(&hal, &bus);
+  // A second interface on the same bus, which the thread fails in the other
+  // way; its error must not show up on `hal`.
+  Interface_t other;
+  esphome_hal_init(&other, &bus);
+
+  uint8_t prod_data[ZMOD4510_PROD_DATA_LEN];
+  zmod4xxx_dev_t dev = {};
+  dev.i2c_addr = ZMOD4510Simulator::ADDRESS;
+  dev.pid = ZMOD4510_PID;
+  dev.prod_data = prod_data;
+  dev.init_conf = &zmod_no2_o3_sensor_cfg[INIT];
+  dev.meas_conf = &zmod_no2_o3_sensor_cfg[MEASUREMENT];
+
+  // Start together, so the bring-ups overlap as well.
+  ready++;
+  while (ready < options.threads)
+    std::this_thread::yield();
+
+  int ret = zmod4xxx_init(&dev, &hal);
+  if (ret == ZMOD4XXX_OK)
+    ret = zmod4xxx_read_sensor_info(&dev);
+  if (ret == ZMOD4XXX_OK)
+    ret = zmod4xxx_init_sensor(&dev);
+  if (ret == ZMOD4XXX_OK)
+    ret = zmod4xxx_init_measurement(&dev);
+  if (ret != ZMOD4XXX_OK) {
+    result.failures++;
+    zmod4xxx_deinit(&dev);
+    return;
+  }
+
+  // Even threads read from an absent device through `hal` and issue a write
+  // longer than the HAL's buffer through `other`, odd ones the other way
+  // round; the two fail with different codes.
+  Interface_t *too_large = index % 2 ? &hal : &other;
+  Interface_t *absent = index % 2 ? &other : &hal;
+  uint8_t adc_result[ZMOD4510_ADC_DATA_LEN];
+  uint8_t buffer[128] = {};
+  for (uint32_t cycle = 0; cycle < options.cycles; cycle++) {
+    ret = zmod4xxx_start_measurement(&dev);
+    virtual_clock().advance_ms(ZMOD4510_NO2_O3_SAMPLE_TIME);
+    if (ret == ZMOD4XXX_OK)
+      ret = zmod4xxx_read_adc_result(&dev, adc_result);
+    if (ret == ZMOD4XXX_OK)
+      ret = zmod4xxx_check_error_event(&dev);
+    if (ret != ZMOD4XXX_OK)
+      result.failures++;
+    result.cycles++;
+
+    HAL_I2CWrite(too_large, ZMOD4510Simulator::ADDRESS, buffer, sizeof(buffer), nullptr, 0);
+    HAL_I2CRead(absent, ABSENT_ADDRESS, buffer, 1, buffer, 1);
+    // Give the other threads a chance to raise their errors in between.
+    std::this_thread::yield();
+    int error, scope;
+    HAL_GetInterfaceErrorInfo(too_large, &error, &scope, nullptr, 0);
+    result.error_checks++;
+    if (error != esphome::i2c::ERROR_TOO_LARGE || scope != eesESPHome)
+      result.foreign_errors++;
+    HAL_GetInterfaceErrorInfo(absent, &error, &scope, nullptr, 0);
+    result.error_checks++;
+    if (error != esphome::i2c::ERROR_NOT_ACKNOWLEDGED || scope != eesESPHome)
+      result.foreign_errors++;
+    // The thread's last error is that of the read.
+    HAL_GetErrorInfo(&error, &scope, nullptr, 0);
+    result.error_checks++;
+    if (error != esphome::i2c::ERROR_NOT_ACKNOWLEDGED || scope != eesESPHome)
+      result.foreign_errors++;
+  }
+  result.measurements = device.get_measurements();
+  result.conflicts = device.get_access_conflicts();
+  zmod4xxx_deinit(&dev);
+}
+
+int run_hal_stress_test(const HalStressOptions &options) {
+  if (options.threads == 0 || options.threads > MAX_THREADS) {
+    printf("HAL stress test needs 1 to %u threads\n", MAX_THREADS);
+    return 2;
+  }
+  printf("HAL stress: %u threads, each with a ZMOD4510 on its own %u kHz bus, %u cycles\n", options.threads,
+         BUS_HZ / 1000, options.cycles);
+  std::vector<WorkerResult> results(options.threads);
+  std::vector<std::thread> threads;
+  std::atomic<uint8_t> ready{0};
+  auto wall_start = std::chrono::steady_clock::now();
+  for (uint8_t i = 0; i < options.threads; i++)
+    threads.emplace_back(worker, i, std::cref(options), std::ref(ready), std::ref(results[i]));
+  for (std::thread &thread : threads)
+    thread.join();
+  double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wall_start).count();
+
+  printf("%6s %8s %9s %9s %9s %8s %8s\n", "thread", "cycles", "measured", "conflicts", "failures", "errors",
+         "foreign");
+  bool ok = true;
+  for (uint8_t i = 0; i < options.threads; i++) {
+    const WorkerResult &result = results[i];
+    printf("%6u %8u %9u %9u %9u %8u %8u\n", i, result.cycles, result.measurements, result.conflicts,
+           result.failures, result.error_checks, result.foreign_errors);
+    ok &= result.cycles == options.cycles && result.measurements == options.cycles && result.conflicts == 0 &&
+          result.failures == 0 && result.foreign_errors == 0;
+  }
+  printf("(measured: measurements the thread's own sensor started; foreign: errors read back that another\n"
+         " interface or thread raised) %.1f ms wall\n",
+         wall_ms);
+  return ok ? 0 : 1;
+}
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zmod4510 {
+namespace sim {
+
+struct HalStressOptions {
+  uint8_t threads{4};
+  uint32_t cycles{2000};
+};
+
+// Stress test of the HAL across threads: every thread drives a ZMOD4510 at
+// the usual address on a bus of its own, as sensors on separate I2C
+// controllers driven from separate tasks would, and after each measurement
+// cycle provokes a different error on each of two interfaces to its bus.
+// Each thread runs on its own virtual clock. Checks that every sensor saw
+// exactly the cycles of its thread and that every interface read back its
+// own error; returns 0 if all did.
+int run_hal_stress_test(const HalStressOptions &options);
+
+}  // namespace sim
+}  // namespace zmod4510
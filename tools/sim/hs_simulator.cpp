@@ -0,0 +1,80 @@
+#include "hs_simulator.h"
+#include <cstring>
+
+#include "virtual_clock.h"
+
+namespace zmod4510 {
+namespace sim {
+
+static const uint32_t HS3XXX_CONVERSION_US = 33000;
+static const uint32_t HS4XXX_CONVERSION_US = 1700;
+static const uint8_t HS4XXX_MEASURE = 0xF5;
+static const uint8_t HS4XXX_READ_ID = 0xD7;
+
+// CRC-8 of the HS4xxx results, as checked by hs4xxx.cpp.
+static uint8_t hs4xxx_crc(const uint8_t *data, int len) {
+  uint16_t crc = 0xFF;
+  for (int i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int j = 0; j < 8; j++) {
+      crc <<= 1;
+      if (crc & 0x100)
+        crc ^= 0x11D;
+    }
+  }
+  return crc & 0xFF;
+}
+
+void HSxxxxSimulator::start_() {
+  this->measured_ = true;
+  this->measurements_++;
+  this->ready_us_ = virtual_clock().now_us() +
+                    (this->address_ == HS3XXX_ADDRESS ? HS3XXX_CONVERSION_US : HS4XXX_CONVERSION_US);
+}
+
+esphome::i2c::ErrorCode HSxxxxSimulator::write(uint8_t address, const uint8_t *buffer, size_t len, bool stop) {
+  if (address != this->address_)
+    return esphome::i2c::ERROR_NOT_ACKNOWLEDGED;
+  if (this->address_ == HS3XXX_ADDRESS) {
+    // Any write, even without data, requests a measurement.
+    this->start_();
+    return esphome::i2c::ERROR_OK;
+  }
+  this->command_ = len ? buffer[0] : 0;
+  if (this->command_ == HS4XXX_MEASURE)
+    this->start_();
+  return esphome::i2c::ERROR_OK;
+}
+
+esphome::i2c::ErrorCode HSxxxxSimulator::read(uint8_t address, uint8_t *buffer, size_t len) {
+  if (address != this->address_)
+    return esphome::i2c::ERROR_NOT_ACKNOWLEDGED;
+  uint8_t raw[5] = {};
+  uint16_t humidity = uint16_t(this->humidity_ / 100.0f * 0x3FFF);
+  uint16_t temperature = uint16_t((this->temperature_ + 40.0f) / 165.0f * 0x3FFF);
+  bool ready = this->measured_ && virtual_clock().now_us() >= this->ready_us_;
+  if (this->address_ == HS3XXX_ADDRESS) {
+    raw[0] = (humidity >> 8) & 0x3F;
+    raw[1] = humidity & 0xFF;
+    raw[2] = temperature >> 6;
+    raw[3] = uint8_t((temperature << 2) & 0xFC) | (ready ? 0 : 0x01);
+  } else if (this->command_ == HS4XXX_READ_ID) {
+    raw[0] = 0x00;
+    raw[1] = 0x00;
+    raw[2] = 0x45;
+    raw[3] = 0x10;
+  } else {
+    if (!ready)
+      return esphome::i2c::ERROR_NOT_ACKNOWLEDGED;  // The HS4xxx NACKs reads during a conversion.
+    raw[0] = (humidity >> 8) & 0x3F;
+    raw[1] = humidity & 0xFF;
+    raw[2] = (temperature >> 8) & 0x3F;
+    raw[3] = temperature & 0xFF;
+    raw[4] = hs4xxx_crc(raw, 4);
+  }
+  memcpy(buffer, raw, len < sizeof(raw) ? len : sizeof(raw));
+  return esphome::i2c::ERROR_OK;
+}
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+#include "esphome/components/i2c/i2c.h"
+
+namespace zmod4510 {
+namespace sim {
+
+// Model of a Renesas HS3xxx (0x44) or HS4xxx (0x54) humidity and temperature
+// sensor, enough for hs3xxx.cpp and hs4xxx.cpp: measurement requests,
+// conversion time on the virtual clock, and the raw result formats including
+// the HS3xxx stale flag and the HS4xxx CRC.
+class HSxxxxSimulator : public esphome::i2c::I2CBus {
+ public:
+  static const uint8_t HS3XXX_ADDRESS = 0x44;
+  static const uint8_t HS4XXX_ADDRESS = 0x54;
+
+  explicit HSxxxxSimulator(uint8_t address) : address_(address) {}
+
+  esphome::i2c::ErrorCode read(uint8_t address, uint8_t *buffer, size_t len) override;
+  esphome::i2c::ErrorCode write(uint8_t address, const uint8_t *buffer, size_t len, bool stop = true) override;
+
+  uint8_t get_address() const { return this->address_; }
+  void set_conditions(float temperature, float humidity) {
+    this->temperature_ = temperature;
+    this->humidity_ = humidity;
+  }
+  uint32_t get_measurements() const { return this->measurements_; }
+
+ protected:
+  void start_();
+
+  uint8_t address_;
+  float temperature_{22.0f};
+  float humidity_{45.0f};
+  uint64_t ready_us_{0};
+  bool measured_{false};
+  uint8_t command_{0};
+  uint32_t measurements_{0};
+};
+
+}  // namespace sim
+}  // namespace zmod4510
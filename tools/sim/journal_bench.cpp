@@ -0,0 +1,231 @@
+#include "journal_bench.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "flash_journal.h"
+#include "sample_record.h"
+
+extern "C" {
+#include "zmod4510_config_no2_o3.h"
+}
+
+namespace zmod4510 {
+namespace sim {
+
+#ifdef USE_ZMOD4510_JOURNAL
+
+using WallClock = std::chrono::steady_clock;
+
+// Batch sizes to compare; the journal's batch_size option allows 1 to 36.
+static const uint8_t BATCH_SIZES[] = {1, 5, 10, 20, 36};
+static const double SAMPLES_PER_DAY = 86400000.0 / ZMOD4510_NO2_O3_SAMPLE_TIME;
+
+// Counts what reaches the backend and can cut the power in the middle of a
+// write.
+class CountingStorage : public JournalStorage {
+ public:
+  explicit CountingStorage(JournalStorage *inner) : inner_(inner) {}
+
+  bool open() override { return this->inner_->open(); }
+  size_t get_size() const override { return this->inner_->get_size(); }
+  bool read(size_t offset, void *data, size_t len) override {
+    this->reads_++;
+    this->read_bytes_ += len;
+    return this->inner_->read(offset, data, len);
+  }
+  bool write(size_t offset, const void *data, size_t len) override {
+    if (this->cut_over_ != 0 && len > this->cut_over_) {
+      this->inner_->write(offset, data, len / 2);
+      this->written_bytes_ += len / 2;
+      return false;
+    }
+    this->written_bytes_ += len;
+    return this->inner_->write(offset, data, len);
+  }
+  bool erase(size_t offset, size_t len) override {
+    this->erased_bytes_ += len;
+    return this->inner_->erase(offset, len);
+  }
+
+  // Writes longer than `bytes`, i.e. batch payloads rather than headers, stop
+  // halfway and fail.
+  void cut_writes_over(size_t bytes) { this->cut_over_ = bytes; }
+  uint32_t get_reads() const { return this->reads_; }
+  uint64_t get_read_bytes() const { return this->read_bytes_; }
+  uint64_t get_written_bytes() const { return this->written_bytes_; }
+  uint64_t get_erased_bytes() const { return this->erased_bytes_; }
+
+ protected:
+  JournalStorage *inner_;
+  size_t cut_over_{0};
+  uint32_t reads_{0};
+  uint64_t read_bytes_{0};
+  uint64_t written_bytes_{0};
+  uint64_t erased_bytes_{0};
+};
+
+// A reboot: mount the journal afresh and restore it as the component does.
+struct Recovery {
+  bool mounted{false};
+  uint32_t records{0};
+  uint32_t last_timestamp{0};
+  bool ordered{true};
+  double mount_ms{0};
+  double restore_ms{0};
+  uint32_t reads{0};
+  uint64_t read_bytes{0};
+};
+
+static Recovery recover(const char *path, size_t size) {
+  Recovery result;
+  FileStorage file(path, size);
+  CountingStorage storage(&file);
+  FlashJournal journal(&storage);
+  auto start = WallClock::now();
+  result.mounted = journal.mount();
+  auto mounted = WallClock::now();
+  if (!result.mounted)
+    return result;
+  journal.for_each([&](const uint8_t *data, size_t len) {
+    const SeriesRecord *records = reinterpret_cast<const SeriesRecord *>(data);
+    for (size_t i = 0; i < len / sizeof(SeriesRecord); i++) {
+      if (result.records != 0 && records[i].timestamp <= result.last_timestamp)
+        result.ordered = false;
+      result.last_timestamp = records[i].timestamp;
+      result.records++;
+    }
+  });
+  auto restored = WallClock::now();
+  result.mount_ms = std::chrono::duration<double, std::milli>(mounted - start).count();
+  result.restore_ms = std::chrono::duration<double, std::milli>(restored - mounted).count();
+  result.reads = storage.get_reads();
+  result.read_bytes = storage.get_read_bytes();
+  return result;
+}
+
+struct Run {
+  uint64_t payload_bytes{0};
+  uint64_t written_bytes{0};
+  uint64_t erased_bytes{0};
+  uint32_t erases{0};
+  uint32_t segments{0};
+  uint32_t last_timestamp{0};
+  Recovery clean;
+  Recovery torn;
+  bool ok{false};
+};
+
+static void fill(SeriesRecord *batch, uint8_t count, uint32_t &timestamp) {
+  for (uint8_t i = 0; i < count; i++) {
+    timestamp += ZMOD4510_NO2_O3_SAMPLE_TIME / 1000;
+    batch[i] = SeriesRecord{timestamp, {12.5f, 31.0f, 1.2e5f, 9.8e4f, 2.3e5f, 1.7e5f}};
+  }
+}
+
+static Run run_batch_size(const char *path, const JournalBenchOptions &options, uint8_t batch_size) {
+  Run run;
+  unlink(path);
+  SeriesRecord batch[36];
+  uint32_t timestamp = 0;
+  {
+    FileStorage file(path, options.size);
+    CountingStorage storage(&file);
+    FlashJournal journal(&storage);
+    if (!journal.mount())
+      return run;
+    uint64_t samples = uint64_t(options.days * SAMPLES_PER_DAY);
+    for (uint64_t written = 0; written < samples; written += batch_size) {
+      fill(batch, batch_size, timestamp);
+      if (!journal.append(batch, batch_size * sizeof(SeriesRecord)))
+        return run;
+    }
+    run.payload_bytes = journal.get_payload_bytes();
+    run.written_bytes = storage.get_written_bytes();
+    run.erased_bytes = storage.get_erased_bytes();
+    run.erases = journal.get_erases();
+    run.segments = journal.get_num_segments();
+    run.last_timestamp = timestamp;
+  }
+  run.clean = recover(path, options.size);
+
+  // Cut the power halfway through the payload of the next batch, reboot and
+  // check that the journal carries on after the torn batch.
+  {
+    FileStorage file(path, options.size);
+    CountingStorage storage(&file);
+    FlashJournal journal(&storage);
+    if (!journal.mount())
+      return run;
+    uint32_t torn_timestamp = timestamp;
+    fill(batch, batch_size, torn_timestamp);
+    storage.cut_writes_over(sizeof(SeriesRecord) - 1);
+    journal.append(batch, batch_size * sizeof(SeriesRecord));
+  }
+  run.torn = recover(path, options.size);
+  {
+    FileStorage file(path, options.size);
+    FlashJournal journal(&file);
+    fill(batch, batch_size, timestamp);
+    if (!journal.mount() || !journal.append(batch, batch_size * sizeof(SeriesRecord)))
+      return run;
+  }
+  Recovery after = recover(path, options.size);
+
+  run.ok = run.clean.mounted && run.clean.ordered && run.clean.last_timestamp == run.last_timestamp &&
+           run.torn.mounted && run.torn.ordered && run.torn.last_timestamp == run.last_timestamp &&
+           after.mounted && after.ordered && after.last_timestamp == timestamp;
+  return run;
+}
+
+int run_journal_benchmark(const JournalBenchOptions &options) {
+  if (options.size < 2 * FlashJournal::SEGMENT_SIZE) {
+    printf("journal benchmark needs at least %zu bytes\n", 2 * FlashJournal::SEGMENT_SIZE);
+    return 2;
+  }
+  char path[] = "/tmp/zmod4510_journal_XXXXXX";
+  int fd = mkstemp(path);
+  if (fd < 0) {
+    printf("cannot create a journal file in /tmp\n");
+    return 2;
+  }
+  close(fd);
+
+  printf("journal: %.1f days of %zu byte samples per batch size, %zu byte file\n", options.days,
+         sizeof(SeriesRecord), options.size);
+  printf("%5s %9s %9s %12s %8s %8s %10s %10s %12s %10s\n", "batch", "written", "erased", "erases/seg/d", "kept [h]",
+         "reads", "read [KiB]", "mount [ms]", "restore [ms]", "torn [ms]");
+  bool ok = true;
+  for (uint8_t batch_size : BATCH_SIZES) {
+    Run run = run_batch_size(path, options, batch_size);
+    ok &= run.ok;
+    if (run.payload_bytes == 0) {
+      printf("%5u failed\n", batch_size);
+      continue;
+    }
+    double days = options.days;
+    printf("%5u %8.2fx %8.2fx %12.1f %8.1f %8u %10.1f %10.2f %12.2f %10.2f%s\n", batch_size,
+           double(run.written_bytes) / run.payload_bytes, double(run.erased_bytes) / run.payload_bytes,
+           run.erases / days / run.segments, run.clean.records / SAMPLES_PER_DAY * 24, run.clean.reads,
+           run.clean.read_bytes / 1024.0, run.clean.mount_ms, run.clean.restore_ms,
+           run.torn.mount_ms + run.torn.restore_ms, run.ok ? "" : "  (lost samples)");
+  }
+  unlink(path);
+  printf("(written, erased: flash bytes per sample byte; kept: history the journal holds; reads, read and\n"
+         " mount/restore: one reboot after a clean shutdown; torn: mount and restore after a power cut mid-batch)\n");
+  return ok ? 0 : 1;
+}
+
+#else
+
+int run_journal_benchmark(const JournalBenchOptions &options) {
+  printf("the journal benchmark needs a build with -DUSE_ZMOD4510_JOURNAL and flash_journal.cpp\n");
+  return 2;
+}
+
+#endif
+
+}  // namespace sim
+}  // namespace zmod4510
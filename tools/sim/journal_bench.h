@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace zmod4510 {
+namespace sim {
+
+struct JournalBenchOptions {
+  // Days of samples at the 6 s cadence written per batch size.
+  double days{7};
+  // Size of the journal file, as the journal's `size` option.
+  size_t size{65536};
+};
+
+// Writes `days` of samples through FlashJournal into the host FileStorage
+// backend, once for each of several journal batch sizes, and measures the
+// write amplification (bytes programmed and erased per byte of samples), the
+// erases per segment and day, and the recovery after a reboot: the time and
+// flash reads it takes to mount the journal and restore every sample, once
+// after a clean shutdown and once after a power cut in the middle of a batch.
+// Returns 0 if every recovery restored the samples written before it.
+int run_journal_benchmark(const JournalBenchOptions &options);
+
+}  // namespace sim
+}  // namespace zmod4510
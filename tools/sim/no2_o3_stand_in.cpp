@@ -0,0 +1,82 @@
+// Stand-in for lib_no2_o3 on the host, used unless SIM_HAVE_NO2_O3 is
+// defined and a host build of the library is linked. It inverts the
+// simulator's GasModel with the settled baselines, so readings during the
+// warm-up read high, much like a real part. Only the interface and the
+// stabilization phase follow the real library; the numbers do not.
+
+#ifndef SIM_HAVE_NO2_O3
+
+#include <cmath>
+
+#include "gas_model.h"
+
+extern "C" {
+#include "no2_o3.h"
+#include "zmod4xxx.h"
+#include "zmod4510_config_no2_o3.h"
+}
+
+using zmod4510::sim::GasModel;
+
+// Samples reported as NO2_O3_STABILIZATION after init_no2_o3().
+static const uint32_t STABILIZATION_SAMPLES = 50;
+// Samples per averaging window at the 6 s cadence.
+static const float SAMPLES_PER_MINUTE = 60000.0f / ZMOD4510_NO2_O3_SAMPLE_TIME;
+
+// EPA ozone AQI, linear between the 8 h breakpoints.
+static uint16_t ozone_aqi(float ppb) {
+  static const float PPB[] = {0, 54, 70, 85, 105, 200};
+  static const float AQI[] = {0, 50, 100, 150, 200, 300};
+  if (ppb <= 0)
+    return 0;
+  for (int i = 1; i < 6; i++) {
+    if (ppb <= PPB[i])
+      return uint16_t(AQI[i - 1] + (AQI[i] - AQI[i - 1]) * (ppb - PPB[i - 1]) / (PPB[i] - PPB[i - 1]));
+  }
+  return 300;
+}
+
+static void average(float &mean, float value, float samples) { mean += (value - mean) / samples; }
+
+extern "C" int8_t init_no2_o3(no2_o3_handle_t *handle) {
+  *handle = no2_o3_handle_t{};
+  return NO2_O3_OK;
+}
+
+extern "C" int8_t calc_no2_o3(no2_o3_handle_t *handle, const zmod4xxx_dev_t *dev, const no2_o3_inputs_t *algo_input,
+                              no2_o3_results_t *results) {
+  float rmox[ZMOD4510_ADC_DATA_LEN / 2];
+  zmod4xxx_calc_rmox(const_cast<zmod4xxx_dev_t *>(dev), algo_input->adc_result, rmox);
+  const uint8_t per_channel = ZMOD4510_ADC_DATA_LEN / 2 / GasModel::NUM_CHANNELS;
+  for (uint8_t c = 0; c < GasModel::NUM_CHANNELS; c++) {
+    float sum = 0;
+    for (uint8_t i = 0; i < per_channel; i++)
+      sum += rmox[c * per_channel + i];
+    results->rmox[c] = sum / per_channel;
+  }
+  results->temperature = algo_input->temperature_degc;
+  if (handle->sample_counter != 0xFFFFFFFF)
+    handle->sample_counter++;
+
+  // Solve the response of channels 0 and 3 for the two gases.
+  GasModel model;
+  float y0 = results->rmox[0] / model.baseline[0] - 1.0f;
+  float y3 = results->rmox[3] / model.baseline[3] - 1.0f;
+  float det = model.o3_gain[0] * model.no2_gain[3] - model.no2_gain[0] * model.o3_gain[3];
+  float o3 = (y0 * model.no2_gain[3] - model.no2_gain[0] * y3) / det;
+  float no2 = (model.o3_gain[0] * y3 - y0 * model.o3_gain[3]) / det;
+  results->O3_conc_ppb = o3 > 0 ? o3 : 0;
+  results->NO2_conc_ppb = no2 > 0 ? no2 : 0;
+
+  average(handle->o3_1min_ppb, results->O3_conc_ppb, SAMPLES_PER_MINUTE);
+  average(handle->o3_1h_ppb, results->O3_conc_ppb, 60 * SAMPLES_PER_MINUTE);
+  average(handle->o3_8h_ppb, results->O3_conc_ppb, 480 * SAMPLES_PER_MINUTE);
+  average(handle->no2_1min_ppb, results->NO2_conc_ppb, SAMPLES_PER_MINUTE);
+  average(handle->no2_1h_ppb, results->NO2_conc_ppb, 60 * SAMPLES_PER_MINUTE);
+  results->FAST_AQI = ozone_aqi(handle->o3_1min_ppb);
+  results->EPA_AQI = ozone_aqi(handle->o3_8h_ppb);
+
+  return handle->sample_counter <= STABILIZATION_SAMPLES ? NO2_O3_STABILIZATION : NO2_O3_OK;
+}
+
+#endif  // SIM_HAVE_NO2_O3
@@ -0,0 +1,7 @@
+#pragma once
+// Host stand-in for the Arduino core; time comes from the virtual clock.
+#include <cstdint>
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
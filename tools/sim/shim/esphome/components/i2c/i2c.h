@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace i2c {
+
+enum ErrorCode {
+  ERROR_OK = 0,
+  ERROR_INVALID_ARGUMENT,
+  ERROR_NOT_ACKNOWLEDGED,
+  ERROR_TIMEOUT,
+  ERROR_NOT_INITIALIZED,
+  ERROR_TOO_LARGE,
+  ERROR_UNKNOWN,
+  ERROR_CRC,
+};
+
+// Implemented by the simulated devices.
+class I2CBus {
+ public:
+  virtual ~I2CBus() = default;
+  virtual ErrorCode read(uint8_t address, uint8_t *buffer, size_t len) = 0;
+  virtual ErrorCode write(uint8_t address, const uint8_t *buffer, size_t len, bool stop = true) = 0;
+};
+
+class I2CDevice {
+ public:
+  void set_i2c_address(uint8_t address) { this->address_ = address; }
+  uint8_t get_i2c_address() const { return this->address_; }
+  void set_i2c_bus(I2CBus *bus) { this->bus_ = bus; }
+
+ protected:
+  uint8_t address_{0};
+  I2CBus *bus_{nullptr};
+};
+
+}  // namespace i2c
+}  // namespace esphome
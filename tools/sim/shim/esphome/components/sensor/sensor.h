@@ -0,0 +1,32 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace sensor {
+
+class Sensor {
+ public:
+  explicit Sensor(const std::string &name = "") : name_(name) {}
+
+  void publish_state(float state) {
+    this->state = state;
+    this->has_state_ = true;
+    for (auto &callback : this->callbacks_)
+      callback(state);
+  }
+  bool has_state() const { return this->has_state_; }
+  void add_on_state_callback(std::function<void(float)> &&callback) { this->callbacks_.push_back(callback); }
+  const std::string &get_name() const { return this->name_; }
+
+  float state{0.0f};
+
+ protected:
+  std::string name_;
+  bool has_state_{false};
+  std::vector<std::function<void(float)>> callbacks_;
+};
+
+}  // namespace sensor
+}  // namespace esphome
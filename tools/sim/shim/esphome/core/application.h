@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "esphome/core/component.h"
+
+namespace esphome {
+
+// Host stand-in for the ESPHome main loop. Components are set up in priority
+// order, then loop() runs every loop interval of virtual time and timers fire
+// at their exact virtual deadlines.
+class Application {
+ public:
+  void register_component(Component *component) { this->components_.push_back(component); }
+  void set_loop_interval(uint32_t loop_interval) { this->loop_interval_ = loop_interval; }
+  void feed_wdt() {}
+
+  void setup();
+  // One pass over all components and due timers, then one loop interval.
+  void loop();
+  // Loop until the uptime reaches `ms`.
+  void run_until(uint64_t ms);
+  void shutdown();
+  // Forget all components and timers, as a reboot does.
+  void reset();
+
+  uint64_t get_loop_count() const { return this->loop_count_; }
+
+  // Backing for Component::set_timeout() and friends.
+  void set_timer(Component *component, const std::string &name, uint32_t delay, uint32_t interval,
+                 std::function<void()> &&f);
+  bool cancel_timer(Component *component, const std::string &name);
+
+ protected:
+  struct Timer {
+    Component *component;
+    std::string name;
+    uint64_t due_ms;
+    uint32_t interval;  // 0 for timeouts
+    std::function<void()> f;
+  };
+
+  void run_timers_();
+
+  std::vector<Component *> components_;
+  std::vector<Timer> timers_;
+  uint32_t loop_interval_{16};
+  uint64_t loop_count_{0};
+};
+
+extern Application App;
+
+}  // namespace esphome
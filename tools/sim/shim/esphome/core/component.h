@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace esphome {
+
+namespace setup_priority {
+const float BUS = 1000.0f;
+const float IO = 900.0f;
+const float HARDWARE = 800.0f;
+const float DATA = 600.0f;
+const float PROCESSOR = 400.0f;
+const float LATE = -100.0f;
+}  // namespace setup_priority
+
+class Component {
+ public:
+  virtual ~Component() = default;
+  virtual void setup() {}
+  virtual void loop() {}
+  virtual void dump_config() {}
+  virtual void on_shutdown() {}
+  virtual float get_setup_priority() const { return setup_priority::DATA; }
+  virtual void call_setup() { this->setup(); }
+
+  void mark_failed() { this->failed_ = true; }
+  bool is_failed() const { return this->failed_; }
+  void status_set_warning() { this->warning_ = true; }
+  void status_clear_warning() { this->warning_ = false; }
+  bool status_has_warning() const { return this->warning_; }
+
+ protected:
+  // Timers run on the application's virtual-clock scheduler; a new timer
+  // replaces one of the same name.
+  void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f);
+  void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f);
+  bool cancel_timeout(const std::string &name);
+  bool cancel_interval(const std::string &name);
+
+  bool failed_{false};
+  bool warning_{false};
+};
+
+class PollingComponent : public Component {
+ public:
+  PollingComponent() : PollingComponent(0) {}
+  explicit PollingComponent(uint32_t update_interval) : update_interval_(update_interval) {}
+
+  virtual void update() = 0;
+  void call_setup() override;
+  void set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
+  uint32_t get_update_interval() const { return this->update_interval_; }
+
+ protected:
+  uint32_t update_interval_;
+};
+
+}  // namespace esphome
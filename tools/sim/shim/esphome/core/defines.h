@@ -0,0 +1,2 @@
+#pragma once
+// Features are selected with -DUSE_ZMOD4510_* on the compiler command line.
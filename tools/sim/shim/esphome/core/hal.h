@@ -0,0 +1,9 @@
+#pragma once
+#include <cstdint>
+
+namespace esphome {
+// Virtual clock time, see tools/sim/virtual_clock.h.
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+}  // namespace esphome
@@ -0,0 +1,24 @@
+#pragma once
+#include <mutex>
+
+namespace esphome {
+
+class Mutex {
+ public:
+  void lock() { this->m_.lock(); }
+  void unlock() { this->m_.unlock(); }
+
+ private:
+  std::mutex m_;
+};
+
+class LockGuard {
+ public:
+  LockGuard(Mutex &mutex) : mutex_(mutex) { this->mutex_.lock(); }
+  ~LockGuard() { this->mutex_.unlock(); }
+
+ private:
+  Mutex &mutex_;
+};
+
+}  // namespace esphome
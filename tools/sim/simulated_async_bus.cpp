@@ -0,0 +1,117 @@
+#include "simulated_async_bus.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "esphome_hal.h"
+#include "simulated_bus.h"
+#include "virtual_clock.h"
+
+namespace zmod4510 {
+namespace sim {
+
+static const size_t MAX_WRITE_LEN = 64;
+
+void SimulatedAsyncBus::init(AsyncInterface *hal) {
+  hal->handle = this;
+  hal->submit_read = submit_read_;
+  hal->submit_write = submit_write_;
+  hal->schedule = schedule_;
+  hal->poll = poll_;
+  hal->wait = wait_;
+}
+
+uint64_t SimulatedAsyncBus::get_next_due_us() const {
+  uint64_t next = UINT64_MAX;
+  for (const Pending &pending : this->pending_) {
+    if (pending.used && pending.due_us < next)
+      next = pending.due_us;
+  }
+  return next;
+}
+
+int SimulatedAsyncBus::queue_(int result, uint64_t due_us, AsyncCallback done, void *context) {
+  for (Pending &pending : this->pending_) {
+    if (!pending.used) {
+      pending = Pending{done, context, result, due_us, true};
+      return ecSuccess;
+    }
+  }
+  return HAL_SetError(heQueueFull, esHAL, HAL_GetErrorString);
+}
+
+uint64_t SimulatedAsyncBus::occupy_(uint64_t us) {
+  uint64_t start = std::max(virtual_clock().now_us(), this->bus_free_us_);
+  this->bus_free_us_ = start + us;
+  return this->bus_free_us_;
+}
+
+int SimulatedAsyncBus::submit_read_(void *handle, uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data,
+                                    int rd_size, AsyncCallback done, void *context) {
+  auto *self = static_cast<SimulatedAsyncBus *>(handle);
+  esphome::i2c::ErrorCode err = esphome::i2c::ERROR_OK;
+  uint64_t us = 0;
+  if (wr_size) {
+    err = self->bus_->write(sl_addr, wr_data, wr_size, false);
+    us += SimulatedBus::wire_time_us(wr_size, false, self->hz_);
+  }
+  if (err == esphome::i2c::ERROR_OK) {
+    err = self->bus_->read(sl_addr, rd_data, rd_size);
+    us += SimulatedBus::wire_time_us(rd_size, true, self->hz_);
+  }
+  int result = err == esphome::i2c::ERROR_OK ? ecSuccess : HAL_SetError(err, eesESPHome, nullptr);
+  return self->queue_(result, self->occupy_(us), done, context);
+}
+
+int SimulatedAsyncBus::submit_write_(void *handle, uint8_t sl_addr, uint8_t *wr_data1, int wr_size1,
+                                     uint8_t *wr_data2, int wr_size2, AsyncCallback done, void *context) {
+  auto *self = static_cast<SimulatedAsyncBus *>(handle);
+  uint8_t buf[MAX_WRITE_LEN];
+  if (static_cast<size_t>(wr_size1 + wr_size2) > sizeof(buf))
+    return HAL_SetError(esphome::i2c::ERROR_TOO_LARGE, eesESPHome, nullptr);
+  if (wr_size1)
+    memcpy(buf, wr_data1, wr_size1);
+  if (wr_size2)
+    memcpy(buf + wr_size1, wr_data2, wr_size2);
+  esphome::i2c::ErrorCode err = self->bus_->write(sl_addr, buf, wr_size1 + wr_size2);
+  uint64_t us = SimulatedBus::wire_time_us(wr_size1 + wr_size2, true, self->hz_);
+  int result = err == esphome::i2c::ERROR_OK ? ecSuccess : HAL_SetError(err, eesESPHome, nullptr);
+  return self->queue_(result, self->occupy_(us), done, context);
+}
+
+int SimulatedAsyncBus::schedule_(void *handle, uint32_t ms, AsyncCallback done, void *context) {
+  auto *self = static_cast<SimulatedAsyncBus *>(handle);
+  return self->queue_(ecSuccess, virtual_clock().now_us() + uint64_t(ms) * 1000, done, context);
+}
+
+void SimulatedAsyncBus::poll_(void *handle) {
+  auto *self = static_cast<SimulatedAsyncBus *>(handle);
+  // Earliest first; a callback may queue more, which run once due.
+  for (;;) {
+    Pending *next = nullptr;
+    for (Pending &pending : self->pending_) {
+      if (!pending.used || pending.due_us > virtual_clock().now_us())
+        continue;
+      if (next == nullptr || pending.due_us < next->due_us)
+        next = &pending;
+    }
+    if (next == nullptr)
+      return;
+    Pending done = *next;
+    next->used = false;
+    done.done(done.context, done.result);
+  }
+}
+
+void SimulatedAsyncBus::wait_(void *handle) {
+  auto *self = static_cast<SimulatedAsyncBus *>(handle);
+  uint64_t next = self->get_next_due_us();
+  uint64_t now = virtual_clock().now_us();
+  if (next != UINT64_MAX && next > now) {
+    self->waited_us_ += next - now;
+    virtual_clock().advance_to_us(next);
+  }
+}
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+
+#include "async_hal.h"
+#include "esphome/components/i2c/i2c.h"
+
+namespace zmod4510 {
+namespace sim {
+
+// AsyncInterface backend modelling a DMA or interrupt driven I2C controller.
+// A transfer reaches the devices on `bus` when submitted and completes once
+// its wire time has passed, after the transfers queued before it; `bus` must
+// not add wire time itself. Submitting takes no virtual time. Only wait()
+// advances the clock, standing in for the CPU sleeping until the next
+// interrupt, so the time spent there is time a caller was blocked.
+class SimulatedAsyncBus {
+ public:
+  static const uint8_t MAX_PENDING = 32;
+
+  SimulatedAsyncBus(esphome::i2c::I2CBus *bus, uint32_t hz) : bus_(bus), hz_(hz) {}
+
+  void init(AsyncInterface *hal);
+
+  // Virtual time the next pending operation completes; UINT64_MAX if none.
+  uint64_t get_next_due_us() const;
+  // Virtual time spent in wait().
+  uint64_t get_waited_us() const { return this->waited_us_; }
+
+ protected:
+  struct Pending {
+    AsyncCallback done;
+    void *context;
+    int result;
+    uint64_t due_us;
+    bool used;
+  };
+
+  static int submit_read_(void *handle, uint8_t sl_addr, uint8_t *wr_data, int wr_size, uint8_t *rd_data,
+                          int rd_size, AsyncCallback done, void *context);
+  static int submit_write_(void *handle, uint8_t sl_addr, uint8_t *wr_data1, int wr_size1, uint8_t *wr_data2,
+                           int wr_size2, AsyncCallback done, void *context);
+  static int schedule_(void *handle, uint32_t ms, AsyncCallback done, void *context);
+  static void poll_(void *handle);
+  static void wait_(void *handle);
+
+  int queue_(int result, uint64_t due_us, AsyncCallback done, void *context);
+  // Occupy the bus for `us` after the transfers already queued; returns the end.
+  uint64_t occupy_(uint64_t us);
+
+  esphome::i2c::I2CBus *bus_;
+  uint32_t hz_;
+  uint64_t bus_free_us_{0};
+  uint64_t waited_us_{0};
+  Pending pending_[MAX_PENDING]{};
+};
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "esphome/components/i2c/i2c.h"
+#include "virtual_clock.h"
+
+namespace zmod4510 {
+namespace sim {
+
+// An I2C bus shared by several simulated devices; transfers go to the device
+// at their address, and addresses without a device are not acknowledged.
+// With an SCL frequency set, every transfer takes its wire time (see
+// BusCounts) on the virtual clock.
+class SimulatedBus : public esphome::i2c::I2CBus {
+ public:
+  void add_device(uint8_t address, esphome::i2c::I2CBus *device) { this->devices_.push_back({address, device}); }
+  void set_frequency(uint32_t hz) { this->hz_ = hz; }
+  // Virtual time spent on transfers.
+  uint64_t get_busy_us() const { return this->busy_us_; }
+  // Wire time of a transfer of `len` data bytes: START, address byte and
+  // data bytes with their ACK bits, then STOP unless a repeated START follows.
+  static uint64_t wire_time_us(size_t len, bool stop, uint32_t hz) {
+    uint32_t bits = 1 + 9 * (1 + uint32_t(len)) + (stop ? 1 : 0);
+    return (uint64_t(bits) * 1000000 + hz - 1) / hz;
+  }
+
+  esphome::i2c::ErrorCode read(uint8_t address, uint8_t *buffer, size_t len) override {
+    this->transfer_(len, true);
+    esphome::i2c::I2CBus *device = this->find_(address);
+    return device ? device->read(address, buffer, len) : esphome::i2c::ERROR_NOT_ACKNOWLEDGED;
+  }
+  esphome::i2c::ErrorCode write(uint8_t address, const uint8_t *buffer, size_t len, bool stop = true) override {
+    this->transfer_(len, stop);
+    esphome::i2c::I2CBus *device = this->find_(address);
+    return device ? device->write(address, buffer, len, stop) : esphome::i2c::ERROR_NOT_ACKNOWLEDGED;
+  }
+
+ protected:
+  struct Entry {
+    uint8_t address;
+    esphome::i2c::I2CBus *device;
+  };
+
+  void transfer_(size_t len, bool stop) {
+    if (this->hz_ == 0)
+      return;
+    uint64_t us = wire_time_us(len, stop, this->hz_);
+    this->busy_us_ += us;
+    virtual_clock().advance_us(us);
+  }
+
+  esphome::i2c::I2CBus *find_(uint8_t address) const {
+    for (const Entry &entry : this->devices_) {
+      if (entry.address == address)
+        return entry.device;
+    }
+    return nullptr;
+  }
+
+  std::vector<Entry> devices_;
+  uint32_t hz_{0};
+  uint64_t busy_us_{0};
+};
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+namespace zmod4510 {
+namespace sim {
+
+// Simulated time for a host run. millis(), micros() and delay() of the
+// ESPHome shim, the Interface_t msSleep and the register simulator all read
+// this clock; only delays and the main loop advance it, so computation takes
+// no simulated time.
+class VirtualClock {
+ public:
+  uint64_t now_us() const { return this->now_us_; }
+  uint64_t now_ms() const { return this->now_us_ / 1000; }
+  // Time since the last reboot(); what millis() and micros() report.
+  uint64_t uptime_us() const { return this->now_us_ - this->boot_us_ + this->boot_uptime_us_; }
+  // Restart the MCU clock; simulated devices keep running on now_us(). A
+  // non-zero `uptime_ms` starts the uptime there, e.g. just short of the
+  // wrap of the 32-bit millis().
+  void reboot(uint64_t uptime_ms = 0) {
+    this->boot_us_ = this->now_us_;
+    this->boot_uptime_us_ = uptime_ms * 1000;
+  }
+  void advance_us(uint64_t us) { this->now_us_ += us; }
+  void advance_ms(uint64_t ms) { this->now_us_ += ms * 1000; }
+  // Move forward to `us`; never goes backwards.
+  void advance_to_us(uint64_t us) {
+    if (us > this->now_us_)
+      this->now_us_ = us;
+  }
+  // Total time spent in delay() calls.
+  uint64_t get_delayed_us() const { return this->delayed_us_; }
+  void add_delay_ms(uint32_t ms) {
+    this->delayed_us_ += uint64_t(ms) * 1000;
+    this->advance_ms(ms);
+  }
+
+ protected:
+  uint64_t now_us_{0};
+  uint64_t boot_us_{0};
+  uint64_t boot_uptime_us_{0};
+  uint64_t delayed_us_{0};
+};
+
+// The clock shared by the shim and the simulator; each thread has its own.
+VirtualClock &virtual_clock();
+
+}  // namespace sim
+}  // namespace zmod4510
@@ -0,0 +1,395 @@
+// Fast-forward simulation of a ZMOD4510 deployment on a host.
+//
+// The full component (scheduler, algorithm call, publishing, history and
+// persistence, as enabled by -DUSE_ZMOD4510_* flags) runs against the
+// register simulator, with millis(), delay()/msSleep and the ESPHome loop
+// on a virtual clock. A day of 6 s measurement cycles takes seconds, which
+// is enough to look at warm-up, averaging windows and persistence behaviour
+// without waiting for real time.
+//
+//   zmod4510_sim [-d hours] [-s start_hour] [-l loop_ms] [-u update_s] [-j journal] [-v]
+//   zmod4510_sim -b [-a] [-n sensors] [-l loop_ms] [-u update_s]
+//   zmod4510_sim -c
+//   zmod4510_sim -m devices [-l loop_ms]
+//   zmod4510_sim -t threads
+//   zmod4510_sim -e sensors
+//   zmod4510_sim -r sensors
+//   zmod4510_sim -f rounds [-l loop_ms]
+//   zmod4510_sim -p hours [-l loop_ms]
+//   zmod4510_sim -z hours [recording...]
+//   zmod4510_sim -w days
+//   zmod4510_sim -x days
+//   zmod4510_sim -k hours [-l loop_ms]
+//
+// -b runs the boot benchmark instead (see boot_benchmark.h): time to the
+// first valid reading after a cold boot and a warm reboot, per stage; -a
+// models the Arduino HAL's delays instead of the ESPHome HAL's; -n instead
+// boots 1, 2, 4, ... up to that many sensors on one bus and compares their
+// bring-up time. -c reports the I2C cost of the driver sequences against
+// budgets (see bus_cost.h) and exits with status 1 on a regression. -m runs
+// the bus load test (see bus_load.h) with up to 32 devices on one bus; it
+// needs -DUSE_ZMOD4510_BUS_SCHEDULER and bus_scheduler.cpp. -t runs the HAL
+// stress test (see hal_stress.h) with that many threads. -e compares the
+// blocking and the event-driven HAL (see async_hal_test.h) with that many
+// sensors; it needs -DUSE_ZMOD4510_ASYNC_HAL. -r benchmarks the coroutine
+// layer (see coroutine_bench.h) with that many sensors; it needs that and
+// -std=gnu++20. -f injects sensor resets and
+// NACKs mid-cycle (see fault_injection.h), that many rounds of each, and exits
+// with status 1 if a recovery is late or blocks the loop. -p runs that many
+// hours with a jittery, now and then stalling loop (see drift_test.h) and
+// exits with status 1 if the measurement deadlines drifted. -z compares the
+// precision_bits settings of the compressed history (see compression_bench.h)
+// on that many hours of simulated results, or on the given recordings; it
+// needs -DUSE_ZMOD4510_SAMPLE_RECORDS -DUSE_ZMOD4510_COMPRESSED_HISTORY and
+// compressed_series.cpp. -w writes that many days of samples through the
+// flash journal into the host FileStorage backend (see journal_bench.h) and
+// reports its write amplification and recovery time; it needs
+// -DUSE_ZMOD4510_JOURNAL and flash_journal.cpp. -x streams that many days of
+// history through the history export (see export_bench.h) and reports its
+// throughput and heap use; it needs -DUSE_ZMOD4510_HISTORY
+// -DUSE_ZMOD4510_HISTORY_EXPORT, sample_history.cpp and history_export.cpp.
+// -k boots twice for that many hours across the wrap of millis() (see
+// clock_wrap_test.h) and exits with status 1 if the history or the journal
+// went out of order; it needs -DUSE_ZMOD4510_SAMPLE_RECORDS
+// -DUSE_ZMOD4510_HISTORY -DUSE_ZMOD4510_JOURNAL, sample_history.cpp and
+// flash_journal.cpp.
+//
+// Build from the repository root:
+//   g++ -O2 -std=gnu++17 -pthread -DUSE_ZMOD4510_ASYNC_HAL -Itools/sim/shim -Itools/sim
+//       -Icomponents/zmod4510 tools/sim/*.cpp tools/recording/recording_reader.cpp
+//       components/zmod4510/zmod4510_component.cpp components/zmod4510/sample_scheduler.cpp
+//       components/zmod4510/esphome_hal.cpp components/zmod4510/hal.cpp
+//       components/zmod4510/async_hal.cpp components/zmod4510/zmod4xxx_async.cpp
+//       components/zmod4510/coroutine.cpp components/zmod4510/zmod4xxx_tasks.cpp
+//       components/zmod4510/zmod4xxx.cpp components/zmod4510/zmod4xxx_hal.cpp
+//       components/zmod4510/zmod4510_config_no2_o3.cpp components/zmod4510/hsxxxx.cpp
+//       components/zmod4510/hs3xxx.cpp components/zmod4510/hs4xxx.cpp -o zmod4510_sim
+// Add the USE_ZMOD4510_* defines and the sources of the enabled features,
+// e.g. -DUSE_ZMOD4510_AVERAGES, or -DUSE_ZMOD4510_HISTORY with
+// sample_history.cpp. Without SIM_HAVE_NO2_O3 and a host build of
+// lib_no2_o3, the algorithm is the stand-in in no2_o3_stand_in.cpp;
+// likewise cleaning_stand_in.cpp for -DUSE_ZMOD4510_CLEANING.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "async_hal_test.h"
+#include "boot_benchmark.h"
+#include "bus_cost.h"
+#include "bus_load.h"
+#include "clock_wrap_test.h"
+#include "compression_bench.h"
+#include "coroutine_bench.h"
+#include "drift_test.h"
+#include "esphome/core/application.h"
+#include "esphome/core/log.h"
+#include "export_bench.h"
+#include "fault_injection.h"
+#include "hal_stress.h"
+#include "hs_simulator.h"
+#include "journal_bench.h"
+#include "simulated_bus.h"
+#include "virtual_clock.h"
+#include "zmod4510_component.h"
+#include "zmod4510_simulator.h"
+
+using namespace zmod4510;
+using namespace zmod4510::sim;
+
+// A published output and what it should converge to.
+struct Probe {
+  std::unique_ptr<esphome::sensor::Sensor> sensor;
+  std::function<float(double)> truth;  // expected value at a time of day (s)
+  float tolerance;                     // absolute error counted as settled
+  uint32_t publishes{0};
+  uint64_t first_ms{0};
+  uint64_t last_unsettled_ms{0};
+  double error_sum{0};
+  uint32_t error_count{0};
+};
+
+static double time_of_day_s = 0;
+
+#ifdef USE_ZMOD4510_AVERAGES
+// Exponential mean of `f` with time constant `tau_s` up to `t`: the reference
+// for the averaged outputs, matching the averaging of the stand-in algorithm.
+static float exponential_mean(float (*f)(double), double t, double tau_s) {
+  const int steps = 200;
+  const double span = 5 * tau_s;
+  double sum = 0, weight = 0;
+  for (int i = 0; i < steps; i++) {
+    double age = span * (i + 0.5) / steps;
+    double w = std::exp(-age / tau_s);
+    sum += w * f(t - age);
+    weight += w;
+  }
+  return float(sum / weight);
+}
+#endif
+
+static void usage() {
+  fprintf(stderr,
+          "usage: zmod4510_sim [-d hours] [-s start_hour] [-l loop_ms] [-u update_s] [-j journal] [-v]\n"
+          "       zmod4510_sim -b [-a] [-n sensors] [-l loop_ms] [-u update_s]\n"
+          "       zmod4510_sim -c\n"
+          "       zmod4510_sim -m devices [-l loop_ms]\n"
+          "       zmod4510_sim -t threads\n"
+          "       zmod4510_sim -e sensors\n"
+          "       zmod4510_sim -r sensors\n"
+          "       zmod4510_sim -f rounds [-l loop_ms]\n"
+          "       zmod4510_sim -p hours [-l loop_ms]\n"
+          "       zmod4510_sim -z hours [recording...]\n"
+          "       zmod4510_sim -w days\n"
+          "       zmod4510_sim -x days\n"
+          "       zmod4510_sim -k hours [-l loop_ms]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  double hours = 24;
+  uint32_t loop_ms = 16;
+  uint32_t update_s = 60;
+  const char *journal = nullptr;
+  bool boot_benchmark = false;
+  int boot_sensors = 0;
+  bool arduino_hal = false;
+  bool bus_cost = false;
+  int bus_load_devices = 0;
+  int stress_threads = 0;
+  int async_sensors = 0;
+  int coroutine_sensors = 0;
+  int fault_rounds = 0;
+  double drift_hours = 0;
+  double compression_hours = 0;
+  double journal_days = 0;
+  double export_days = 0;
+  double wrap_hours = 0;
+  int opt;
+  while ((opt = getopt(argc, argv, "d:s:l:u:j:vbacm:n:t:e:r:f:p:z:w:x:k:")) != -1) {
+    switch (opt) {
+      case 'd':
+        hours = atof(optarg);
+        break;
+      case 's':
+        time_of_day_s = atof(optarg) * 3600;
+        break;
+      case 'l':
+        loop_ms = uint32_t(atoi(optarg));
+        break;
+      case 'u':
+        update_s = uint32_t(atoi(optarg));
+        break;
+      case 'j':
+        journal = optarg;
+        break;
+      case 'v':
+        esphome::log_level++;
+        break;
+      case 'b':
+        boot_benchmark = true;
+        break;
+      case 'a':
+        arduino_hal = true;
+        break;
+      case 'c':
+        bus_cost = true;
+        break;
+      case 'n':
+        boot_sensors = atoi(optarg);
+        break;
+      case 'm':
+        bus_load_devices = atoi(optarg);
+        break;
+      case 't':
+        stress_threads = atoi(optarg);
+        break;
+      case 'e':
+        async_sensors = atoi(optarg);
+        break;
+      case 'r':
+        coroutine_sensors = atoi(optarg);
+        break;
+      case 'f':
+        fault_rounds = atoi(optarg);
+        break;
+      case 'p':
+        drift_hours = atof(optarg);
+        break;
+      case 'z':
+        compression_hours = atof(optarg);
+        break;
+      case 'w':
+        journal_days = atof(optarg);
+        break;
+      case 'x':
+        export_days = atof(optarg);
+        break;
+      case 'k':
+        wrap_hours = atof(optarg);
+        break;
+      default:
+        usage();
+    }
+  }
+  // Only the compression benchmark takes recordings.
+  if ((optind != argc && compression_hours <= 0) || hours <= 0 || loop_ms == 0 || update_s == 0)
+    usage();
+
+  if (bus_cost)
+    return run_bus_cost_benchmark();
+  if (async_sensors != 0) {
+    AsyncHalOptions options;
+    options.sensors = uint8_t(std::min(async_sensors, 255));
+    return run_async_hal_test(options);
+  }
+  if (coroutine_sensors != 0) {
+    CoroutineBenchOptions options;
+    options.sensors = uint8_t(std::min(coroutine_sensors, 255));
+    return run_coroutine_benchmark(options);
+  }
+  if (fault_rounds > 0) {
+    FaultInjectionOptions options;
+    options.loop_ms = loop_ms;
+    options.rounds = uint32_t(fault_rounds);
+    return run_fault_injection_test(options);
+  }
+  if (drift_hours > 0) {
+    DriftTestOptions options;
+    options.hours = drift_hours;
+    options.loop_ms = loop_ms;
+    return run_drift_test(options);
+  }
+  if (compression_hours > 0) {
+    CompressionBenchOptions options;
+    options.hours = compression_hours;
+    options.recordings.assign(argv + optind, argv + argc);
+    return run_compression_benchmark(options);
+  }
+  if (journal_days > 0) {
+    JournalBenchOptions options;
+    options.days = journal_days;
+    return run_journal_benchmark(options);
+  }
+  if (export_days > 0) {
+    ExportBenchOptions options;
+    options.days = export_days;
+    return run_export_benchmark(options);
+  }
+  if (wrap_hours > 0) {
+    ClockWrapOptions options;
+    options.hours = wrap_hours;
+    options.loop_ms = loop_ms;
+    return run_clock_wrap_test(options);
+  }
+  if (stress_threads != 0) {
+    HalStressOptions options;
+    options.threads = uint8_t(std::min(stress_threads, 255));
+    return run_hal_stress_test(options);
+  }
+  if (bus_load_devices != 0) {
+    BusLoadOptions options;
+    options.devices = uint8_t(bus_load_devices);
+    options.loop_ms = loop_ms;
+    return run_bus_load_test(options);
+  }
+  if (boot_benchmark) {
+    BootBenchmarkOptions options;
+    options.loop_ms = loop_ms;
+    options.update_s = update_s;
+    options.arduino_hal = arduino_hal;
+    if (boot_sensors > 0)
+      return run_bring_up_scaling(options, uint8_t(std::min(boot_sensors, 128)));
+    return run_boot_benchmark(options);
+  }
+
+  ZMOD4510Simulator device;
+  device.set_time_of_day(time_of_day_s);
+  // Picked up by -DUSE_ZMOD4510_HSXXXX builds for ambient compensation.
+  HSxxxxSimulator ambient(HSxxxxSimulator::HS3XXX_ADDRESS);
+  SimulatedBus bus;
+  bus.add_device(ZMOD4510Simulator::ADDRESS, &device);
+  bus.add_device(ambient.get_address(), &ambient);
+
+  ZMOD4510 component;
+  component.set_i2c_bus(&bus);
+  component.set_i2c_address(ZMOD4510Simulator::ADDRESS);
+  component.set_update_interval(update_s * 1000);
+
+  std::vector<Probe> probes;
+  auto add_probe = [&](const char *name, std::function<float(double)> truth, float tolerance) {
+    probes.push_back(Probe{std::unique_ptr<esphome::sensor::Sensor>(new esphome::sensor::Sensor(name)), truth,
+                           tolerance});
+    return probes.back().sensor.get();
+  };
+  component.set_no2_sensor(add_probe("NO2", [](double t) { return GasModel::no2_ppb(t); }, 2.0f));
+  component.set_o3_sensor(add_probe("O3", [](double t) { return GasModel::o3_ppb(t); }, 2.0f));
+#ifdef USE_ZMOD4510_AVERAGES
+  component.set_o3_1h_sensor(
+      add_probe("O3 1h", [](double t) { return exponential_mean(GasModel::o3_ppb, t, 3600); }, 2.0f));
+  component.set_o3_8h_sensor(
+      add_probe("O3 8h", [](double t) { return exponential_mean(GasModel::o3_ppb, t, 8 * 3600); }, 2.0f));
+  component.set_no2_1h_sensor(
+      add_probe("NO2 1h", [](double t) { return exponential_mean(GasModel::no2_ppb, t, 3600); }, 2.0f));
+#endif
+  for (Probe &probe : probes) {
+    Probe *p = &probe;
+    p->sensor->add_on_state_callback([p](float state) {
+      uint64_t now = virtual_clock().now_ms();
+      if (p->publishes++ == 0)
+        p->first_ms = now;
+      float error = std::fabs(state - p->truth(time_of_day_s + now / 1e3));
+      if (error > p->tolerance)
+        p->last_unsettled_ms = now;
+      p->error_sum += error;
+      p->error_count++;
+    });
+  }
+#ifdef USE_ZMOD4510_JOURNAL
+  if (journal != nullptr)
+    component.set_journal_file(journal, 65536);
+#else
+  if (journal != nullptr)
+    fprintf(stderr, "-j needs a build with -DUSE_ZMOD4510_JOURNAL\n");
+#endif
+
+  esphome::App.set_loop_interval(loop_ms);
+  esphome::App.register_component(&component);
+
+  auto start = std::chrono::steady_clock::now();
+  esphome::App.setup();
+  esphome::App.run_until(uint64_t(hours * 3600 * 1000));
+  esphome::App.shutdown();
+  double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  double virtual_s = virtual_clock().now_us() / 1e6;
+
+  printf("%.2f h simulated in %.2f s (%.0fx), %llu loop passes\n", virtual_s / 3600, wall_s, virtual_s / wall_s,
+         (unsigned long long) esphome::App.get_loop_count());
+  printf("%u measurement cycles, %u access conflicts, %u reads, %u writes, %.1f s in delay()\n",
+         device.get_measurements(), device.get_access_conflicts(), device.get_reads(), device.get_writes(),
+         virtual_clock().get_delayed_us() / 1e6);
+  if (component.is_failed())
+    printf("component failed during setup\n");
+  printf("%-8s %9s %12s %12s %10s\n", "output", "publishes", "first [min]", "settled [min]", "mean err");
+  for (const Probe &probe : probes) {
+    if (probe.publishes == 0) {
+      printf("%-8s %9u %12s %12s %10s\n", probe.sensor->get_name().c_str(), 0u, "-", "-", "-");
+      continue;
+    }
+    printf("%-8s %9u %12.1f %12.1f %10.2f\n", probe.sensor->get_name().c_str(), probe.publishes,
+           probe.first_ms / 60000.0, probe.last_unsettled_ms / 60000.0, probe.error_sum / probe.error_count);
+  }
+#ifdef USE_ZMOD4510_HISTORY
+  const SampleHistory &history = component.get_history();
+  printf("history: %zu raw, %zu minute, %zu hour, %zu day entries\n", history.size(SampleHistory::RAW),
+         history.size(SampleHistory::MINUTE), history.size(SampleHistory::HOUR), history.size(SampleHistory::DAY));
+#endif
+  return 0;
+}
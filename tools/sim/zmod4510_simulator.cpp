@@ -0,0 +1,168 @@
+#include "zmod4510_simulator.h"
+#include <cstring>
+
+#include "virtual_clock.h"
+
+extern "C" {
+#include "zmod4xxx.h"
+#include "zmod4510_config_no2_o3.h"
+}
+
+namespace zmod4510 {
+namespace sim {
+
+static const uint8_t ADDR_RESULT = 0x97;
+static const uint8_t ADDR_ERROR_EVENT = 0xB7;
+// Calibration of the simulated part: load and end of range of the ADC.
+static const uint16_t MOX_LR = 0x0400;
+static const uint16_t MOX_ER = 0xF000;
+static const uint8_t CONFIG[ZMOD4XXX_LEN_CONF] = {0xA0, 0x00, 0x27, 0x10, 0x40, 0x80};
+
+ZMOD4510Simulator::ZMOD4510Simulator(uint8_t address) : address_(address) { this->power_on(); }
+
+void ZMOD4510Simulator::power_on() {
+  // The cleaning state is non-volatile.
+  uint8_t cleaned = this->regs_[ADDR_CLEANING_STATE];
+  memset(this->regs_, 0, sizeof(this->regs_));
+  this->regs_[ADDR_CLEANING_STATE] = cleaned;
+  this->regs_[ZMOD4XXX_ADDR_PID] = ZMOD4510_PID >> 8;
+  this->regs_[ZMOD4XXX_ADDR_PID + 1] = ZMOD4510_PID & 0xFF;
+  memcpy(this->regs_ + ZMOD4XXX_ADDR_CONF, CONFIG, sizeof(CONFIG));
+  for (uint8_t i = 0; i < ZMOD4510_PROD_DATA_LEN; i++)
+    this->regs_[ZMOD4XXX_ADDR_PROD_DATA + i] = uint8_t(0x10 + i);
+  for (uint8_t i = 0; i < ZMOD4XXX_LEN_TRACKING; i++)
+    this->regs_[ZMOD4XXX_ADDR_TRACKING + i] = uint8_t(0xA0 + i);
+  this->running_ = false;
+  this->steps_len_ = 0;
+  this->error_event_ = STATUS_POR_EVENT_MASK;
+  this->power_on_us_ = virtual_clock().now_us();
+}
+
+double ZMOD4510Simulator::seconds_of_day_() const { return this->time_of_day_s_ + virtual_clock().now_us() / 1e6; }
+
+float ZMOD4510Simulator::get_o3_ppb() const { return GasModel::o3_ppb(this->seconds_of_day_()); }
+float ZMOD4510Simulator::get_no2_ppb() const { return GasModel::no2_ppb(this->seconds_of_day_()); }
+
+void ZMOD4510Simulator::start_sequence_() {
+  this->cleaning_sequence_ = this->steps_len_ == CLEANING_STEPS_LEN;
+  this->init_sequence_ = !this->cleaning_sequence_ && this->steps_len_ != ZMOD4510_ADC_DATA_LEN;
+  this->running_ = true;
+  uint32_t duration_ms = this->measurement_ms_;
+  if (this->cleaning_sequence_) {
+    duration_ms = CLEANING_SEQUENCE_MS;
+  } else if (this->init_sequence_) {
+    duration_ms = INIT_SEQUENCE_MS;
+    this->event_(EVENT_INIT_SEQUENCE);
+  } else {
+    this->event_(EVENT_MEASUREMENT);
+  }
+  this->sequence_end_us_ = virtual_clock().now_us() + uint64_t(duration_ms) * 1000;
+}
+
+void ZMOD4510Simulator::update_() {
+  if (!this->running_ || virtual_clock().now_us() < this->sequence_end_us_)
+    return;
+  this->running_ = false;
+  uint8_t *result = this->regs_ + ADDR_RESULT;
+  if (this->cleaning_sequence_)
+    return;
+  if (this->init_sequence_) {
+    result[0] = MOX_LR >> 8;
+    result[1] = MOX_LR & 0xFF;
+    result[2] = MOX_ER >> 8;
+    result[3] = MOX_ER & 0xFF;
+    return;
+  }
+  // Invert zmod4xxx_calc_single_rmox() to get the ADC value of each reading.
+  double t = this->seconds_of_day_();
+  double on = (this->sequence_end_us_ - this->power_on_us_) / 1e6;
+  float load = CONFIG[0] * 1e3f;
+  for (uint8_t i = 0; i < ZMOD4510_ADC_DATA_LEN / 2; i++) {
+    float rmox = this->model_.rmox(i * GasModel::NUM_CHANNELS / (ZMOD4510_ADC_DATA_LEN / 2), t, on);
+    uint16_t adc = uint16_t((rmox * MOX_ER + load * MOX_LR) / (rmox + load));
+    result[2 * i] = adc >> 8;
+    result[2 * i + 1] = adc & 0xFF;
+  }
+  this->measurements_++;
+}
+
+void ZMOD4510Simulator::fail_transfers(uint32_t ms) {
+  this->failing_until_us_ = virtual_clock().now_us() + uint64_t(ms) * 1000;
+}
+
+bool ZMOD4510Simulator::fail_transfer_() {
+  if (virtual_clock().now_us() >= this->failing_until_us_)
+    return false;
+  this->failed_transfers_++;
+  return true;
+}
+
+esphome::i2c::ErrorCode ZMOD4510Simulator::write(uint8_t address, const uint8_t *buffer, size_t len, bool stop) {
+  if (address != this->address_)
+    return esphome::i2c::ERROR_NOT_ACKNOWLEDGED;
+  if (this->fail_transfer_())
+    return esphome::i2c::ERROR_NOT_ACKNOWLEDGED;
+  this->writes_++;
+  if (len == 0) {
+    this->event_(EVENT_PROBE);
+    return esphome::i2c::ERROR_OK;  // Address probe.
+  }
+  this->update_();
+  uint8_t reg = buffer[0];
+  this->pointer_ = reg;
+  if (len == 1)
+    return esphome::i2c::ERROR_OK;
+  const uint8_t *data = buffer + 1;
+  size_t data_len = len - 1;
+  if (reg == ZMOD4XXX_ADDR_CMD) {
+    if (data[0] & 0x80) {
+      this->start_sequence_();
+    } else {
+      this->running_ = false;
+    }
+    return esphome::i2c::ERROR_OK;
+  }
+  if (reg == ZMOD4XXX_S_ADDR)
+    this->steps_len_ = uint8_t(data_len);
+  if (reg + data_len > sizeof(this->regs_))
+    return esphome::i2c::ERROR_INVALID_ARGUMENT;
+  memcpy(this->regs_ + reg, data, data_len);
+  return esphome::i2c::ERROR_OK;
+}
+
+esphome::i2c::ErrorCode ZMOD4510Simulator::read(uint8_t address, uint8_t *buffer, size_t len) {
+  if (address != this->address_)
+    return esphome::i2c::ERROR_NOT_ACKNOWLEDGED;
+  if (this->fail_transfer_())
+    return esphome::i2c::ERROR_NOT_ACKNOWLEDGED;
+  this->reads_++;
+  this->update_();
+  uint8_t reg = this->pointer_;
+  if (reg == ZMOD4XXX_ADDR_PID) {
+    this->event_(EVENT_SENSOR_INFO);
+  } else if (reg == ADDR_CLEANING_STATE) {
+    this->event_(EVENT_CLEANING);
+  }
+  if (reg == ZMOD4XXX_ADDR_STATUS) {
+    buffer[0] = this->running_ ? STATUS_SEQUENCER_RUNNING_MASK : 0;
+    return esphome::i2c::ERROR_OK;
+  }
+  if (reg == ADDR_ERROR_EVENT) {
+    // Reading the error event register clears it.
+    buffer[0] = this->error_event_;
+    this->error_event_ = 0;
+    return esphome::i2c::ERROR_OK;
+  }
+  if (reg == ADDR_RESULT && this->running_ && !this->init_sequence_) {
+    // The results are being rewritten by the running sequence.
+    this->error_event_ |= STATUS_ACCESS_CONFLICT_MASK;
+    this->access_conflicts_++;
+  }
+  if (reg + len > sizeof(this->regs_))
+    return esphome::i2c::ERROR_INVALID_ARGUMENT;
+  memcpy(buffer, this->regs_ + reg, len);
+  return esphome::i2c::ERROR_OK;
+}
+
+}  // namespace sim
+}  // namespace zmod4510
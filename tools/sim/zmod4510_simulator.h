@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "esphome/components/i2c/i2c.h"
+#include "gas_model.h"
+
+namespace zmod4510 {
+namespace sim {
+
+// Register-level model of a ZMOD4510 on the simulated I2C bus. It answers the
+// register reads and writes of zmod4xxx.cpp: identification and calibration
+// data, the sequencer configuration, the command and status registers, ADC
+// results and the error event register. Sequences run on the virtual clock,
+// and ADC results are generated from a GasModel.
+class ZMOD4510Simulator : public esphome::i2c::I2CBus {
+ public:
+  static const uint8_t ADDRESS = 0x33;
+  // Not a ZMOD4510 register: stands in for the non-volatile state the
+  // cleaning library checks, see cleaning_stand_in.cpp.
+  static const uint8_t ADDR_CLEANING_STATE = 0xF0;
+  // Sequencer step table length of the stand-in cleaning sequence.
+  static const uint8_t CLEANING_STEPS_LEN = 2;
+
+  // Milestones of a driver bring-up, in the order setup() reaches them.
+  enum Event : uint8_t {
+    EVENT_PROBE,              // address probe at the end of zmod4xxx_init()
+    EVENT_SENSOR_INFO,        // product ID read
+    EVENT_CLEANING,           // cleaning state checked
+    EVENT_INIT_SEQUENCE,      // init sequence started
+    EVENT_MEASUREMENT,        // measurement sequence started
+    NUM_EVENTS,
+  };
+
+  // A real ZMOD4510 answers at ADDRESS only; other addresses let several
+  // simulated sensors share one bus.
+  explicit ZMOD4510Simulator(uint8_t address = ADDRESS);
+
+  esphome::i2c::ErrorCode read(uint8_t address, uint8_t *buffer, size_t len) override;
+  esphome::i2c::ErrorCode write(uint8_t address, const uint8_t *buffer, size_t len, bool stop = true) override;
+
+  // Power the sensor on at the current virtual time (power-on reset).
+  void power_on();
+  // Leave all transfers of the next `ms` unacknowledged, as a sensor that has
+  // dropped off the bus; they neither read nor change any register.
+  void fail_transfers(uint32_t ms);
+  // Seconds of day at virtual time zero, for the diurnal cycle.
+  void set_time_of_day(double seconds) { this->time_of_day_s_ = seconds; }
+  // Duration of the measurement sequence; the init sequence takes INIT_SEQUENCE_MS.
+  void set_measurement_ms(uint32_t ms) { this->measurement_ms_ = ms; }
+  GasModel &get_model() { return this->model_; }
+  // Called for every milestone as it happens on the bus.
+  void set_event_callback(std::function<void(Event)> &&callback) { this->event_callback_ = callback; }
+  bool is_cleaned() const { return this->regs_[ADDR_CLEANING_STATE] != 0; }
+  // Ambient conditions at the current virtual time.
+  float get_o3_ppb() const;
+  float get_no2_ppb() const;
+
+  // Statistics of the bus traffic to this device.
+  uint32_t get_reads() const { return this->reads_; }
+  uint32_t get_writes() const { return this->writes_; }
+  uint32_t get_measurements() const { return this->measurements_; }
+  uint32_t get_access_conflicts() const { return this->access_conflicts_; }
+  uint32_t get_failed_transfers() const { return this->failed_transfers_; }
+
+  static const uint32_t INIT_SEQUENCE_MS = 30;
+  static const uint32_t CLEANING_SEQUENCE_MS = 60000;
+
+ protected:
+  // Finish a sequence whose time has passed and latch its results.
+  void update_();
+  void start_sequence_();
+  // True if this transfer falls into a window set by fail_transfers().
+  bool fail_transfer_();
+  void event_(Event event) {
+    if (this->event_callback_)
+      this->event_callback_(event);
+  }
+  double seconds_of_day_() const;
+
+  uint8_t address_;
+  GasModel model_;
+  uint8_t regs_[256]{};
+  uint8_t pointer_{0};
+  // Length of the last write to the sequencer step table; tells the init
+  // sequence (4 bytes) from the measurement (32 bytes).
+  uint8_t steps_len_{0};
+  bool running_{false};
+  bool init_sequence_{false};
+  bool cleaning_sequence_{false};
+  uint64_t sequence_end_us_{0};
+  uint64_t power_on_us_{0};
+  uint32_t measurement_ms_{4000};
+  double time_of_day_s_{0.0};
+  uint8_t error_event_{0};
+  std::function<void(Event)> event_callback_;
+
+  uint32_t reads_{0};
+  uint32_t writes_{0};
+  uint32_t measurements_{0};
+  uint32_t access_conflicts_{0};
+  uint64_t failing_until_us_{0};
+  uint32_t failed_transfers_{0};
+};
+
+}  // namespace sim
+}  // namespace zmod4510